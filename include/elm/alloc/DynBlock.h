@@ -12,8 +12,8 @@ namespace elm { namespace block {
 // DynBlock class
 class DynBlock {
 public:
-	inline DynBlock(int capacity = 256, int increment = 64)
-		: _size(0), cap(capacity), inc(increment), buf(new char[capacity]) { }
+	inline DynBlock(int capacity = 256, int increment = 64, float factor = 2)
+		: _size(0), cap(capacity), inc(increment), fact(factor), buf(new char[capacity]) { }
 	inline ~DynBlock(void) { if(buf) delete [] buf; }
 	void put(const char *block, int size);
 	void get(char *block, int size, int pos);
@@ -21,13 +21,18 @@ public:
 	inline int size(void) const { return _size; }
 	inline int capacity(void) const { return cap; }
 	inline int increment(void) const { return inc; }
+	inline float factor(void) const { return fact; }
+	inline void setFactor(float factor) { fact = factor; }
+	inline void reserve(int capacity) { if(capacity > cap) grow(capacity - cap); }
 	inline void setSize(int new_size) { _size = new_size; }
 	inline void reset(void) { _size = 0; if(!buf) buf = new char[cap]; }
+	void reset(int capacity);
 	inline const char *base(void) const { return buf; }
 	inline char *detach(void)
 		{ char *result = buf; buf = 0; return result; }
 private:
 	int _size, cap, inc;
+	float fact;
 	char *buf;
 	void grow(int min);
 };
@@ -74,6 +74,7 @@ protected:
 	void newChunk(void);
 
 private:
+	void *allocateBig(t::size size);
 	chunk_t *cur;
 	char *max, *top;
 	t::size _size;
@@ -21,6 +21,16 @@
 
 #define ELM_LITTLE_ENDIAN
 
+// reference counting mode of libelm (String, SharedPtr): the inline code
+// of the clients must use the same mode as the library
+#define ELM_ARCH_ATOMIC_REF 0
+#if !ELM_ARCH_ATOMIC_REF && defined(ELM_ATOMIC_REF)
+#	error "ELM_ATOMIC_REF is defined but ELM has been configured without atomic reference counters"
+#endif
+#if ELM_ARCH_ATOMIC_REF && !defined(ELM_ATOMIC_REF)
+#	define ELM_ATOMIC_REF
+#endif
+
 namespace elm { namespace t {
 
 	typedef signed char int8;
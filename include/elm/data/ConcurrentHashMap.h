@@ -0,0 +1,173 @@
+/*
+ *	ConcurrentHashMap class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_DATA_CONCURRENTHASHMAP_H_
+#define ELM_DATA_CONCURRENTHASHMAP_H_
+
+#include "HashMap.h"
+#include "Vector.h"
+#include <elm/sys/Lock.h>
+
+namespace elm {
+
+template <class K, class T, class H = HashKey<K>, class A = DefaultAlloc>
+class ConcurrentHashMap: public H {
+	typedef HashMap<K, T, H, A> map_t;
+
+	class stripe_t {
+	public:
+		inline stripe_t() { }
+		sys::ReadWriteLock lock;
+		sys::Condition done;
+		Vector<K> computing;
+		map_t map;
+	private:
+		stripe_t(const stripe_t&);
+		stripe_t& operator=(const stripe_t&);
+	};
+
+	class Locker {
+	public:
+		inline Locker(stripe_t& s): _l(s.lock) { _l.lockWrite(); }
+		inline ~Locker() { _l.unlockWrite(); }
+	private:
+		sys::ReadWriteLock& _l;
+	};
+
+	class Reader {
+	public:
+		inline Reader(stripe_t& s): _l(s.lock) { _l.lockRead(); }
+		inline ~Reader() { _l.unlockRead(); }
+	private:
+		sys::ReadWriteLock& _l;
+	};
+
+public:
+	typedef K key_t;
+	typedef T val_t;
+	typedef ConcurrentHashMap<K, T, H, A> self_t;
+
+	ConcurrentHashMap(int stripes = 16): _cnt(1), _shift(64) {
+		while(_cnt < stripes) { _cnt <<= 1; _shift--; }
+		_stripes = new stripe_t[_cnt];
+	}
+	~ConcurrentHashMap() { delete [] _stripes; }
+	inline const H& hash() const { return *this; }
+	inline H& hash() { return *this; }
+	inline int stripes() const { return _cnt; }
+
+	inline Option<T> get(const K& k) const
+		{ stripe_t& s = stripe(k); Reader l(s); return s.map.get_const(k); }
+	inline T get(const K& k, const T& def) const
+		{ stripe_t& s = stripe(k); Reader l(s); return s.map.get_const(k, def); }
+	inline bool hasKey(const K& k) const
+		{ stripe_t& s = stripe(k); Reader l(s); return s.map.hasKey_const(k); }
+
+	inline void put(const K& k, const T& v)
+		{ stripe_t& s = stripe(k); Locker l(s); s.map.put(k, v); }
+	Option<T> putIfAbsent(const K& k, const T& v) {
+		stripe_t& s = stripe(k);
+		Locker l(s);
+		Option<T> r = s.map.get_const(k);
+		if(!r)
+			s.map.add(k, v);
+		return r;
+	}
+	template <class F> T computeIfAbsent(const K& k, F f) {
+		stripe_t& s = stripe(k);
+		{
+			Reader l(s);
+			Option<T> r = s.map.get_const(k);
+			if(r)
+				return *r;
+		}
+		{
+			Locker l(s);
+			while(true) {
+				Option<T> r = s.map.get_const(k);
+				if(r)
+					return *r;
+				if(computing(s, k) < 0)
+					break;
+				s.done.wait(s.lock);
+			}
+			s.computing.add(k);
+		}
+		Option<T> v;
+		try {
+			v = f(k);
+		}
+		catch(...) {
+			Locker l(s);
+			release(s, k);
+			throw;
+		}
+		Locker l(s);
+		release(s, k);
+		Option<T> r = s.map.get_const(k);
+		if(r)
+			return *r;
+		s.map.add(k, *v);
+		return *v;
+	}
+	inline void remove(const K& k)
+		{ stripe_t& s = stripe(k); Locker l(s); s.map.remove(k); }
+
+	int count() const
+		{ int c = 0; for(int i = 0; i < _cnt; i++) { Reader l(_stripes[i]); c += _stripes[i].map.count(); } return c; }
+	inline bool isEmpty() const
+		{ for(int i = 0; i < _cnt; i++) { Reader l(_stripes[i]); if(!_stripes[i].map.isEmpty()) return false; } return true; }
+	inline operator bool() const { return !isEmpty(); }
+	void clear()
+		{ for(int i = 0; i < _cnt; i++) { Locker l(_stripes[i]); _stripes[i].map.clear(); } }
+	template <class F> void forEach(F f) const {
+		for(int i = 0; i < _cnt; i++) {
+			Reader l(_stripes[i]);
+			for(const auto& p: _stripes[i].map.pairs())
+				f(p.fst, p.snd);
+		}
+	}
+
+private:
+	inline int computing(stripe_t& s, const K& k) const {
+		for(int i = 0; i < s.computing.length(); i++)
+			if(H::isEqual(s.computing[i], k))
+				return i;
+		return -1;
+	}
+	inline void release(stripe_t& s, const K& k)
+		{ s.computing.removeAt(computing(s, k)); s.done.notifyAll(); }
+
+	inline stripe_t& stripe(const K& k) const {
+		if(_cnt == 1)
+			return _stripes[0];
+		return _stripes[(t::uint64(H::computeHash(k)) * 0x9e3779b97f4a7c15ULL) >> _shift];
+	}
+
+	ConcurrentHashMap(const self_t&);
+	self_t& operator=(const self_t&);
+
+	int _cnt, _shift;
+	stripe_t *_stripes;
+};
+
+}	// elm
+
+#endif /* ELM_DATA_CONCURRENTHASHMAP_H_ */
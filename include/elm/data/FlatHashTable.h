@@ -0,0 +1,257 @@
+/*
+ *	FlatHashTable class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_DATA_FLATHASHTABLE_H_
+#define ELM_DATA_FLATHASHTABLE_H_
+
+#include "custom.h"
+#include <elm/adapter.h>
+#include <elm/array.h>
+#include <elm/hash.h>
+
+namespace elm {
+
+template <class T, class H = HashKey<T>, class A = DefaultAlloc >
+class FlatHashTable: public H, public A {
+public:
+	typedef FlatHashTable<T, H, A> self_t;
+
+private:
+	typedef t::uint8 dist_t;
+	static const int max_dist = 255;
+
+	struct slot_t {
+		dist_t dist;
+		T data;
+	};
+
+	inline int home(const T& key) const
+		{ return int((t::uint64(H::computeHash(key)) * 0x9e3779b97f4a7c15ULL) >> _shift); }
+	inline int nextSlot(int i) const { return (i + 1) & (_cap - 1); }
+
+	int lookup(const T& key) const {
+		if(_cnt == 0)
+			return -1;
+		for(int i = home(key), d = 1; _tab[i].dist >= d; i = nextSlot(i), d++)
+			if(_tab[i].dist == d && H::isEqual(_tab[i].data, key))
+				return i;
+		return -1;
+	}
+
+	int insert(const T& x) {
+		T v(x);
+		int r = -1;
+		for(int i = home(v), d = 1; true; i = nextSlot(i), d++) {
+			if(d > max_dist) {
+				grow(_cap * 2);
+				if(r < 0)
+					return insert(v);
+				insert(v);
+				return lookup(x);
+			}
+			if(_tab[i].dist == 0) {
+				new(&_tab[i].data) T(v);
+				_tab[i].dist = d;
+				_cnt++;
+				return r < 0 ? i : r;
+			}
+			if(_tab[i].dist < d) {
+				elm::swap(v, _tab[i].data);
+				int od = _tab[i].dist;
+				_tab[i].dist = d;
+				d = od;
+				if(r < 0)
+					r = i;
+			}
+		}
+	}
+
+	void erase(int i) {
+		_tab[i].data.~T();
+		for(int j = nextSlot(i); _tab[j].dist > 1; i = j, j = nextSlot(j)) {
+			new(&_tab[i].data) T(_tab[j].data);
+			_tab[j].data.~T();
+			_tab[i].dist = _tab[j].dist - 1;
+		}
+		_tab[i].dist = 0;
+		_cnt--;
+	}
+
+	void alloc(int cap) {
+		_cap = 1;
+		_shift = 64;
+		while(_cap < cap) {
+			_cap <<= 1;
+			_shift--;
+		}
+		if(_shift == 64) {
+			_cap = 2;
+			_shift = 63;
+		}
+		_tab = static_cast<slot_t *>(A::allocate(_cap * sizeof(slot_t)));
+		for(int i = 0; i < _cap; i++)
+			_tab[i].dist = 0;
+		_cnt = 0;
+	}
+
+	void grow(int cap) {
+		slot_t *tab = _tab;
+		int ocap = _cap;
+		alloc(cap);
+		for(int i = 0; i < ocap; i++)
+			if(tab[i].dist != 0) {
+				insert(tab[i].data);
+				tab[i].data.~T();
+			}
+		A::free(tab);
+	}
+
+	inline bool full(int n) const { return n > _cap * _load; }
+
+	// slot starting the iteration: removals never fill an empty slot
+	inline int origin(void) const
+		{ for(int i = 0; i < _cap; i++) if(_tab[i].dist == 0) return i; return 0; }
+
+	struct InternIterator {
+		friend class FlatHashTable;
+		inline InternIterator(const self_t& _htab): htab(&_htab), i(_htab.origin()), left(_htab._cap) { step(); }
+		inline InternIterator(const self_t& _htab, bool end): htab(&_htab), i(_htab.origin()), left(_htab._cap)
+			{ if(end) i = -1; else step(); }
+		inline bool ended(void) const { return i < 0; }
+		inline void next(void) { step(); }
+		inline bool equals(const InternIterator& it) const { return i == it.i && htab == it.htab; }
+	protected:
+		inline const T& data(void) const { return htab->_tab[i].data; }
+	private:
+		inline void step(void) {
+			while(left != 0) {
+				left--;
+				i = (i - 1) & (htab->_cap - 1);
+				if(htab->_tab[i].dist != 0)
+					return;
+			}
+			i = -1;
+		}
+		const self_t *htab;
+		int i, left;
+	};
+
+public:
+
+	FlatHashTable(int size = 16): _load(.8f) { alloc(size); }
+	FlatHashTable(const self_t& h): _load(h._load) { alloc(h._cap); putAll(h); }
+	~FlatHashTable(void)
+		{ clear(); A::free(_tab); }
+	inline const H& hash() const { return *this; }
+	inline H& hash() { return *this; }
+	inline const A& allocator() const { return *this; }
+	inline A& allocator() { return *this; }
+
+	inline float maxLoad() const { return _load; }
+	inline void setMaxLoad(float load) { _load = load <= 0 || load > 1 ? 1 : load; }
+	void reserve(int n) { if(full(n)) grow(int(n / _load) + 1); }
+	inline int size() const { return _cap; }
+
+	inline const T *get(const T& key) const
+		{ int i = lookup(key); return i >= 0 ? &_tab[i].data : nullptr; }
+	inline T *get(const T& key)
+		{ int i = lookup(key); return i >= 0 ? &_tab[i].data : nullptr; }
+	inline bool hasKey(const T& key) const { return lookup(key) >= 0; }
+	inline bool exists(const T& key) const { return hasKey(key); }
+
+	void put(const T& data)
+		{ int i = lookup(data); if(i >= 0) _tab[i].data = data; else add(data); }
+	template <class CC> void putAll(const CC& c)
+		{ for(const auto& x: c) put(x); }
+
+	// Collection concept
+	inline bool isEmpty(void) const { return _cnt == 0; }
+	inline operator bool() const { return !isEmpty(); }
+	inline int count(void) const { return _cnt; }
+	inline bool contains(const T& x) const { return hasKey(x); }
+	template <class CC> bool containsAll(const CC& c) const
+		{ for(const auto& x: c) if(!contains(x)) return false; return true; }
+
+	class Iter: public InternIterator, public InplacePreIterator<Iter, T> {
+	public:
+		inline Iter(const self_t& htab): InternIterator(htab) { };
+		inline Iter(const self_t& htab, bool end): InternIterator(htab, end) { };
+		inline const T& item(void) const { return this->data(); }
+	};
+	inline Iter begin() const { return Iter(*this); }
+	inline Iter end() const { return Iter(*this, true); }
+
+	inline bool equals(const self_t& h) const
+		{ return _cnt == h._cnt && containsAll(h); }
+	inline bool operator==(const self_t& t) const { return equals(t); }
+	inline bool operator!=(const self_t& t) const { return !equals(t); }
+
+	// MutableCollection concept
+	void clear(void) {
+		for(int i = 0; i < _cap; i++)
+			if(_tab[i].dist != 0) {
+				_tab[i].data.~T();
+				_tab[i].dist = 0;
+			}
+		_cnt = 0;
+	}
+
+	T *add(const T& data) {
+		if(full(_cnt + 1))
+			grow(_cap * 2);
+		return &_tab[insert(data)].data;
+	}
+
+	inline self_t& operator+=(const T& x) { add(x); return *this; }
+	template <class C> void addAll(const C& c)
+		{ for(const auto& x: c) add(x); }
+
+	inline void remove(const T& key)
+		{ int i = lookup(key); if(i >= 0) erase(i); }
+	template <class C> void removeAll(const C& c)
+		{ for(const auto& x: c) remove(x); }
+	inline self_t& operator-=(const T& x) { remove(x); return *this; }
+	inline void remove(const Iter& i) { erase(i.i); }
+
+	void copy(const self_t& t) {
+		clear();
+		if(_cap != t._cap) {
+			A::free(_tab);
+			alloc(t._cap);
+		}
+		for(int i = 0; i < _cap; i++) {
+			_tab[i].dist = t._tab[i].dist;
+			if(_tab[i].dist != 0)
+				new(&_tab[i].data) T(t._tab[i].data);
+		}
+		_cnt = t._cnt;
+		_load = t._load;
+	}
+	inline self_t& operator=(const self_t& c) { copy(c); return *this; }
+
+private:
+	slot_t *_tab;
+	int _cap, _shift, _cnt;
+	float _load;
+};
+
+}	// elm
+
+#endif /* ELM_DATA_FLATHASHTABLE_H_ */
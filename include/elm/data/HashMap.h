@@ -44,6 +44,11 @@ public:
 	inline A& allocator() { return _tab.allocator(); }
 	inline const E& equivalence() const { return *this; }
 	inline E& equivalence() { return *this; }
+	inline bool isAdaptive() const { return _tab.isAdaptive(); }
+	inline void setAdaptive(bool adaptive) { _tab.setAdaptive(adaptive); }
+	inline float maxLoad() const { return _tab.maxLoad(); }
+	inline void setMaxLoad(float load) { _tab.setMaxLoad(load); }
+	inline void reserve(int n) { _tab.reserve(n); }
 
 	inline void clear(void) { _tab.clear(); }
 	inline void add(const K& key, const T& val) { _tab.add(pair(key, val)); }
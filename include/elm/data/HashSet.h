@@ -39,6 +39,11 @@ public:
 	inline H& hash() { return _tab.hash(); }
 	inline const A& allocator() const { return _tab.allocator(); }
 	inline A& allocator() { return _tab.allocator(); }
+	inline bool isAdaptive() const { return _tab.isAdaptive(); }
+	inline void setAdaptive(bool adaptive) { _tab.setAdaptive(adaptive); }
+	inline float maxLoad() const { return _tab.maxLoad(); }
+	inline void setMaxLoad(float load) { _tab.setMaxLoad(load); }
+	inline void reserve(int n) { _tab.reserve(n); }
 
 	// Collection concept
 	inline int count(void) const { return _tab.count(); }
@@ -43,27 +43,39 @@ private:
 
 protected:
 	node_t *find(const T& key) const {
-		int i = H::computeHash(key) % _size;
-		for(node_t *node = _tab[i], *prev = 0; node; prev = node, node = node->next)
-			if(H::isEqual(node->data, key)) {
-				if(prev) { prev->next = node->next; node->next = _tab[i]; _tab[i] = node; }
-				return node;
-			}
-		return 0;
+		t::hash h = H::computeHash(key);
+		node_t *node = lookup(_tab, h % _size, key, _adapt);
+		if(node == nullptr && _old != nullptr)
+			node = lookup(_old, h % _osize, key, _adapt);
+		return node;
 	}
 
 	node_t *find_const(const T& key) const {
-		int i = H::computeHash(key) % _size;
-		for(node_t *node = _tab[i], *prev = 0; node; prev = node, node = node->next)
+		t::hash h = H::computeHash(key);
+		node_t *node = lookup(_tab, h % _size, key, false);
+		if(node == nullptr && _old != nullptr)
+			node = lookup(_old, h % _osize, key, false);
+		return node;
+	}
+
+private:
+	static const int rehash_step = 4;
+
+	node_t *lookup(node_t **tab, int i, const T& key, bool mtf) const {
+		for(node_t *node = tab[i], *prev = 0; node; prev = node, node = node->next)
 			if(H::isEqual(node->data, key)) {
+				if(mtf && prev) { prev->next = node->next; node->next = tab[i]; tab[i] = node; }
 				return node;
 			}
 		return 0;
 	}
 
-private:
-
 	node_t *make(const T& data) {
+		_cnt++;
+		if(_old == nullptr && _load > 0 && _cnt > _size * _load)
+			startRehash(_size * 2 + 1);
+		if(_old != nullptr)
+			stepRehash(rehash_step);
 		int i = H::computeHash(data) % _size;
 		node_t *node = new(A::allocate(sizeof(node_t))) node_t(data);
 		node->next = _tab[i];
@@ -71,35 +83,81 @@ private:
 		return node;
 	}
 
+	node_t **allocTab(int size) {
+		node_t **tab = static_cast<node_t **>(A::allocate(size * sizeof(node_t *)));
+		array::fast<node_t*>::clear(tab, size);
+		return tab;
+	}
+
+	void startRehash(int size) {
+		_old = _tab;
+		_osize = _size;
+		_ridx = 0;
+		_size = size;
+		_tab = allocTab(_size);
+	}
+
+	void stepRehash(int n) {
+		for(; n && _ridx < _osize; n--, _ridx++)
+			for(node_t *node = _old[_ridx], *next; node; node = next) {
+				next = node->next;
+				int i = H::computeHash(node->data) % _size;
+				node->next = _tab[i];
+				_tab[i] = node;
+				_old[_ridx] = next;
+			}
+		if(_ridx >= _osize) {
+			A::free(_old);
+			_old = nullptr;
+			_osize = 0;
+		}
+	}
+
+	inline void endRehash() { if(_old != nullptr) stepRehash(_osize); }
+
+	inline int buckets() const { return _size + _osize; }
+	inline node_t *&bucket(int i) const { return i < _size ? _tab[i] : _old[i - _size]; }
+
 	struct InternIterator {
 		friend class HashTable;
 		inline InternIterator(const self_t& _htab): node(nullptr), htab(&_htab) { i = 0; step(); }
 		inline InternIterator(const self_t& _htab, bool end): node(nullptr), htab(&_htab)
-			{ if(end) { i = htab->_size; node = nullptr; } else { i = 0; step(); } }
-		inline bool ended(void) const { return i >= htab->_size; }
+			{ if(end) { i = htab->buckets(); node = nullptr; } else { i = 0; step(); } }
+		inline bool ended(void) const { return i >= htab->buckets(); }
 		inline void next(void) { node = node->next; if(!node) { i++; step(); }  }
 		inline bool equals(const InternIterator& it) const { return node == it.node && i == it.i && htab == it.htab; }
 	protected:
 		node_t *node;
 	private:
-		inline void step(void) { for(; i < htab->_size; i++) if(htab->_tab[i]) { node = htab->_tab[i]; break; } }
+		inline void step(void) { for(; i < htab->buckets(); i++) if(htab->bucket(i)) { node = htab->bucket(i); break; } }
 		const self_t *htab;
 		int i;
 	};
 
 public:
 
-	HashTable(int _size = 211): _size(_size), _tab(new(A::allocate(_size * sizeof(node_t *))) node_t *[_size])
-		{ array::fast<node_t*>::clear(_tab, _size); }
-	HashTable(const self_t& h): _size(h._size), _tab(new(A::allocate(_size * sizeof(node_t *))) node_t *[h._size])
-		{ array::fast<node_t*>::clear(_tab, _size); putAll(h); }
+	HashTable(int _size = 211): _size(_size), _tab(allocTab(_size)), _old(nullptr), _osize(0), _ridx(0), _cnt(0), _load(1), _adapt(false) { }
+	HashTable(const self_t& h): _size(h._size), _tab(allocTab(_size)), _old(nullptr), _osize(0), _ridx(0), _cnt(0), _load(h._load), _adapt(h._adapt)
+		{ putAll(h); }
 	~HashTable(void)
-		{ clear(); delete [] _tab; }
+		{ clear(); A::free(_tab); }
 	inline const H& hash() const { return *this; }
 	inline H& hash() { return *this; }
 	inline const A& allocator() const { return *this; }
 	inline A& allocator() { return *this; }
 
+	inline bool isAdaptive() const { return _adapt; }
+	inline void setAdaptive(bool adaptive) { _adapt = adaptive; }
+	inline float maxLoad() const { return _load; }
+	inline void setMaxLoad(float load) { _load = load; }
+	void reserve(int n) {
+		endRehash();
+		if(_load > 0 && n > _size * _load) {
+			startRehash(int(n / _load) + 1);
+			endRehash();
+		}
+	}
+
 	inline const T *get(const T& key) const
 		{ node_t *node = find(key); return node ? &node->data : 0; }
 	inline const T *get_const(const T& key) const
@@ -118,11 +176,9 @@ public:
 
 
 	// Collection concept
-	bool isEmpty(void) const
-		{ for(int i = 0; i < _size; i++) if(_tab[i]) return false; return true; }
+	inline bool isEmpty(void) const { return _cnt == 0; }
 	operator bool() const { return !isEmpty(); }
-	int count(void) const
-	 	{ int cnt = 0; for(int i = 0; i < _size; i++) for(node_t *cur = _tab[i]; cur; cur = cur->next) cnt++; return cnt; }
+	inline int count(void) const { return _cnt; }
 	inline bool contains(const T& x) const
 		{ return find(x) != nullptr; }
 	inline bool contains_const(const T& x) const
@@ -150,10 +206,16 @@ public:
 
 	// MutableCollection concept
 	void clear(void) {
-		for(int i = 0; i < _size; i++) {
-			for(node_t *cur = _tab[i], *next; cur; cur = next) { next = cur->next; A::free(cur); }
-			_tab[i] = 0;
+		for(int i = 0; i < buckets(); i++) {
+			for(node_t *cur = bucket(i), *next; cur; cur = next) { next = cur->next; A::free(cur); }
+			bucket(i) = 0;
+		}
+		if(_old != nullptr) {
+			A::free(_old);
+			_old = nullptr;
+			_osize = 0;
 		}
+		_cnt = 0;
 	}
 
 	T *add(const T& data) { return &make(data)->data; }
@@ -164,16 +226,9 @@ public:
 		{ for(const auto x: c) add(x); }
 
 	void remove(const T& key) {
-		int i = H::computeHash(key) % _size;
-		for(node_t *node = _tab[i], *prev = 0; node; prev = node, node = node->next)
-			if(H::isEqual(node->data, key)) {
-				if(prev)
-					prev->next = node->next;
-				else
-					_tab[i] = node->next;
-				A::free(node);
-				break;
-			}
+		t::hash h = H::computeHash(key);
+		if(!unlink(_tab, h % _size, key) && _old != nullptr)
+			unlink(_old, h % _osize, key);
 	}
 
 	template <class C> void removeAll(const C& c)
@@ -183,19 +238,25 @@ public:
 
 	void remove(const Iter& i) {
 		node_t *p = nullptr;
-		for(node_t *n = _tab[i.i]; n != i.node; p = n, n = n->next);
+		for(node_t *n = bucket(i.i); n != i.node; p = n, n = n->next);
 		if(p == nullptr)
-			_tab[i.i] = i.node->next;
+			bucket(i.i) = i.node->next;
 		else
 			p->next = i.node->next;
 		A::free(i.node);
+		_cnt--;
 	}
 
 	void copy(const HashTable<T, H>& t) {
 		clear();
-		if(_size != t._size)
+		if(t._old != nullptr)
 			putAll(t);
 		else {
+			if(_size != t._size) {
+				A::free(_tab);
+				_size = t._size;
+				_tab = allocTab(_size);
+			}
 			for(int i = 0; i < _size; i++) {
 				if(t._tab[i] != nullptr) {
 					node_t *q = t._tab[i];
@@ -208,6 +269,7 @@ public:
 					}
 				}
 			}
+			_cnt = t._cnt;
 		}
 	}
 	inline self_t& operator=(const HashTable<T, H>& c) { copy(c); return *this; }
@@ -227,8 +289,26 @@ private:
 		int count(int i) const { int c = 0; for(node_t *n = _tab[i]; n; n = n->next) c++; return c; }
 #	endif
 
+	bool unlink(node_t **tab, int i, const T& key) {
+		for(node_t *node = tab[i], *prev = 0; node; prev = node, node = node->next)
+			if(H::isEqual(node->data, key)) {
+				if(prev)
+					prev->next = node->next;
+				else
+					tab[i] = node->next;
+				A::free(node);
+				_cnt--;
+				return true;
+			}
+		return false;
+	}
+
 	int _size;
 	node_t **_tab;
+	node_t **_old;
+	int _osize, _ridx, _cnt;
+	float _load;
+	bool _adapt;
 };
 
 }	// otawa
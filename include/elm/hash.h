@@ -37,6 +37,9 @@ namespace t { typedef t::intptr hash; }
 t::hash hash_string(const char *chars, int length);
 t::hash hash_cstring(const char *chars);
 t::hash hash_jenkins(const void *block, int size);
+t::hash hash_block(const void *block, int size);
+inline t::hash hash_combine(t::hash h, t::hash v)
+	{ return h ^ (v + t::hash(0x9e3779b97f4a7c15ULL) + (h << 6) + (h >> 2)); }
 inline t::hash hash_ptr(const void *p) {
 #	ifdef ELM_32
 		return t::hash(p) >> 2;
@@ -49,7 +52,7 @@ bool hash_equals(const void *p1, const void *p2, int size);
 // HashKey class
 template <class T> class HashKey {
 public:
-	static t::hash hash(const T& key) { return hash_jenkins(&key, sizeof(T)); };
+	static t::hash hash(const T& key) { return hash_block(&key, sizeof(T)); };
 	static inline bool equals(const T& key1, const T& key2) { return &key1 == &key2 || Equiv<T>::equals(key1, key2); }
 	inline t::hash computeHash(const T& key) const { return hash(key); }
 	inline bool isEqual(const T& key1, const T& key2) const { return equals(key1, key2); }
@@ -102,7 +105,7 @@ public:
 template <class T1, class T2> class HashKey<Pair<T1, T2> > {
 public:
 	typedef Pair<T1, T2> T;
-	static t::hash hash(const T& p) { return HashKey<T1>::hash(p.fst) + HashKey<T2>::hash(p.snd); };
+	static t::hash hash(const T& p) { return hash_combine(HashKey<T1>::hash(p.fst), HashKey<T2>::hash(p.snd)); };
 	static inline bool equals(const T& p1, const T& p2) { return p1 == p2; };
 	inline t::hash computeHash(const T& key) const { return hash(key); }
 	inline bool isEqual(const T& key1, const T& key2) const { return equals(key1, key2); }
@@ -113,7 +116,7 @@ public:
 class Hasher {
 public:
 	inline Hasher(void): h(0) { }
-	template <class T> void add(const T& value) { h = h ^ HashKey<T>::hash(value); }
+	template <class T> void add(const T& value) { h = hash_combine(h, HashKey<T>::hash(value)); }
 	template <class T> Hasher& operator+=(const T& value) { add<T>(value); return *this; }
 	template <class T> Hasher& operator<<(const T& value) { add<T>(value); return *this; }
 	inline t::hash hash(void) const { return h; }
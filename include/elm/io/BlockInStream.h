@@ -29,6 +29,7 @@ namespace elm { namespace io {
 
 // BlockInStream class
 class BlockInStream: public InStream {
+	String _str;
 	const char *_block;
 	int _size, off;
 public:
@@ -36,7 +37,9 @@ public:
 	BlockInStream(const void *block, int size);
 	BlockInStream(const char *str);
 	BlockInStream(const CString& str);
-	BlockInStream(const String& str); 
+	BlockInStream(const String& str);
+	BlockInStream(const BlockInStream& s);
+	BlockInStream& operator=(const BlockInStream& s);
 	inline const void *block() const { return _block; }
 	inline int size() const { return _size; }
 	inline int mark() const { return off; }
@@ -48,6 +51,8 @@ public:
 	// InStream overload
 	int read(void *buffer, int size) override;
 	int read() override;
+	int peek(const char *&p) override;
+	void advance(int n) override;
 };
 
 } } // elm::io
@@ -17,22 +17,49 @@ namespace elm { namespace io {
 // BlockOutStream class
 class BlockOutStream: public OutStream {
 public:
-	inline BlockOutStream(int size = 4096, int inc = 256): _block(size, inc) { }
-	inline const char *block(void) const { return _block.base(); }
-	inline int size(void) const { return _block.size(); }
-	inline char *detach(void) { return _block.detach(); }
-	inline void clear(void) { _block.reset(); }
-	inline void setSize(int size) { _block.setSize(size); }
+	typedef struct chunk_t {
+		inline chunk_t(char *b = nullptr, int s = 0): base(b), size(s) { }
+		char *base;
+		int size;
+	} chunk_t;
+	static const int max_chunk = 1 << 20;
+
+	inline BlockOutStream(int size = 4096, int inc = 256, bool chunked = false)
+		: _block(size, inc), _chunked(chunked), _done(0), _chunks(nullptr), _ccnt(0), _ccap(0) { }
+	~BlockOutStream(void);
+	const char *block(void) const;
+	inline const char *block(void) { gather(); return _block.base(); }
+	inline int size(void) const { return _done + _block.size(); }
+	inline char *detach(void) { gather(); return _block.detach(); }
+	chunk_t *detachChunks(int& count);
+	void clear(void);
+	inline void setSize(int size) { gather(); _block.setSize(size); }
+	inline void reserve(int size) { if(!_chunked) _block.reserve(size); }
+	inline float factor(void) const { return _block.factor(); }
+	inline void setFactor(float factor) { _block.setFactor(factor); }
+	inline bool isChunked(void) const { return _chunked; }
+	inline int chunkCount(void) const { return _ccnt + 1; }
+	inline chunk_t chunk(int i) const
+		{ return i < _ccnt ? _chunks[i] : chunk_t(const_cast<char *>(_block.base()), _block.size()); }
 	CString toCString(void);
 	String toString(void);
-	
+	char *allocate(int n);
+	inline void commit(char *p) { _block.setSize(p - _block.base()); }
+
 	// OutStream overload
 	virtual int write(const char *buffer, int size);
 	virtual int write(char byte);
 	virtual int flush(void);
 
 private:
+	void gather(void);
+	void next(void);
 	block::DynBlock _block;
+	bool _chunked;
+	int _done;
+	chunk_t *_chunks;
+	int _ccnt;
+	int _ccap;
 };
 
 } } // elm::io
@@ -41,6 +41,8 @@ public:
 
 	int read(void *buffer, int size) override;
 	int read(void) override;
+	int peek(const char *&p) override;
+	void advance(int n) override;
 
 private:
 	int refill();
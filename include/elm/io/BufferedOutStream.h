@@ -22,6 +22,7 @@
 #ifndef ELM_IO_BUFFERED_OUT_STREAM_H_
 #define ELM_IO_BUFFERED_OUT_STREAM_H_
 
+#include <elm/assert.h>
 #include <elm/io.h>
 #include <elm/io/OutStream.h>
 
@@ -39,6 +40,10 @@ public:
 	void reset();
 	void setStream(OutStream& str);
 	inline OutStream& stream() const { return *out; }
+	inline int size(void) const { return int(buf_size); }
+	inline char *reserve(int n)
+		{ ASSERTP(size_t(n) <= buf_size, "reserve bigger than the buffer"); if(buf_size - top < size_t(n) && flush() < 0) return nullptr; return buf + top; }
+	inline void commit(char *p) { top = p - buf; }
 
 	int write(const char *buffer, int size) override;
 	int write(char byte) override;
@@ -30,9 +30,12 @@ class InStream {
 public:
 	static const int FAILED = -1;
 	static const int ENDED = -2;
+	static const int UNBUFFERED = -3;
 	virtual ~InStream(void) { };
 	virtual int read(void *buffer, int size) = 0;
 	virtual int read(void);
+	virtual int peek(const char *&p);
+	virtual void advance(int n);
 	virtual CString lastErrorMessage(void);
 	
 	static InStream& null;
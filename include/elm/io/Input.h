@@ -118,6 +118,8 @@ private:
 	int get();
 	int skip();
 	void back(int chr);
+	const char *window(const char *&b, const char *&e);
+	template <class T> bool scanNumber(T& x, int base);
 	static const t::uint16
 		ENDED = 0x01,
 		FAILED = 0x02,
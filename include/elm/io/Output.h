@@ -23,9 +23,11 @@
 #define ELM_IO_OUTPUT_H
 
 #include <functional>
+#include <type_traits>
 
 #include <elm/arch.h>
 #include <elm/enum_info.h>
+#include <elm/io/format.h>
 #include <elm/meta.h>
 #include <elm/string/CString.h>
 #include <elm/string/String.h>
@@ -187,6 +189,7 @@ public:
 	void print(bool value);
 	void print(char chr);
 	void print(double value);
+	void print(float value);
 	void print(void *value);
 	inline void print(const char *str) { print(CString(str)); };
 	void print(const CString str);
@@ -196,6 +199,11 @@ public:
 	void print(const StringFormat& fmt);
 	void format(CString fmt, ...);
 	void format(CString fmt, VarArg& args);
+	template <class F, class... T> inline void format(const T&... args);
+#	if __cplusplus >= 202002L
+		template <impl::fmt_string S, class... T> inline void fmt(const T&... args)
+			{ format<impl::fmt_literal<S> >(args...); }
+#	endif
 	bool supportsANSI();
 
 	// deprecated
@@ -210,6 +218,81 @@ private:
 };
 
 
+// compile-time format printing
+namespace impl {
+void fmt_text(Output& out, const char *p, int n, bool raw);
+void fmt_str(Output& out, const fmt_spec_t& s, const char *p, int n);
+
+void fmt_int(Output& out, const fmt_spec_t& s, bool neg, t::uint64 x);
+void fmt_float(Output& out, const fmt_spec_t& s, double x);
+
+template <class I> inline void fmt_int(Output& out, const fmt_spec_t& s, I x) {
+	if(s.isPlain()) {
+		typedef typename std::conditional<(sizeof(I) > 4),
+			typename std::conditional<std::is_signed<I>::value, t::int64, t::uint64>::type,
+			typename std::conditional<std::is_signed<I>::value, t::int32, t::uint32>::type>::type int_t;
+		out.print(int_t(x));
+	}
+	else {
+		bool neg = std::is_signed<I>::value && t::int64(x) < 0;
+		fmt_int(out, s, neg, neg ? t::uint64(0) - t::uint64(t::int64(x)) : t::uint64(x));
+	}
+}
+
+template <class T> inline void fmt_arg(Output& out, const fmt_spec_t& s, const T& x) { out << x; }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, signed char x) { fmt_int(out, s, x); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, unsigned char x) { fmt_int(out, s, x); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, short x) { fmt_int(out, s, x); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, unsigned short x) { fmt_int(out, s, x); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, int x) { fmt_int(out, s, x); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, unsigned int x) { fmt_int(out, s, x); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, long x) { fmt_int(out, s, x); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, unsigned long x) { fmt_int(out, s, x); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, long long x) { fmt_int(out, s, x); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, unsigned long long x) { fmt_int(out, s, x); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, float x)
+	{ if(s.isPlain()) out.print(x); else fmt_float(out, s, x); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, double x)
+	{ if(s.isPlain()) out.print(x); else fmt_float(out, s, x); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, char x)
+	{ if(s.isPlain()) out.print(x); else fmt_str(out, s, &x, 1); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, const char *x)
+	{ if(s.isPlain()) out.print(x); else fmt_str(out, s, x, strlen(x)); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, const CString& x)
+	{ if(s.isPlain()) out.print(x); else fmt_str(out, s, x.chars(), x.length()); }
+inline void fmt_arg(Output& out, const fmt_spec_t& s, const String& x)
+	{ if(s.isPlain()) out.print(x); else fmt_str(out, s, x.chars(), x.length()); }
+
+// print the arguments from the text at offset P of the format F
+template <class F, int P>
+struct fmt_printer {
+	static inline void print(Output& out) {
+		constexpr int e = fmt_next(F::str(), P);
+		if(e > P)
+			fmt_text(out, F::str() + P, e - P, fmt_is_raw(F::str(), P, e));
+	}
+	template <class T, class... R>
+	static inline void print(Output& out, const T& x, const R&... r) {
+		constexpr int b = fmt_next(F::str(), P);
+		constexpr fmt_spec_t s = fmt_parse(F::str(), b);
+		static_assert(fmt_accepts(fmt_kind<T>::_, s), "format specification not supported by the argument type");
+		if(b > P)
+			fmt_text(out, F::str() + P, b - P, fmt_is_raw(F::str(), P, b));
+		fmt_arg(out, s, x);
+		fmt_printer<F, s.end + 1>::print(out, r...);
+	}
+};
+
+}	// impl
+
+template <class F, class... T>
+inline void Output::format(const T&... args) {
+	static_assert(impl::fmt_count(F::str()) >= 0, "malformed format string");
+	static_assert(impl::fmt_count(F::str()) == sizeof...(T), "format placeholders do not match the arguments");
+	impl::fmt_printer<F, 0>::print(*this, args...);
+}
+
+
 // operators accesses
 template <class T> struct def_printer { static inline void print(Output& out, const T& v) { out.print("<not printable>"); } };
 template <class T> struct enum_printer { static inline void print(Output& out, const T& v) { out.print(enum_info<T>::toString(v)); } };
@@ -0,0 +1,157 @@
+/*
+ *	compile-time format strings
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_IO_FORMAT_H_
+#define ELM_IO_FORMAT_H_
+
+#include <elm/string/CString.h>
+#include <elm/string/String.h>
+#include <elm/types.h>
+
+namespace elm { namespace io { namespace impl {
+
+// kinds of formatted arguments
+typedef enum {
+	FMT_ANY = 0,
+	FMT_INT,
+	FMT_FLOAT,
+	FMT_CHAR,
+	FMT_STR
+} fmt_kind_t;
+
+// (the C++ integer types, each t:: integer type being one of them)
+template <class T> struct fmt_kind { static const int _ = FMT_ANY; };
+template <> struct fmt_kind<signed char> { static const int _ = FMT_INT; };
+template <> struct fmt_kind<unsigned char> { static const int _ = FMT_INT; };
+template <> struct fmt_kind<short> { static const int _ = FMT_INT; };
+template <> struct fmt_kind<unsigned short> { static const int _ = FMT_INT; };
+template <> struct fmt_kind<int> { static const int _ = FMT_INT; };
+template <> struct fmt_kind<unsigned int> { static const int _ = FMT_INT; };
+template <> struct fmt_kind<long> { static const int _ = FMT_INT; };
+template <> struct fmt_kind<unsigned long> { static const int _ = FMT_INT; };
+template <> struct fmt_kind<long long> { static const int _ = FMT_INT; };
+template <> struct fmt_kind<unsigned long long> { static const int _ = FMT_INT; };
+template <> struct fmt_kind<float> { static const int _ = FMT_FLOAT; };
+template <> struct fmt_kind<double> { static const int _ = FMT_FLOAT; };
+template <> struct fmt_kind<char> { static const int _ = FMT_CHAR; };
+template <> struct fmt_kind<const char *> { static const int _ = FMT_STR; };
+template <> struct fmt_kind<char *> { static const int _ = FMT_STR; };
+template <int N> struct fmt_kind<char[N]> { static const int _ = FMT_STR; };
+template <> struct fmt_kind<CString> { static const int _ = FMT_STR; };
+template <> struct fmt_kind<String> { static const int _ = FMT_STR; };
+
+// parsed placeholder {:[[fill]align][+][0][width][.precision][type]}
+// (the 0 flag is recorded as fill '0' with the sign-aware alignment '=')
+class fmt_spec_t {
+public:
+	constexpr fmt_spec_t(char f, char a, bool s, int w, int p, char t, int e)
+		: fill(f), align(a), sign(s), width(w), prec(p), type(t), end(e) { }
+	constexpr bool isPlain(void) const
+		{ return fill == ' ' && align == 0 && !sign && width == 0 && prec < 0 && type == 0; }
+	constexpr bool isOneOf(const char *ts) const
+		{ return *ts == '\0' ? type == 0 : *ts == type || isOneOf(ts + 1); }
+	char fill, align;
+	bool sign;
+	int width, prec;
+	char type;
+	int end;	// offset of the closing brace, -1 if the placeholder is malformed
+};
+
+constexpr bool fmt_is_align(char c) { return c == '<' || c == '>' || c == '^'; }
+constexpr bool fmt_is_digit(char c) { return '0' <= c && c <= '9'; }
+constexpr bool fmt_is_type(char c) { return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z'); }
+constexpr int fmt_digits(const char *s, int p) { return fmt_is_digit(s[p]) ? fmt_digits(s, p + 1) : p; }
+constexpr int fmt_number(const char *s, int p, int e, int n = 0)
+	{ return p >= e ? n : fmt_number(s, p + 1, e, n * 10 + (s[p] - '0')); }
+
+// parsing steps of a placeholder
+constexpr fmt_spec_t fmt_close(const char *s, int p, char f, char a, bool g, int w, int r, char t)
+	{ return fmt_spec_t(f, a, g, w, r, t, s[p] == '}' ? p : -1); }
+constexpr fmt_spec_t fmt_type(const char *s, int p, char f, char a, bool g, int w, int r)
+	{ return fmt_is_type(s[p]) ? fmt_close(s, p + 1, f, a, g, w, r, s[p]) : fmt_close(s, p, f, a, g, w, r, 0); }
+constexpr fmt_spec_t fmt_prec(const char *s, int p, char f, char a, bool g, int w)
+	{ return s[p] != '.' ? fmt_type(s, p, f, a, g, w, -1)
+		: fmt_digits(s, p + 1) == p + 1 ? fmt_spec_t(f, a, g, w, -1, 0, -1)
+		: fmt_type(s, fmt_digits(s, p + 1), f, a, g, w, fmt_number(s, p + 1, fmt_digits(s, p + 1))); }
+constexpr fmt_spec_t fmt_width(const char *s, int p, char f, char a, bool g)
+	{ return fmt_prec(s, fmt_digits(s, p), f, a, g, fmt_number(s, p, fmt_digits(s, p))); }
+constexpr fmt_spec_t fmt_zero(const char *s, int p, char f, char a, bool g)
+	{ return s[p] == '0' && a == 0 ? fmt_width(s, p + 1, '0', '=', g) : fmt_width(s, p, f, a, g); }
+constexpr fmt_spec_t fmt_sign(const char *s, int p, char f, char a)
+	{ return s[p] == '+' ? fmt_zero(s, p + 1, f, a, true) : fmt_zero(s, p, f, a, false); }
+constexpr fmt_spec_t fmt_align(const char *s, int p)
+	{ return s[p] != '\0' && s[p] != '}' && fmt_is_align(s[p + 1]) ? fmt_sign(s, p + 2, s[p], s[p + 1])
+		: fmt_is_align(s[p]) ? fmt_sign(s, p + 1, ' ', s[p])
+		: fmt_sign(s, p, ' ', 0); }
+
+// parse the placeholder whose opening brace is at offset b
+constexpr fmt_spec_t fmt_parse(const char *s, int b)
+	{ return s[b] == '\0' ? fmt_spec_t(' ', 0, false, 0, -1, 0, -1)
+		: s[b + 1] == '}' ? fmt_spec_t(' ', 0, false, 0, -1, 0, b + 1)
+		: s[b + 1] == ':' ? fmt_align(s, b + 2)
+		: fmt_spec_t(' ', 0, false, 0, -1, 0, -1); }
+
+// count the placeholders from p (-1 if the format is malformed)
+constexpr int fmt_count(const char *s, int p = 0, int n = 0)
+	{ return s[p] == '\0' ? n
+		: (s[p] == '{' || s[p] == '}') && s[p + 1] == s[p] ? fmt_count(s, p + 2, n)
+		: s[p] == '}' ? -1
+		: s[p] == '{' ? (fmt_parse(s, p).end < 0 ? -1 : fmt_count(s, fmt_parse(s, p).end + 1, n + 1))
+		: fmt_count(s, p + 1, n); }
+
+// offset of the next placeholder from p (or of the final null character)
+constexpr int fmt_next(const char *s, int p)
+	{ return s[p] == '\0' ? p
+		: (s[p] == '{' || s[p] == '}') && s[p + 1] == s[p] ? fmt_next(s, p + 2)
+		: s[p] == '{' ? p
+		: fmt_next(s, p + 1); }
+
+// test if the text in [p, e[ does not contain escaped braces
+constexpr bool fmt_is_raw(const char *s, int p, int e)
+	{ return p >= e ? true : s[p] == '{' || s[p] == '}' ? false : fmt_is_raw(s, p + 1, e); }
+
+// test if a placeholder specification applies to an argument kind
+constexpr bool fmt_accepts(int k, const fmt_spec_t& s)
+	{ return k == FMT_INT ? s.isOneOf("dxXbo") && s.prec < 0 && s.width < 256
+		: k == FMT_FLOAT ? s.isOneOf("feg") && !s.sign && s.width < 256 && s.prec < 256
+		: k == FMT_CHAR ? s.isOneOf("c") && !s.sign && s.prec < 0
+		: k == FMT_STR ? s.isOneOf("s") && !s.sign
+		: s.isPlain(); }
+
+#if __cplusplus >= 202002L
+	// format string usable as a template argument
+	template <int N>
+	struct fmt_string {
+		constexpr fmt_string(const char (&s)[N]) { for(int i = 0; i < N; i++) str[i] = s[i]; }
+		char str[N];
+	};
+	template <fmt_string S>
+	struct fmt_literal { static constexpr const char *str(void) { return S.str; } };
+#endif
+
+} } }	// elm::io::impl
+
+#define ELM_FORMAT(out, f, ...) \
+	do { \
+		struct __elm_format { static constexpr const char *str(void) { return f; } }; \
+		(out).template format<__elm_format>(__VA_ARGS__); \
+	} while(0)
+
+#endif /* ELM_IO_FORMAT_H_ */
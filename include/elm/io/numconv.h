@@ -0,0 +1,45 @@
+/*
+ *	number and text conversions
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_IO_NUMCONV_H_
+#define ELM_IO_NUMCONV_H_
+
+#include <elm/types.h>
+
+namespace elm { namespace io {
+
+const int int_chars_max = 20;
+const int float_chars_max = 32;
+
+char *toChars(char *p, t::uint32 x);
+char *toChars(char *p, t::int32 x);
+char *toChars(char *p, t::uint64 x);
+char *toChars(char *p, t::int64 x);
+char *toChars(char *p, double x);
+char *toChars(char *p, float x);
+char *toHexChars(char *p, t::uint64 x, bool upper = false);
+
+const char *fromChars(const char *p, const char *e, t::uint64& x, int base = 10);
+const char *fromChars(const char *p, const char *e, t::int64& x, int base = 10);
+const char *fromChars(const char *p, const char *e, double& x);
+
+} }	// elm::io
+
+#endif /* ELM_IO_NUMCONV_H_ */
@@ -21,6 +21,9 @@
 #ifndef ELM_JSON_H_
 #define ELM_JSON_H_
 
+#include <elm/json/CBOR.h>
+#include <elm/json/Document.h>
+#include <elm/json/MessagePack.h>
 #include <elm/json/Parser.h>
 #include <elm/json/Saver.h>
 
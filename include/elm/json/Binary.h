@@ -0,0 +1,132 @@
+/*
+ *	json::BinarySaver and json::BinaryParser classes interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2016, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_JSON_BINARY_H_
+#define ELM_JSON_BINARY_H_
+
+#include <string.h>
+#include <elm/io/StructuredOutput.h>
+#include <elm/json/Parser.h>
+
+namespace elm { namespace json {
+
+class BinarySaver: public io::StructuredOutput {
+public:
+	BinarySaver(io::OutStream& out = io::out);
+	BinarySaver(StringBuffer& buf);
+	BinarySaver(sys::Path& path);
+	virtual ~BinarySaver(void);
+	void close(void);
+	virtual void put(void) = 0;
+
+	// StructuredOutput interface
+	void write(bool x) override;
+	void write(char c) override;
+	void write(signed char x) override;
+	void write(unsigned char x) override;
+	void write(short x) override;
+	void write(unsigned short x) override;
+	void write(int x) override;
+	void write(unsigned int x) override;
+	void write(long x) override;
+	void write(unsigned long x) override;
+	void write(long long int x) override;
+	void write(long long unsigned int x) override;
+	void write(float x) override;
+	void write(double x) override;
+	void write(long double x) override;
+	void write(const char *s) override;
+	void write(cstring x) override;
+	void write(const string& x) override;
+	void key(cstring x) override;
+	void key(const string& x) override;
+
+protected:
+	static const int flush_size = 1 << 16;
+	virtual void writeBool(bool x) = 0;
+	virtual void writeInt(t::int64 x) = 0;
+	virtual void writeUInt(t::uint64 x) = 0;
+	virtual void writeFloat(float x) = 0;
+	virtual void writeDouble(double x) = 0;
+	virtual void writeString(const char *s, int n) = 0;
+	virtual void writeKey(const char *s, int n) = 0;
+
+	virtual bool flushable(void) = 0;
+
+	inline void emit(t::uint8 b) { if(top == cap) grow(1); buf[top++] = b; }
+	inline char *reserve(t::size n) { if(cap - top < n) grow(n); char *r = buf + top; top += n; return r; }
+	inline void emit(const char *p, t::size n) { memcpy(reserve(n), p, n); }
+	static inline void store(char *q, t::uint64 x, int n)
+		{ for(int i = n - 1; i >= 0; i--) { q[i] = char(x); x >>= 8; } }
+
+	char *buf;
+	t::size top, cap;
+
+private:
+	void grow(t::size n);
+	void flush(void);
+	static void check(const char *p, int n);
+	io::OutStream *out;
+	io::OutStream *file;
+};
+
+class BinaryParser {
+public:
+	BinaryParser(Maker& maker);
+	virtual ~BinaryParser(void);
+	void parse(string data);
+	void parse(io::InStream& in);
+	void parse(sys::Path path);
+	inline bool interns(void) const { return symbols; }
+	inline void setInterning(bool interning) { symbols = interning; }
+
+protected:
+	virtual void parseValue(void) = 0;
+	inline t::uint8 get(void) { if(p == e) more(); return *p++; }
+	inline void unget(void) { p--; }
+	inline const t::uint8 *take(int n)
+		{ if(e - p < n) return split(n); const char *r = p; p += n; return reinterpret_cast<const t::uint8 *>(r); }
+	string text(t::uint64 n, bool utf8 = true);
+	void field(t::uint64 n);
+	void onInt(t::int64 x);
+	void onUInt(t::uint64 x);
+	void error(string message);
+	static inline t::uint64 load(const t::uint8 *q, int n)
+		{ t::uint64 x = 0; for(int i = 0; i < n; i++) x = (x << 8) | q[i]; return x; }
+
+	Maker& m;
+
+private:
+	void doParsing(io::InStream& s);
+	bool refill(void);
+	void more(void);
+	const t::uint8 *split(int n);
+
+	io::InStream *in;
+	const char *b, *p, *e;
+	t::size off;
+	String src;
+	char scratch[8];
+	bool symbols;
+};
+
+} }		// elm::json
+
+#endif /* ELM_JSON_BINARY_H_ */
@@ -0,0 +1,70 @@
+/*
+ *	json::CBORSaver and json::CBORParser classes interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2016, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_JSON_CBOR_H_
+#define ELM_JSON_CBOR_H_
+
+#include <elm/json/Binary.h>
+
+namespace elm { namespace json {
+
+class CBORSaver: public BinarySaver {
+public:
+	inline CBORSaver(io::OutStream& out = io::out): BinarySaver(out) { }
+	inline CBORSaver(StringBuffer& buf): BinarySaver(buf) { }
+	inline CBORSaver(sys::Path& path): BinarySaver(path) { }
+	~CBORSaver(void);
+
+	void put(void) override;
+	void beginMap() override;
+	void endMap() override;
+	void beginList() override;
+	void endList() override;
+
+protected:
+	bool flushable(void) override;
+	void writeBool(bool x) override;
+	void writeInt(t::int64 x) override;
+	void writeUInt(t::uint64 x) override;
+	void writeFloat(float x) override;
+	void writeDouble(double x) override;
+	void writeString(const char *s, int n) override;
+	void writeKey(const char *s, int n) override;
+
+private:
+	void head(int major, t::uint64 x);
+};
+
+class CBORParser: public BinaryParser {
+public:
+	inline CBORParser(Maker& maker): BinaryParser(maker) { }
+
+protected:
+	void parseValue(void) override;
+
+private:
+	t::uint64 argument(int info);
+	string chunks(int major);
+	bool isBreak(void);
+};
+
+} }		// elm::json
+
+#endif /* ELM_JSON_CBOR_H_ */
@@ -0,0 +1,151 @@
+/*
+ *	json::Document class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2016, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_JSON_DOCUMENT_H_
+#define ELM_JSON_DOCUMENT_H_
+
+#include <elm/alloc/StackAllocator.h>
+#include <elm/json/Parser.h>
+
+namespace elm { namespace json {
+
+class Document;
+
+class Value {
+	friend class Document;
+public:
+	typedef enum {
+		NULL_VALUE = 0,
+		BOOLEAN,
+		INTEGER,
+		FLOAT,
+		STRING,
+		ARRAY,
+		OBJECT
+	} type_t;
+	static const Value null;
+
+	inline Value(void): _type(NULL_VALUE), _size(0) { _.i = 0; }
+
+	inline type_t type(void) const { return type_t(load()._type); }
+	inline bool isNull(void) const { return type() == NULL_VALUE; }
+	inline bool isBool(void) const { return type() == BOOLEAN; }
+	inline bool isInt(void) const { return type() == INTEGER; }
+	inline bool isFloat(void) const { return type() == FLOAT; }
+	inline bool isNumber(void) const { return type() == INTEGER || type() == FLOAT; }
+	inline bool isString(void) const { return type() == STRING; }
+	inline bool isArray(void) const { return type() == ARRAY; }
+	inline bool isObject(void) const { return type() == OBJECT; }
+
+	inline bool asBool(void) const { check(BOOLEAN); return _.b; }
+	inline t::int64 asInt(void) const { check(INTEGER); return _.i; }
+	inline double asFloat(void) const
+		{ ASSERTP(isNumber(), "JSON value is not a number"); return _type == INTEGER ? double(_.i) : _.f; }
+	inline cstring asString(void) const { check(STRING); return _.s; }
+	inline int length(void) const { check(STRING); return _size; }
+
+	inline int count(void) const
+		{ load(); ASSERTP(_type == ARRAY || _type == OBJECT, "JSON value is not an array or an object"); return _size; }
+	inline const Value& operator[](int i) const;
+	inline cstring key(int i) const;
+	const Value *find(cstring key) const;
+	inline bool contains(cstring key) const { return find(key) != nullptr; }
+	inline const Value& operator[](cstring key) const { const Value *v = find(key); return v ? *v : null; }
+	inline const Value& operator[](const char *key) const { return operator[](cstring(key)); }
+
+private:
+	static const int LAZY = OBJECT + 1;
+	static const int small_max = 8;
+
+	struct member_t;
+
+	typedef struct lazy_t {
+		const char *text;
+		Document *doc;
+	} lazy_t;
+
+	inline const Value& load(void) const { if(_type == LAZY) materialize(); return *this; }
+	inline void check(type_t t) const { ASSERTP(type() == t, "bad JSON value type"); }
+	void materialize(void) const;
+
+	t::uint8 _type;
+	t::uint32 _size;
+	union {
+		bool b;
+		t::int64 i;
+		double f;
+		const char *s;
+		const Value *items;
+		const member_t *members;
+		const lazy_t *lazy;
+	} _;
+};
+
+struct Value::member_t {
+	const char *key;
+	t::uint32 len, hash;
+	Value val;
+};
+
+inline const Value& Value::operator[](int i) const
+	{ ASSERTP(0 <= i && i < count(), "index out of bounds"); load(); return _type == ARRAY ? _.items[i] : _.members[i].val; }
+inline cstring Value::key(int i) const
+	{ load(); check(OBJECT); ASSERTP(0 <= i && i < int(_size), "index out of bounds"); return _.members[i].key; }
+
+class Document {
+	friend class Value;
+public:
+	Document(t::size chunk_size = 1 << 16);
+	~Document(void);
+
+	void parse(string text);
+	inline void parse(cstring text) { parse(string(text)); }
+	inline void parse(const char *text) { parse(string(text)); }
+	void parse(io::InStream& in);
+	void parse(sys::Path path);
+	void clear(void);
+
+	inline const Value& root(void) const { return _root; }
+	inline bool isLazy(void) const { return _lazy; }
+	inline void setLazy(bool lazy) { _lazy = lazy; }
+
+private:
+	class Builder;
+	string read(io::InStream& in);
+	void *allocate(t::size size);
+	const char *copy(const char *s, int n);
+	void makeArray(Value& v, const Value *items, int n);
+	void makeObject(Value& v, const Value::member_t *members, int n);
+	void makeLazy(Value& v, const char *p, const char *e);
+	void load(Value& v);
+	const Value& parseScalar(const char *p, const char *e);
+	void error(const char *p, string message);
+
+	StackAllocator arena;
+	Builder *builder;
+	Parser *parser;
+	String src;
+	Value _root;
+	bool _lazy;
+};
+
+} }		// elm::json
+
+#endif /* ELM_JSON_DOCUMENT_H_ */
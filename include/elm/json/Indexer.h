@@ -0,0 +1,50 @@
+/*
+ *	json::Indexer class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2016, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_JSON_INDEXER_H_
+#define ELM_JSON_INDEXER_H_
+
+#include <elm/types.h>
+
+namespace elm { namespace json {
+
+class Indexer {
+public:
+	static const int capacity = 1 << 14;
+	static bool accelerated(void);
+
+	Indexer(void);
+	void reset(const char *text, t::size length);
+	bool next(void);
+	inline const t::uint32 *begin(void) const { return idx; }
+	inline const t::uint32 *end(void) const { return idx + n; }
+	inline bool stopped(void) const { return stop; }
+
+private:
+	const char *b, *p, *e;
+	t::uint64 prev_escaped, prev_in_string, prev_scalar;
+	int n;
+	bool stop;
+	t::uint32 idx[capacity];
+};
+
+} }	// elm::json
+
+#endif /* ELM_JSON_INDEXER_H_ */
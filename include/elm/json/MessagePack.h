@@ -0,0 +1,80 @@
+/*
+ *	json::MessagePackSaver and json::MessagePackParser classes interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2016, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_JSON_MESSAGEPACK_H_
+#define ELM_JSON_MESSAGEPACK_H_
+
+#include <elm/data/Vector.h>
+#include <elm/json/Binary.h>
+
+namespace elm { namespace json {
+
+class MessagePackSaver: public BinarySaver {
+public:
+	inline MessagePackSaver(io::OutStream& out = io::out): BinarySaver(out) { }
+	inline MessagePackSaver(StringBuffer& buf): BinarySaver(buf) { }
+	inline MessagePackSaver(sys::Path& path): BinarySaver(path) { }
+	~MessagePackSaver(void);
+
+	void put(void) override;
+	void beginMap() override;
+	void endMap() override;
+	void beginList() override;
+	void endList() override;
+
+protected:
+	bool flushable(void) override;
+	void writeBool(bool x) override;
+	void writeInt(t::int64 x) override;
+	void writeUInt(t::uint64 x) override;
+	void writeFloat(float x) override;
+	void writeDouble(double x) override;
+	void writeString(const char *s, int n) override;
+	void writeKey(const char *s, int n) override;
+
+private:
+	typedef struct frame_t {
+		t::size off;
+		t::uint32 count;
+		bool map;
+	} frame_t;
+	inline void item(void) { if(stack && !stack.top().map) stack.top().count++; }
+	void begin(bool map);
+	void end(bool map);
+	void str(const char *s, int n);
+
+	Vector<frame_t> stack;
+};
+
+class MessagePackParser: public BinaryParser {
+public:
+	inline MessagePackParser(Maker& maker): BinaryParser(maker) { }
+
+protected:
+	void parseValue(void) override;
+
+private:
+	void parseArray(t::uint32 n);
+	void parseMap(t::uint32 n);
+};
+
+} }		// elm::json
+
+#endif /* ELM_JSON_MESSAGEPACK_H_ */
@@ -23,6 +23,7 @@
 
 #include "common.h"
 #include <elm/io.h>
+#include <elm/string/Symbol.h>
 #include <elm/sys/Path.h>
 
 namespace elm { namespace json {
@@ -35,21 +36,39 @@ public:
 	virtual void beginArray(void);
 	virtual void endArray(void);
 	virtual void onField(string name);
+	virtual void onFieldSymbol(Symbol name);
 	virtual void onNull(void);
 	virtual void onValue(bool value);
 	virtual void onValue(int value);
+	virtual void onValue(t::int64 value);
 	virtual void onValue(double value);
 	virtual void onValue(string value);
 };
 
+class Indexer;
+
 class Parser {
 public:
+	static const int buffer_size = 1 << 16;
+	typedef enum {
+		AUTO = 0,
+		CLASSIC,
+		STRUCTURAL
+	} engine_t;
+
 	Parser(Maker& maker);
+	~Parser(void);
 	void parse(string s);
 	inline void parse(cstring s) { parse(string(s)); }
 	inline void parse(const char *s) { parse(string(s)); }
 	void parse(io::InStream& in);
 	void parse(sys::Path path);
+	inline bool interns(void) const { return symbols; }
+	inline void setInterning(bool interning) { symbols = interning; }
+	inline engine_t engine(void) const { return eng; }
+	inline void setEngine(engine_t engine) { eng = engine; }
+	inline bool readsAhead(void) const { return ahead; }
+	inline void setReadAhead(bool read_ahead) { ahead = read_ahead; }
 
 private:
 	typedef enum {
@@ -68,25 +87,44 @@ private:
 		COLON
 	} token_t;
 
-	void doParsing(io::InStream& in);
-	token_t parseNumber(io::InStream& in, char c, int base = 10);
-	void parseObject(io::InStream& in);
-	void parseArray(io::InStream& in);
-	void parseValue(io::InStream& in, token_t t);
-	void parseString(io::InStream& in, char c);
-	void parseLitt(io::InStream& in, cstring litt);
-	void parseComment(io::InStream& in);
-	token_t parseBasedNumber(io::InStream& in);
+	void doParsing(io::InStream& in, bool structural = false);
+	bool useStructural(void) const;
+	void parseObject(void);
+	void parseArray(void);
+	void parseValue(token_t t);
+	token_t parseNumber(void);
+	token_t convertNumber(const char *s, const char *e);
+	void parseString(char q);
+	void parseEscapedString(const char *s, char q);
+	t::uint16 parseHex4(void);
+	void parseLitt(cstring litt);
+	token_t checkEnd(token_t t);
+	void parseComment(void);
 
-	void error(string message);
-	token_t next(io::InStream& in);
-	char nextChar(io::InStream& in);
-	void pushBack(char c);
+	[[noreturn]] void error(string message);
+	token_t next(void);
+	token_t nextIndexed(void);
+	bool moreIndexes(void);
+	void syncLine(void);
+	bool refill(void);
+	inline int get(void) { return p < e || refill() ? t::uint8(*p++) : -1; }
+	inline void newLine(void) { line++; line_off = off + (p - b); }
 
 	Maker& m;
-	int line, col;
-	String text;
-	char prev;
+	io::InStream *in;
+	const char *b, *p, *e;
+	t::size off, line_off;
+	int line;
+	String src, text;
+	t::int64 ival;
+	double fval;
+	bool symbols;
+	engine_t eng;
+	bool ahead;
+	Indexer *ix;
+	const t::uint32 *ip, *ie;
+	const char *lp;
+	bool indexed;
 };
 
 } }		// elm::json
@@ -33,9 +33,10 @@ namespace elm { namespace json {
 
 class Saver: public io::StructuredOutput {
 public:
-	Saver(io::OutStream& out = io::out);
-	Saver(StringBuffer& buf);
-	Saver(sys::Path& path);
+	static const int default_buffer_size = 1 << 16;
+	Saver(io::OutStream& out = io::out, int buffer_size = default_buffer_size);
+	Saver(StringBuffer& buf, int buffer_size = default_buffer_size);
+	Saver(sys::Path& path, int buffer_size = default_buffer_size);
 	~Saver(void);
 	void close(void);
 
@@ -104,14 +105,22 @@ private:
 	static bool isObject(state_t s);
 	static bool isArray(state_t s);
 	void escape(utf8::char_t c);
+	void escape(const char *p, int n);
 	inline void nextByValue(void);
-	
+	inline char *reserve(int n)
+		{ if(blk) return blk->allocate(n); char *q = buf->reserve(n); if(q == nullptr) failed(); return q; }
+	inline void commit(char *q) { if(blk) blk->commit(q); else buf->commit(q); }
+	inline void emit(char c) { char *q = reserve(1); *q = c; commit(q + 1); }
+	void emit(const char *s, int n);
+	template <class T> void number(T x);
+	void failed(void);
+
 	state_t state;
 	Vector<state_t> stack;
-	io::Output _out;
 	bool readable;
 	string indent;
 	io::BufferedOutStream *buf;
+	io::BlockOutStream *blk;
 	io::OutStream *str;
 };
 
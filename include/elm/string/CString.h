@@ -8,6 +8,7 @@
 #define ELM_STRING_CSTRING_H
 
 #include <string.h>
+#include <elm/string/search.h>
 
 namespace elm {
 
@@ -40,10 +41,10 @@ public:
 	
 	inline int indexOf(char chr) const { return indexOf(chr, 0); };
 	inline int indexOf(char chr, int pos) const
-		{ for(const char *p = buf + pos; *p; p++) if(*p == chr) return p - buf; return -1; };
+		{ const char *p = chr ? strchr(buf + pos, chr) : nullptr; return p ? p - buf : -1; };
 	inline int lastIndexOf(char chr) const { return lastIndexOf(chr, length()); };
 	inline int lastIndexOf(char chr, int pos) const
-		{ for(const char *p = buf + pos - 1; p >= buf; p--) if(*p == chr) return p - buf; return -1; };
+		{ const char *p = chars::findLast(buf, pos, chr); return p ? p - buf : -1; };
 	
 	// Suffix and prefix
 	inline bool startsWith(const char *str) const;
@@ -0,0 +1,109 @@
+/*
+ *	Rope class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_STRING_ROPE_H_
+#define ELM_STRING_ROPE_H_
+
+#include <elm/io/Output.h>
+#include <elm/PreIterator.h>
+#include <elm/string/String.h>
+#include <elm/util/RefCount.h>
+
+namespace elm {
+
+class Rope {
+	typedef struct node_t {
+		inline node_t(const String& s): use(1), len(s.length()), height(0), left(nullptr), right(nullptr), str(s) { }
+		node_t(node_t *l, node_t *r);
+		mutable t::intptr use;
+		int len, height;
+		node_t *left, *right;
+		String str;
+	} node_t;
+
+public:
+	static const int leaf_max = 128;
+
+	inline Rope(void): n(nullptr) { }
+	Rope(const String& s);
+	inline Rope(cstring s): Rope(String(s)) { }
+	inline Rope(const char *s): Rope(String(s)) { }
+	inline Rope(const Rope& r): n(r.n) { lock(n); }
+	inline ~Rope(void) { unlock(n); }
+	inline Rope& operator=(const Rope& r) { lock(r.n); unlock(n); n = r.n; return *this; }
+
+	inline int length(void) const { return n ? n->len : 0; }
+	inline bool isEmpty(void) const { return !n; }
+	inline operator bool(void) const { return !isEmpty(); }
+	char charAt(int i) const;
+	inline char operator[](int i) const { return charAt(i); }
+
+	Rope concat(const Rope& r) const;
+	inline Rope operator+(const Rope& r) const { return concat(r); }
+	inline Rope operator+(const String& s) const { return concat(s); }
+	inline Rope operator+(cstring s) const { return concat(s); }
+	inline Rope operator+(const char *s) const { return concat(s); }
+	inline Rope& operator+=(const Rope& r) { return *this = concat(r); }
+	inline Rope& operator+=(const String& s) { return *this = concat(s); }
+	inline Rope& operator+=(cstring s) { return *this = concat(s); }
+	inline Rope& operator+=(const char *s) { return *this = concat(s); }
+	Rope substring(int off, int len) const;
+	inline Rope substring(int off) const { return substring(off, length() - off); }
+
+	String toString(void) const;
+	void write(io::OutStream& out) const;
+	void print(io::Output& out) const;
+
+	class Iter: public PreIterator<Iter, String> {
+	public:
+		inline Iter(const Rope& r): sp(0), cur(nullptr) { down(r.n); }
+		inline bool ended(void) const { return !cur; }
+		inline const String& item(void) const { return cur->str; }
+		void next(void);
+		inline bool equals(const Iter& i) const { return cur == i.cur; }
+	private:
+		void down(const node_t *p);
+		static const int max_height = 48;
+		const node_t *s[max_height];
+		int sp;
+		const node_t *cur;
+	};
+	inline Iter begin(void) const { return Iter(*this); }
+	inline Iter end(void) const { return Iter(Rope()); }
+
+private:
+	inline Rope(node_t *node): n(node) { }
+	static inline void lock(const node_t *p) { if(p) RefCount<t::intptr>::incr(p->use); }
+	static void unlock(const node_t *p);
+	static inline int height(const node_t *p) { return p ? p->height : -1; }
+	static inline bool isLeaf(const node_t *p) { return !p->left; }
+	static node_t *join(node_t *l, node_t *r);
+	static node_t *make(node_t *l, node_t *r);
+	static node_t *balance(node_t *l, node_t *r);
+	static node_t *sub(node_t *p, int off, int len);
+	static void flatten(const node_t *p, char *buf);
+	node_t *n;
+};
+
+inline io::Output& operator<<(io::Output& out, const Rope& r) { r.print(out); return out; }
+
+}	// elm
+
+#endif /* ELM_STRING_ROPE_H_ */
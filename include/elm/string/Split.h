@@ -27,9 +27,15 @@ namespace elm {
 
 class StringSplit {
 public:
-	inline StringSplit(void): l(-1), p(-1) { }
-	inline StringSplit(const String& str, char chr): s(str), ss(String::make(chr)), l(-1), p(-1) { find(); }
-	inline StringSplit(const String& str, String sub): s(str), ss(sub), l(-1), p(-1) { find(); }
+	inline StringSplit(void): cs(nullptr), l(-1), p(-1) { }
+	inline StringSplit(const String& str, char chr): s(str), ss(String::make(chr)), cs(nullptr), l(-1), p(-1) { find(); }
+	inline StringSplit(const String& str, String sub): s(str), ss(sub), cs(nullptr), l(-1), p(-1) { find(); }
+	inline StringSplit(const String& str, const chars::Set& set): s(str), cs(new chars::Set(set)), l(-1), p(-1) { find(); }
+	inline StringSplit(const StringSplit& sp)
+		: s(sp.s), ss(sp.ss), cs(sp.cs ? new chars::Set(*sp.cs) : nullptr), l(sp.l), p(sp.p) { }
+	inline ~StringSplit(void) { delete cs; }
+	inline StringSplit& operator=(const StringSplit& sp)
+		{ if(this != &sp) { s = sp.s; ss = sp.ss; delete cs; cs = sp.cs ? new chars::Set(*sp.cs) : nullptr; l = sp.l; p = sp.p; } return *this; }
 
 	inline bool ended(void) const { return l >= s.length(); }
 	inline String item(void) const { return s.substring(l + 1, p - l - 1); }
@@ -45,10 +51,20 @@ public:
 	inline bool operator!=(const StringSplit& sp) const { return !equals(sp); }
 
 private:
-	inline void find(void)
-		{ l = p; p = s.indexOf(ss, l + 1); if(p < 0) p = s.length(); }
+	inline void find(void) {
+		l = p;
+		if(cs)
+			p = s.indexOf(*cs, l + 1);
+		else if(ss.length() == 1)
+			p = s.indexOf(ss[0], l + 1);
+		else
+			p = s.indexOf(ss, l + 1);
+		if(p < 0)
+			p = s.length();
+	}
 	String s;
 	String ss;
+	chars::Set *cs;
 	int l, p;
 };
 
@@ -21,8 +21,11 @@
 #ifndef ELM_STRING_STRING_H
 #define ELM_STRING_STRING_H
 
+#include <elm/int.h>
 #include <elm/PreIterator.h>
 #include <elm/string/CString.h>
+#include <elm/string/search.h>
+#include <elm/util/RefCount.h>
 
 namespace elm {
 
@@ -30,97 +33,114 @@ namespace elm {
 class String {
 	friend class CString;
 	friend class StringBuffer;
+	friend class Rope;
 
 	// Data structure
 	typedef struct buffer_t {
-		unsigned short use;
+		t::intptr use;
 		char buf[1];
 	} buffer_t;
-	static buffer_t empty_buf;
-	static const int zero_off = sizeof(unsigned short);
-	mutable const char *buf;
-	mutable unsigned short off, len;
+	static const int zero_off = sizeof(t::intptr);
+	static const int local_max = sizeof(t::uint32) + sizeof(const char *) - 1;
+	typedef struct ref_t {
+		t::uint32 len, off;
+		const char *buf;
+	} ref_t;
+	typedef struct local_t {
+		t::uint32 len;
+		char buf[local_max + 1];
+	} local_t;
+	mutable union {
+		ref_t ref;
+		local_t loc;
+	} u;
 
 	// Internals
+	static const t::intptr arena_use = t::intptr(1) << (sizeof(t::intptr) * 8 - 2);
 	void copy(const char *str, int _len);
-	void lock(void) const { ((buffer_t *)buf)->use++; }
+	void copy(const char *str, int _len, void *block);
+	inline bool isLocal(void) const { return u.ref.len <= t::uint32(local_max); }
+	inline buffer_t *buffer(void) const { return (buffer_t *)u.ref.buf; }
+	inline void lock(void) const { if(!isLocal()) RefCount<t::intptr>::incr(buffer()->use); }
 	void toc(void) const;
-	void unlock(void) const {
-		((buffer_t *)buf)->use--;
-		if(!((buffer_t *)buf)->use && buf != (char *)&empty_buf)
-			delete [] buf;
-	}
-	inline String(const char *_buf, int _off, int _len): buf(_buf), off(_off), len(_len) { lock(); };
+	inline void unlock(void) const
+		{ if(!isLocal() && RefCount<t::intptr>::decr(buffer()->use)) delete [] u.ref.buf; }
+	String(const String& str, int off, int len);
+	String(buffer_t *buffer, int length);
 	static String concat(const char *s1, int l1, const char *s2, int l2);
-	inline String(buffer_t *buffer, int offset, int length)
-		: buf((char *)buffer), off(offset), len(length) { lock(); };
 
 public:
 	static String make(char chr);
 	static String make(String chr, int n);
 
-	inline String(void): buf((char *)&empty_buf), off(zero_off), len(0) { lock(); };
+	inline String(void) { u.loc.len = 0; u.loc.buf[0] = '\0'; };
 	inline String(const char *str, int _len) { copy(str, _len); };
 	inline String(const char *str) { if(!str) str = ""; copy(str, strlen(str)); };
 	inline String(cstring str) { copy(str.chars(), str.length()); };
-	inline String(const String& str): buf(str.buf), off(str.off), len(str.len) { lock(); };
+	template <class A> inline String(const char *str, int _len, A& alloc)
+		{ if(_len <= local_max) copy(str, _len); else copy(str, _len, alloc.allocate(zero_off + _len + sizeof(t::intptr))); }
+	inline String(const String& str): u(str.u) { lock(); };
 	inline ~String(void) { unlock(); };
 	inline String& operator=(const String& str)
-		{ str.lock(); unlock(); buf = str.buf; off = str.off; len = str.len; return *this; };
+		{ str.lock(); unlock(); u = str.u; return *this; };
 	inline String& operator=(const CString str)
 		{ unlock(); copy(str.chars(), str.length()); return *this; };
 	inline String& operator=(const char *str)
 		{ if(!str) str = ""; unlock(); copy(str, strlen(str)); return *this; };
 
-	inline int length(void) const { return len; };
-	inline const char *chars(void) const { return buf + off; };
+	inline int length(void) const { return u.ref.len; };
+	inline const char *chars(void) const { return isLocal() ? u.loc.buf : u.ref.buf + u.ref.off; };
 	inline int compare(const String& str) const {
-		int res = memcmp(chars(), str.chars(), len > str.len ? str.len : len);
-		return res ? res : len - str.len;
+		int len = length(), slen = str.length();
+		int res = memcmp(chars(), str.chars(), len > slen ? slen : len);
+		return res ? res : len - slen;
 	};
 	inline int compare(const CString str) const {
-		int slen = str.length();
+		int len = length(), slen = str.length();
 		int res = memcmp(chars(), str.chars(), len > slen ? slen : len);
 		return res ? res : len - slen;
 	};
 
-	inline bool isEmpty(void) const { return !len; };
+	inline bool isEmpty(void) const { return !u.ref.len; };
 	inline operator bool(void) const { return !isEmpty(); };
 
-	inline CString toCString(void) const { if(buf[off + len] != '\0') toc(); return chars(); };
+	inline CString toCString(void) const
+		{ if(!isLocal() && u.ref.buf[u.ref.off + u.ref.len] != '\0') toc(); return chars(); };
 	inline const char *asNullTerminated() const { return toCString().chars(); };
 	inline const char *asSysString() const { return asNullTerminated(); }
 
-	inline char charAt(int index) const { return buf[index + off]; };
+	inline char charAt(int index) const { return chars()[index]; };
 	inline char operator[](int index) const { return charAt(index); };
-	inline String substring(int _off) const { return String(buf, off + _off, len - _off); };
-	inline String substring(int _off, int _len) const { return String(buf, off + _off, _len); };
+	inline String substring(int _off) const { return String(*this, _off, length() - _off); };
+	inline String substring(int _off, int _len) const { return String(*this, _off, _len); };
 
-	inline String concat(const CString str) const { return concat(chars(), len, str.chars(), str.length()); };
-	inline String concat(const String& str) const { return concat(chars(), len, str.chars(), str.length()); };
+	inline String concat(const CString str) const { return concat(chars(), length(), str.chars(), str.length()); };
+	inline String concat(const String& str) const { return concat(chars(), length(), str.chars(), str.length()); };
 
 	inline int indexOf(char chr) const { return indexOf(chr, 0); };
 	inline int indexOf(char chr, int pos) const
-		{ for(const char *p = chars() + pos; p < chars() + len; p++) if(*p == chr) return p - chars(); return -1; };
-	int indexOf(const String& str, int pos = 0);
+		{ const char *p = chars::find(chars() + pos, length() - pos, chr); return p ? p - chars() : -1; };
+	int indexOf(const String& str, int pos = 0) const;
+	inline int indexOf(const chars::Set& set, int pos = 0) const
+		{ const char *p = set.find(chars() + pos, length() - pos); return p ? p - chars() : -1; }
 	inline int lastIndexOf(char chr) const { return lastIndexOf(chr, length()); };
 	inline int lastIndexOf(char chr, int pos) const
-		{ for(const char *p = chars() + pos - 1; p >= chars(); p--) if(*p == chr) return p - chars(); return -1; };
-	inline int lastIndexOf(const String& str) { return lastIndexOf(str, length()); }
-	int lastIndexOf(const String& str, int pos);
+		{ const char *p = chars::findLast(chars(), pos, chr); return p ? p - chars() : -1; };
+	inline int lastIndexOf(const String& str) const { return lastIndexOf(str, length()); }
+	int lastIndexOf(const String& str, int pos) const;
 
 	inline bool startsWith(const char *str) const
 		{ return startsWith(CString(str)); }
 	inline bool startsWith(const CString str) const
-		{ int l = str.length(); return len >= l && !memcmp(chars(), str.chars(), l); }
+		{ int l = str.length(); return length() >= l && !memcmp(chars(), str.chars(), l); }
 	inline bool startsWith(const String& str) const
-		{ return len >= str.len && !memcmp(chars(), str.chars(), str.length()); }
+		{ return length() >= str.length() && !memcmp(chars(), str.chars(), str.length()); }
 	inline bool endsWith(const char *str) const
 		{ return endsWith(CString(str)); }
 	inline bool endsWith(const CString str) const
-		{ int l = str.length(); return len >= l && !memcmp(chars() + len - l, str.chars(), l); }
+		{ int l = str.length(); return length() >= l && !memcmp(chars() + length() - l, str.chars(), l); }
 	inline bool endsWith(const String& str) const
-		{ return len>= str.len && !memcmp(chars() + len - str.len, str.chars(), str.len); }
+		{ int l = str.length(); return length() >= l && !memcmp(chars() + length() - l, str.chars(), l); }
 
 	String trim(void) const;
 	String ltrim(void) const;
@@ -0,0 +1,119 @@
+/*
+ *	Symbol class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2015, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_STRING_SYMBOL_H_
+#define ELM_STRING_SYMBOL_H_
+
+#include <elm/hash.h>
+#include <elm/io/Output.h>
+#include <elm/string/String.h>
+#include <elm/sys/Lock.h>
+#include <elm/util/Option.h>
+
+namespace elm {
+
+class SymbolTable;
+
+class Symbol {
+	friend class SymbolTable;
+public:
+	typedef struct entry_t {
+		entry_t(const char *chars, int length, t::hash h);
+		class block_t {
+		public:
+			inline block_t(void): b(nullptr) { }
+			inline ~block_t(void) { delete [] b; }
+			inline void *allocate(t::size size) { b = new char[size]; return b; }
+		private:
+			char *b;
+		} block;
+		String str;
+		t::hash hash;
+	} entry_t;
+
+	inline Symbol(void): e(&null_entry) { }
+	Symbol(const String& s);
+	Symbol(cstring s);
+	Symbol(const char *s);
+
+	inline const String& toString(void) const { return e->str; }
+	inline operator const String&(void) const { return e->str; }
+	inline const char *chars(void) const { return e->str.chars(); }
+	inline int length(void) const { return e->str.length(); }
+	inline bool isEmpty(void) const { return e->str.isEmpty(); }
+	inline operator bool(void) const { return !isEmpty(); }
+	inline t::hash hash(void) const { return t::hash(t::intptr(e) >> 4); }
+
+	inline bool equals(const Symbol& s) const { return e == s.e; }
+	inline bool operator==(const Symbol& s) const { return e == s.e; }
+	inline bool operator!=(const Symbol& s) const { return e != s.e; }
+	inline int compare(const Symbol& s) const { return e == s.e ? 0 : e->str.compare(s.e->str); }
+	inline bool operator<(const Symbol& s) const { return compare(s) < 0; }
+	inline bool operator<=(const Symbol& s) const { return compare(s) <= 0; }
+	inline bool operator>(const Symbol& s) const { return compare(s) > 0; }
+	inline bool operator>=(const Symbol& s) const { return compare(s) >= 0; }
+
+private:
+	inline Symbol(const entry_t *entry): e(entry) { }
+	static const entry_t null_entry;
+	const entry_t *e;
+};
+
+class SymbolTable {
+public:
+	SymbolTable(int size = 256);
+	~SymbolTable(void);
+	static SymbolTable& global(void);
+
+	Symbol intern(const char *chars, int length);
+	inline Symbol intern(const String& s) { return intern(s.chars(), s.length()); }
+	inline Symbol intern(cstring s) { return intern(s.chars(), s.length()); }
+	Option<Symbol> lookup(const char *chars, int length);
+	inline Option<Symbol> lookup(const String& s) { return lookup(s.chars(), s.length()); }
+	inline Option<Symbol> lookup(cstring s) { return lookup(s.chars(), s.length()); }
+	inline int count(void) const { return cnt; }
+
+private:
+	SymbolTable(const SymbolTable&);
+	SymbolTable& operator=(const SymbolTable&);
+	int find(const char *chars, int length, t::hash h) const;
+	void grow(void);
+	Symbol::entry_t **tab;
+	int size, cnt;
+	sys::SpinLock lock;
+};
+
+inline Symbol::Symbol(const String& s): e(SymbolTable::global().intern(s).e) { }
+inline Symbol::Symbol(cstring s): e(SymbolTable::global().intern(s).e) { }
+inline Symbol::Symbol(const char *s): e(SymbolTable::global().intern(cstring(s)).e) { }
+
+template <> class HashKey<Symbol> {
+public:
+	static inline t::hash hash(const Symbol& key) { return key.hash(); }
+	static inline bool equals(const Symbol& key1, const Symbol& key2) { return key1 == key2; }
+	inline t::hash computeHash(const Symbol& key) const { return hash(key); }
+	inline bool isEqual(const Symbol& key1, const Symbol& key2) const { return equals(key1, key2); }
+};
+
+inline io::Output& operator<<(io::Output& out, const Symbol& s) { out << s.toString(); return out; }
+
+}	// elm
+
+#endif /* ELM_STRING_SYMBOL_H_ */
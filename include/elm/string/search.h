@@ -0,0 +1,54 @@
+/*
+ *	character search primitives
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_STRING_SEARCH_H_
+#define ELM_STRING_SEARCH_H_
+
+#include <string.h>
+#include <elm/arch.h>
+
+namespace elm { namespace chars {
+
+inline const char *find(const char *p, int n, char c)
+	{ return n <= 0 ? nullptr : static_cast<const char *>(memchr(p, c, n)); }
+const char *findLast(const char *p, int n, char c);
+const char *find(const char *p, int n, const char *s, int m);
+const char *findLast(const char *p, int n, const char *s, int m);
+
+class Set {
+public:
+	static const int simd_max = 8;
+	Set(void);
+	explicit Set(const char *s);
+	Set(const char *s, int n);
+	void add(char c);
+	inline bool contains(char c) const
+		{ t::uint8 i = c; return (bits[i >> 5] >> (i & 31)) & 1; }
+	inline int count(void) const { return cnt; }
+	const char *find(const char *p, int n) const;
+private:
+	t::uint32 bits[8];
+	char cs[simd_max];
+	int cnt;
+};
+
+} }	// elm::chars
+
+#endif /* ELM_STRING_SEARCH_H_ */
@@ -42,8 +42,8 @@ public:
 		: p(str), q(p + size), c(0) { parse(); }
 	inline Iter(cstring str)
 		: p(str.chars()), q(p + str.length()), c(0) { parse(); }
-	inline Iter(string str)
-		: p(str.toCString().chars()), q(p + str.length()), c(0) { parse(); }
+	inline Iter(const string& str)
+		: p(str.chars()), q(p + str.length()), c(0) { parse(); }
 
 	inline bool ended(void) const { return !c; }
 	inline const char_t& item(void) const { return c; }
@@ -55,6 +55,38 @@ private:
 	char_t c;
 };
 
+const t::size bad = t::size(-1);
+bool validate(const char *buf, t::size len);
+inline bool validate(const string& s) { return validate(s.chars(), s.length()); }
+t::size count(const char *buf, t::size len);
+inline t::size count(const string& s) { return count(s.chars(), s.length()); }
+t::size toUtf16(const char *buf, t::size len, t::uint16 *out);
+t::size fromUtf16(const t::uint16 *buf, t::size len, char *out);
+
+inline int encode(char_t c, char *out) {
+	if(c < 0x80)
+		{ out[0] = c; return 1; }
+	else if(c < 0x800)
+		{ out[0] = 0xc0 | (c >> 6); out[1] = 0x80 | (c & 0x3f); return 2; }
+	else if(c < 0x10000)
+		{ out[0] = 0xe0 | (c >> 12); out[1] = 0x80 | ((c >> 6) & 0x3f); out[2] = 0x80 | (c & 0x3f); return 3; }
+	else {
+		out[0] = 0xf0 | (c >> 18); out[1] = 0x80 | ((c >> 12) & 0x3f);
+		out[2] = 0x80 | ((c >> 6) & 0x3f); out[3] = 0x80 | (c & 0x3f); return 4;
+	}
+}
+
+inline char_t decode(const char *& p) {
+	t::uint8 b = *p++;
+	if(b < 0x80)
+		return b;
+	int l = b < 0xe0 ? 1 : b < 0xf0 ? 2 : 3;
+	char_t c = b & (0x3f >> l);
+	for(int i = 0; i < l; i++)
+		c = (c << 6) | (*p++ & 0x3f);
+	return c;
+}
+
 } }	// elm::utf8
 
 #endif	// ELM_STRING_UTF8
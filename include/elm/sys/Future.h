@@ -0,0 +1,330 @@
+/*
+ *	Future and Promise classes interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_SYS_FUTURE_H_
+#define ELM_SYS_FUTURE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <elm/data/Vector.h>
+#include <elm/sys/Thread.h>
+
+namespace elm { namespace sys {
+
+class FutureException: public MessageException {
+public:
+	inline FutureException(const string& message): MessageException(message) { }
+};
+
+namespace impl {
+
+class AbstractFutureState {
+public:
+	AbstractFutureState(void);
+	virtual ~AbstractFutureState(void);
+	inline void acquire(void) { cnt++; }
+	inline void release(void) { if(--cnt == 0) delete this; }
+	inline bool isReady(void) const { return ready.load(std::memory_order_acquire); }
+	inline bool isFailed(void) const { return isReady() && failed; }
+	inline const string& error(void) const { return err; }
+	void wait(void) const;
+	void onReady(const std::function<void(void)>& f);
+	void fail(const string& message);
+protected:
+	bool fulfill(void);
+	void complete(void);
+private:
+	std::atomic<int> cnt;
+	std::atomic<bool> ready;
+	bool failed;
+	string err;
+	mutable std::mutex mutex;
+	mutable std::condition_variable cond;
+	Vector<std::function<void(void)> > conts;
+};
+
+template <class T>
+class FutureState: public AbstractFutureState {
+public:
+	inline FutureState(void): val(nullptr) { }
+	inline ~FutureState(void) { if(val != nullptr) delete val; }
+	inline void set(const T& v)
+		{ T *p = new T(v); if(fulfill()) { val = p; complete(); } else delete p; }
+	inline const T& value(void) const { return *val; }
+private:
+	T *val;
+};
+
+template <>
+class FutureState<void>: public AbstractFutureState {
+public:
+	inline void set(void) { if(fulfill()) complete(); }
+};
+
+string currentError(void);
+template <class R> struct Setter;
+
+}	// impl
+
+template <class T> class Promise;
+
+template <class T>
+class Future {
+	friend class Promise<T>;
+	typedef impl::FutureState<T> state_t;
+	inline Future(state_t *s): _s(s) { _s->acquire(); }
+public:
+	inline Future(void): _s(new state_t()) { _s->acquire(); }
+	inline Future(const Future<T>& f): _s(f._s) { _s->acquire(); }
+	inline ~Future(void) { _s->release(); }
+	inline Future<T>& operator=(const Future<T>& f)
+		{ f._s->acquire(); _s->release(); _s = f._s; return *this; }
+
+	inline bool isReady(void) const { return _s->isReady(); }
+	inline bool isFailed(void) const { return _s->isFailed(); }
+	inline void wait(void) const { _s->wait(); }
+	inline const string& error(void) const { wait(); return _s->error(); }
+	const T& get(void) const
+		{ wait(); if(_s->isFailed()) throw FutureException(_s->error()); return _s->value(); }
+	inline const T& operator*(void) const { return get(); }
+
+	template <class F> void onReady(F f) const
+		{ Future<T> self(*this); _s->onReady([self, f]() { f(self); }); }
+
+	template <class F>
+	auto then(F f) const -> Future<decltype(f(std::declval<const T&>()))> {
+		typedef decltype(f(std::declval<const T&>())) res_t;
+		Promise<res_t> p;
+		onReady([p, f](const Future<T>& r) {
+			if(r.isFailed())
+				p.fail(r.error());
+			else
+				try {
+					impl::Setter<res_t>::set(p, f, r.get());
+				}
+				catch(...) {
+					p.fail(impl::currentError());
+				}
+		});
+		return p.future();
+	}
+
+private:
+	state_t *_s;
+};
+
+template <>
+class Future<void> {
+	friend class Promise<void>;
+	typedef impl::FutureState<void> state_t;
+	inline Future(state_t *s): _s(s) { _s->acquire(); }
+public:
+	inline Future(void): _s(new state_t()) { _s->acquire(); }
+	inline Future(const Future<void>& f): _s(f._s) { _s->acquire(); }
+	inline ~Future(void) { _s->release(); }
+	inline Future<void>& operator=(const Future<void>& f)
+		{ f._s->acquire(); _s->release(); _s = f._s; return *this; }
+
+	inline bool isReady(void) const { return _s->isReady(); }
+	inline bool isFailed(void) const { return _s->isFailed(); }
+	inline void wait(void) const { _s->wait(); }
+	inline const string& error(void) const { wait(); return _s->error(); }
+	inline void get(void) const
+		{ wait(); if(_s->isFailed()) throw FutureException(_s->error()); }
+
+	template <class F> void onReady(F f) const
+		{ Future<void> self(*this); _s->onReady([self, f]() { f(self); }); }
+
+	template <class F>
+	auto then(F f) const -> Future<decltype(f())> {
+		typedef decltype(f()) res_t;
+		Promise<res_t> p;
+		onReady([p, f](const Future<void>& r) {
+			if(r.isFailed())
+				p.fail(r.error());
+			else
+				try {
+					impl::Setter<res_t>::set(p, f);
+				}
+				catch(...) {
+					p.fail(impl::currentError());
+				}
+		});
+		return p.future();
+	}
+
+private:
+	state_t *_s;
+};
+
+template <class T>
+class Promise {
+public:
+	inline Promise(void): _s(new impl::FutureState<T>()) { _s->acquire(); }
+	inline Promise(const Promise<T>& p): _s(p._s) { _s->acquire(); }
+	inline ~Promise(void) { _s->release(); }
+	inline Promise<T>& operator=(const Promise<T>& p)
+		{ p._s->acquire(); _s->release(); _s = p._s; return *this; }
+
+	inline Future<T> future(void) const { return Future<T>(_s); }
+	inline void set(const T& v) const { _s->set(v); }
+	inline void fail(const string& message) const { _s->fail(message); }
+
+private:
+	impl::FutureState<T> *_s;
+};
+
+template <>
+class Promise<void> {
+public:
+	inline Promise(void): _s(new impl::FutureState<void>()) { _s->acquire(); }
+	inline Promise(const Promise<void>& p): _s(p._s) { _s->acquire(); }
+	inline ~Promise(void) { _s->release(); }
+	inline Promise<void>& operator=(const Promise<void>& p)
+		{ p._s->acquire(); _s->release(); _s = p._s; return *this; }
+
+	inline Future<void> future(void) const { return Future<void>(_s); }
+	inline void set(void) const { _s->set(); }
+	inline void fail(const string& message) const { _s->fail(message); }
+
+private:
+	impl::FutureState<void> *_s;
+};
+
+namespace impl {
+
+template <class R>
+struct Setter {
+	template <class F, class... A>
+	static inline void set(const Promise<R>& p, F& f, const A&... a) { p.set(f(a...)); }
+};
+
+template <>
+struct Setter<void> {
+	template <class F, class... A>
+	static inline void set(const Promise<void>& p, F& f, const A&... a) { f(a...); p.set(); }
+};
+
+template <class T>
+class AllState {
+public:
+	inline AllState(const Vector<Future<T> >& fs, const Promise<Vector<T> >& p)
+		: _fs(fs), _p(p), _cnt(fs.length()) { }
+	void done(void) {
+		if(--_cnt != 0)
+			return;
+		Vector<T> r(_fs.length());
+		bool failed = false;
+		for(const auto& g: _fs)
+			if(g.isFailed()) {
+				_p.fail(g.error());
+				failed = true;
+				break;
+			}
+			else
+				r.add(g.get());
+		if(!failed)
+			_p.set(r);
+		delete this;
+	}
+private:
+	Vector<Future<T> > _fs;
+	Promise<Vector<T> > _p;
+	std::atomic<int> _cnt;
+};
+
+template <>
+class AllState<void> {
+public:
+	inline AllState(const Vector<Future<void> >& fs, const Promise<void>& p)
+		: _fs(fs), _p(p), _cnt(fs.length()) { }
+	void done(void) {
+		if(--_cnt != 0)
+			return;
+		bool failed = false;
+		for(const auto& g: _fs)
+			if(g.isFailed()) {
+				_p.fail(g.error());
+				failed = true;
+				break;
+			}
+		if(!failed)
+			_p.set();
+		delete this;
+	}
+private:
+	Vector<Future<void> > _fs;
+	Promise<void> _p;
+	std::atomic<int> _cnt;
+};
+
+}	// impl
+
+template <class T>
+Future<Vector<T> > whenAll(const Vector<Future<T> >& fs) {
+	Promise<Vector<T> > p;
+	if(!fs) {
+		p.set(Vector<T>());
+		return p.future();
+	}
+	impl::AllState<T> *all = new impl::AllState<T>(fs, p);
+	for(const auto& f: fs)
+		f.onReady([all](const Future<T>&) { all->done(); });
+	return p.future();
+}
+
+inline Future<void> whenAll(const Vector<Future<void> >& fs) {
+	Promise<void> p;
+	if(!fs) {
+		p.set();
+		return p.future();
+	}
+	impl::AllState<void> *all = new impl::AllState<void>(fs, p);
+	for(const auto& f: fs)
+		f.onReady([all](const Future<void>&) { all->done(); });
+	return p.future();
+}
+
+template <class T>
+Future<int> whenAny(const Vector<Future<T> >& fs) {
+	ASSERTP(fs, "whenAny() requires at least one future");
+	struct any_t {
+		inline any_t(int n): done(false), cnt(n) { }
+		std::atomic<bool> done;
+		std::atomic<int> cnt;
+	};
+	Promise<int> p;
+	any_t *any = new any_t(fs.length());
+	for(int i = 0; i < fs.length(); i++)
+		fs[i].onReady([p, any, i](const Future<T>&) {
+			if(!any->done.exchange(true))
+				p.set(i);
+			if(--any->cnt == 0)
+				delete any;
+		});
+	return p.future();
+}
+
+} }	// elm::sys
+
+#endif /* ELM_SYS_FUTURE_H_ */
@@ -21,11 +21,30 @@
 #ifndef ELM_SYS_JOBSCHEDULER_H_
 #define ELM_SYS_JOBSCHEDULER_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <elm/sys/Thread.h>
 
 namespace elm { namespace sys {
 
+class JobScheduler;
+class JobWorker;
+
 class Job: public Runnable {
+	friend class JobWorker;
+public:
+	Job(void);
+	Job(const Job& job);
+	Job& operator=(const Job& job);
+protected:
+	void spawn(Job *job);
+	void sync(void);
+	void post(Job *job);
+private:
+	JobWorker *_worker;
+	Job *_parent;
+	std::atomic<int> _pending;
 };
 
 class JobProducer {
@@ -46,7 +65,9 @@ private:
 	I i;
 };
 
-class JobScheduler: private Runnable {
+class JobScheduler {
+	friend class Job;
+	friend class JobWorker;
 public:
 	JobScheduler(void);
 	JobScheduler(JobProducer& producer);
@@ -57,6 +78,9 @@ public:
 	void setProducer(JobProducer& producer);
 	inline int threadCount(void) const { return cnt; }
 	void setThreadCount(int count);
+	inline int batchSize(void) const { return batch; }
+	void setBatchSize(int size);
+	inline int idleCount(void) const { return sleepers; }
 
 	// commands
 	void start(void);
@@ -64,18 +88,33 @@ public:
 
 private:
 	void init(void);
-	virtual void run(void);
+	void park(t::uint32 e);
+	void wake(bool all);
+	bool waitRound(t::uint32& r);
+	void endRound(void);
+	void release(void);
 	JobProducer *prod;
 	Mutex *mutex;
-	int cnt;
+	int cnt, batch;
+	JobWorker **workers;
 	Thread **thds;
-	enum {
+	std::atomic<int> active;
+	std::atomic<bool> exhausted;
+	typedef enum {
 		WAIT = 0,
 		RUN = 1,
 		STOP = 2,
 		EXN = 3
-	} state;
+	} state_t;
+	std::atomic<state_t> state;
 	string err;
+	std::atomic<t::uint32> epoch;
+	std::atomic<int> sleepers;
+	std::mutex idle;
+	std::condition_variable wakeup, rounds, finished;
+	t::uint32 round;
+	int running;
+	bool quit;
 };
 
 } }	// elm::sys
@@ -0,0 +1,172 @@
+/*
+ *	lock classes interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_SYS_LOCK_H_
+#define ELM_SYS_LOCK_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <elm/sys/Thread.h>
+
+namespace elm { namespace sys {
+
+class SpinLock {
+	static const int spins = 64;
+public:
+	inline SpinLock(void): l(false) { }
+	inline bool tryLock(void)
+		{ return !l.load(std::memory_order_relaxed) && !l.exchange(true, std::memory_order_acquire); }
+	inline void lock(void) { if(!tryLock()) wait(); }
+	inline void unlock(void) { l.store(false, std::memory_order_release); }
+private:
+	SpinLock(const SpinLock&);
+	SpinLock& operator=(const SpinLock&);
+	void wait(void) {
+		for(int i = 0; true; i++) {
+			if(i >= spins)
+				Thread::yield();
+			if(tryLock())
+				return;
+		}
+	}
+	std::atomic<bool> l;
+};
+
+class ReadWriteLock {
+	static const int spins = 64, writer = -1;
+public:
+	inline ReadWriteLock(void): s(0), w(0) { }
+
+	inline bool tryLockRead(void) {
+		int n = s.load(std::memory_order_relaxed);
+		return n >= 0 && w.load(std::memory_order_relaxed) == 0
+			&& s.compare_exchange_weak(n, n + 1, std::memory_order_acquire, std::memory_order_relaxed);
+	}
+	inline void lockRead(void) { if(!tryLockRead()) waitRead(); }
+	inline void unlockRead(void) { s.fetch_sub(1, std::memory_order_release); }
+
+	inline bool tryLockWrite(void) {
+		int n = 0;
+		return s.compare_exchange_strong(n, writer, std::memory_order_acquire, std::memory_order_relaxed);
+	}
+	inline void lockWrite(void) { if(!tryLockWrite()) waitWrite(); }
+	inline void unlockWrite(void) { s.store(0, std::memory_order_release); }
+
+	inline void lock(void) { lockWrite(); }
+	inline void unlock(void) { unlockWrite(); }
+	inline bool tryLock(void) { return tryLockWrite(); }
+
+private:
+	ReadWriteLock(const ReadWriteLock&);
+	ReadWriteLock& operator=(const ReadWriteLock&);
+	void waitRead(void) {
+		for(int i = 0; !tryLockRead(); i++)
+			if(i >= spins)
+				Thread::yield();
+	}
+	void waitWrite(void) {
+		w++;
+		for(int i = 0; !tryLockWrite(); i++)
+			if(i >= spins)
+				Thread::yield();
+		w--;
+	}
+	std::atomic<int> s, w;
+};
+
+class Condition {
+public:
+	inline Condition(void) { }
+	template <class L> inline void wait(L& lock) { c.wait(lock); }
+	template <class L, class P> inline void wait(L& lock, P pred) { c.wait(lock, pred); }
+	inline void notify(void) { c.notify_one(); }
+	inline void notifyAll(void) { c.notify_all(); }
+private:
+	Condition(const Condition&);
+	Condition& operator=(const Condition&);
+	std::condition_variable_any c;
+};
+
+class Semaphore {
+public:
+	inline Semaphore(int count = 0): n(count), w(0) { }
+	inline int count(void) const { return n.load(std::memory_order_relaxed); }
+
+	inline bool tryAcquire(void) {
+		int k = n.load();
+		while(k > 0)
+			if(n.compare_exchange_weak(k, k - 1, std::memory_order_acquire, std::memory_order_relaxed))
+				return true;
+		return false;
+	}
+
+	void acquire(void) {
+		if(tryAcquire())
+			return;
+		std::unique_lock<std::mutex> g(m);
+		w++;
+		c.wait(g, [this]() { return tryAcquire(); });
+		w--;
+	}
+
+	void release(int k = 1) {
+		n.fetch_add(k);
+		if(w.load() > 0) {
+			std::lock_guard<std::mutex> g(m);
+			if(k == 1)
+				c.notify_one();
+			else
+				c.notify_all();
+		}
+	}
+
+private:
+	Semaphore(const Semaphore&);
+	Semaphore& operator=(const Semaphore&);
+	std::atomic<int> n, w;
+	std::mutex m;
+	std::condition_variable c;
+};
+
+template <class L>
+class LockGuard {
+public:
+	inline LockGuard(L& lock): l(lock) { l.lock(); }
+	inline ~LockGuard(void) { l.unlock(); }
+private:
+	LockGuard(const LockGuard&);
+	LockGuard& operator=(const LockGuard&);
+	L& l;
+};
+
+class ReadGuard {
+public:
+	inline ReadGuard(ReadWriteLock& lock): l(lock) { l.lockRead(); }
+	inline ~ReadGuard(void) { l.unlockRead(); }
+private:
+	ReadGuard(const ReadGuard&);
+	ReadGuard& operator=(const ReadGuard&);
+	ReadWriteLock& l;
+};
+
+} }	// elm::sys
+
+#endif /* ELM_SYS_LOCK_H_ */
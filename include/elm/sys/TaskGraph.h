@@ -0,0 +1,56 @@
+/*
+ *	TaskGraph class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_SYS_TASKGRAPH_H_
+#define ELM_SYS_TASKGRAPH_H_
+
+#include <atomic>
+#include <functional>
+#include <elm/data/Vector.h>
+#include <elm/sys/Lock.h>
+
+namespace elm { namespace sys {
+
+class TaskNode;
+
+class TaskGraph {
+	friend class TaskNode;
+public:
+	typedef int task_t;
+
+	TaskGraph(void);
+	~TaskGraph(void);
+
+	task_t add(const std::function<void(void)>& f);
+	void precede(task_t before, task_t after);
+	inline int count(void) const { return tasks.length(); }
+	void run(int threads = 0);
+
+private:
+	void fail(const string& message);
+	Vector<TaskNode *> tasks;
+	SpinLock lock;
+	string err;
+	std::atomic<bool> failed;
+};
+
+} }	// elm::sys
+
+#endif /* ELM_SYS_TASKGRAPH_H_ */
@@ -67,6 +67,7 @@ public:
 	static Thread *make(Runnable& runnable);
 	static Thread *current(void);
 	static void setRootRunnable(Runnable& runnable);
+	static void yield(void);
 
 	virtual void start(void) = 0;
 	virtual void join(void) = 0;
@@ -0,0 +1,187 @@
+/*
+ *	parallel iteration interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2015, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_SYS_PARALLEL_H_
+#define ELM_SYS_PARALLEL_H_
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <elm/data/Vector.h>
+#include <elm/sys/JobScheduler.h>
+
+namespace elm { namespace parallel {
+
+namespace impl {
+
+inline int grain(int n, int g) { return g > 0 ? g : n / 256 + 1; }
+bool schedule(sys::JobProducer& prod, int threads);
+
+class Failure {
+public:
+	inline Failure(void): _failed(false) { }
+	inline bool failed(void) const { return _failed; }
+	void record(void);
+	void rethrow(void);
+private:
+	std::atomic<bool> _failed;
+	std::mutex _mutex;
+	std::exception_ptr _exn;
+};
+
+template <class I, class W>
+class ChunkJob: public sys::Job {
+public:
+	inline ChunkJob(W& work, Failure& fail, int index, const I& start, int count)
+		: _work(work), _fail(fail), _index(index), _start(start), _count(count) { }
+	virtual void run(void) {
+		if(_fail.failed())
+			return;
+		try {
+			_work(_index, _start, _count);
+		}
+		catch(...) {
+			_fail.record();
+		}
+	}
+private:
+	W& _work;
+	Failure& _fail;
+	int _index;
+	I _start;
+	int _count;
+};
+
+template <class I, class W>
+class ChunkProducer: public sys::JobProducer {
+public:
+	inline ChunkProducer(W& work, const I& begin, const I& end, int grain)
+		: _work(work), _i(begin), _end(end), _grain(grain), _index(0) { }
+	virtual sys::Job *next(void) {
+		if(_fail.failed() || !(_i != _end))
+			return nullptr;
+		I start = _i;
+		int n = 0;
+		for(; n < _grain && _i != _end; n++)
+			++_i;
+		return new ChunkJob<I, W>(_work, _fail, _index++, start, n);
+	}
+	virtual void harvest(sys::Job *job) { delete job; }
+	inline void rethrow(void) { _fail.rethrow(); }
+private:
+	W& _work;
+	Failure _fail;
+	I _i, _end;
+	int _grain, _index;
+};
+
+template <class C, class W>
+void split(const C& c, W& work, int grain, int threads) {
+	typedef decltype(c.begin()) iter_t;
+	int n = c.count();
+	ChunkProducer<iter_t, W> prod(work, c.begin(), c.end(), grain);
+	if(n > grain && threads != 1 && schedule(prod, threads))
+		prod.rethrow();
+	else {
+		int k = 0;
+		for(iter_t i = c.begin(), e = c.end(); i != e; k++) {
+			iter_t s = i;
+			int m = 0;
+			for(; m < grain && i != e; m++)
+				++i;
+			work(k, s, m);
+		}
+	}
+}
+
+template <class F>
+class ForEachWork {
+public:
+	inline ForEachWork(F& f): _f(f) { }
+	template <class I> void operator()(int, I i, int n)
+		{ for(; n > 0; n--, ++i) _f(*i); }
+private:
+	F& _f;
+};
+
+template <class R, class F>
+class MapWork {
+public:
+	inline MapWork(Vector<R>& r, F& f, int grain): _r(r), _f(f), _grain(grain) { }
+	template <class I> void operator()(int k, I i, int n)
+		{ for(int j = k * _grain; n > 0; n--, j++, ++i) _r[j] = _f(*i); }
+private:
+	Vector<R>& _r;
+	F& _f;
+	int _grain;
+};
+
+template <class T, class F>
+class ReduceWork {
+public:
+	inline ReduceWork(Vector<T>& r, const T& zero, F& f): _r(r), _zero(zero), _f(f) { }
+	template <class I> void operator()(int k, I i, int n)
+		{ T a = _zero; for(; n > 0; n--, ++i) a = _f(a, *i); _r[k] = a; }
+private:
+	Vector<T>& _r;
+	const T& _zero;
+	F& _f;
+};
+
+}	// impl
+
+template <class C, class F>
+void forEach(const C& c, F f, int grain = 0, int threads = 0) {
+	impl::ForEachWork<F> w(f);
+	impl::split(c, w, impl::grain(c.count(), grain), threads);
+}
+
+template <class C, class F>
+auto map(const C& c, F f, int grain = 0, int threads = 0) -> Vector<decltype(f(*c.begin()))> {
+	typedef decltype(f(*c.begin())) res_t;
+	Vector<res_t> r;
+	r.setLength(c.count());
+	int g = impl::grain(c.count(), grain);
+	impl::MapWork<res_t, F> w(r, f, g);
+	impl::split(c, w, g, threads);
+	return r;
+}
+
+template <class C, class T, class F, class G>
+T fold(const C& c, const T& zero, F f, G combine, int grain = 0, int threads = 0) {
+	int g = impl::grain(c.count(), grain);
+	int m = (c.count() + g - 1) / g;
+	Vector<T> r;
+	r.setLength(m);
+	impl::ReduceWork<T, F> w(r, zero, f);
+	impl::split(c, w, g, threads);
+	T a = zero;
+	for(const auto& x: r)
+		a = combine(a, x);
+	return a;
+}
+
+template <class C, class T, class F>
+inline T reduce(const C& c, const T& zero, F f, int grain = 0, int threads = 0)
+	{ return fold(c, zero, f, f, grain, threads); }
+
+} }	// elm::parallel
+
+#endif /* ELM_SYS_PARALLEL_H_ */
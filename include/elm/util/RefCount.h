@@ -0,0 +1,52 @@
+/*
+ *	RefCount classes interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_UTIL_REFCOUNT_H_
+#define ELM_UTIL_REFCOUNT_H_
+
+#include <elm/arch.h>
+
+namespace elm {
+
+template <class T>
+class PlainCount {
+public:
+	static inline void incr(T& c) { c++; }
+	static inline bool decr(T& c) { return --c == 0; }
+	static inline T get(const T& c) { return c; }
+};
+
+template <class T>
+class AtomicCount {
+public:
+	static inline void incr(T& c) { __atomic_fetch_add(&c, 1, __ATOMIC_RELAXED); }
+	static inline bool decr(T& c) { return __atomic_sub_fetch(&c, 1, __ATOMIC_ACQ_REL) == 0; }
+	static inline T get(const T& c) { return __atomic_load_n(&c, __ATOMIC_ACQUIRE); }
+};
+
+#if ELM_ARCH_ATOMIC_REF
+	template <class T> using RefCount = AtomicCount<T>;
+#else
+	template <class T> using RefCount = PlainCount<T>;
+#endif
+
+}	// elm
+
+#endif /* ELM_UTIL_REFCOUNT_H_ */
@@ -23,10 +23,11 @@
 
 #include <elm/io.h>
 #include <elm/types.h>
+#include <elm/util/RefCount.h>
 
 namespace elm {
 
-template <class T>
+template <class T, class C = RefCount<t::uint32> >
 class SharedPtr {
 	typedef struct cell_t {
 		inline cell_t(T *p): cnt(1), ptr(p) { }
@@ -37,7 +38,7 @@ class SharedPtr {
 public:
 	inline SharedPtr(void): c(&null) { lock(); }
 	inline SharedPtr(T *p): c(new cell_t(p)) { }
-	inline SharedPtr(const SharedPtr<T>& p): c(p.c) { lock(); }
+	inline SharedPtr(const SharedPtr<T, C>& p): c(p.c) { lock(); }
 	inline ~SharedPtr(void) { unlock(); }
 	inline bool isEmpty(void) const { return c->ptr; }
 	inline T *ptr(void) const { return c->ptr; }
@@ -48,24 +49,26 @@ public:
 	inline T *operator->(void) const { return ptr(); }
 	inline T& operator*(void) const { return ref(); }
 	inline T *operator&(void) const { return ptr(); }
-	inline SharedPtr<T>& operator=(const SharedPtr<T>& p) { unlock(); c = p.c; lock(); return *this; }
-	inline SharedPtr<T>& operator=(T *p) { unlock(); c = new cell_t(p); return *this; }
+	inline SharedPtr<T, C>& operator=(const SharedPtr<T, C>& p) { unlock(); c = p.c; lock(); return *this; }
+	inline SharedPtr<T, C>& operator=(T *p) { unlock(); c = new cell_t(p); return *this; }
 
-	inline bool operator==(const SharedPtr<T>& p) const { return c->ptr == p.c->ptr; }
-	inline bool operator!=(const SharedPtr<T>& p) const { return c->ptr != p.c->ptr; }
+	inline bool operator==(const SharedPtr<T, C>& p) const { return c->ptr == p.c->ptr; }
+	inline bool operator!=(const SharedPtr<T, C>& p) const { return c->ptr != p.c->ptr; }
 	inline bool operator==(T *p) const { return c->ptr == p; }
 	inline bool operator!=(T *p) const { return c->ptr != p; }
 
 private:
-	inline void lock(void) { c->cnt++; }
-	inline void unlock(void) { c->cnt--; if(c->cnt == 0) clear(); }
+	inline void lock(void) { C::incr(c->cnt); }
+	inline void unlock(void) { if(C::decr(c->cnt)) clear(); }
 	void clear(void) { if(c->ptr) delete c->ptr; delete c; }
 
 	cell_t *c;
 	static cell_t null;
 };
 
-template <class T> typename SharedPtr<T>::cell_t SharedPtr<T>::null(0);
+template <class T, class C> typename SharedPtr<T, C>::cell_t SharedPtr<T, C>::null(0);
+
+template <class T> using AtomicSharedPtr = SharedPtr<T, AtomicCount<t::uint32> >;
 
 }	// elm
 
@@ -71,9 +71,9 @@ namespace variant {
 	template <> struct access_t<double>	   	{ typedef double    rt; static double    get(const data_t& d) { return d.d;   } static void set(data_t& d, double    x) { d.d   = x; } };
 
 	template <> struct access_t<cstring> 		{ typedef cstring rt; static cstring get(const data_t& d) { return static_cast<const char *>(d.cp); } static void set(data_t& d, cstring x) { d.cp = x.chars(); } };
-	template <> struct access_t<string> 		{ typedef string  rt; static string get(const data_t& d)  { return static_cast<const char *>(d.cp); } static void set(data_t& d, string x)	 { d.cp = x.toCString().chars(); } };
+	template <> struct access_t<string> 		{ typedef string  rt; static string get(const data_t& d)  { return static_cast<const char *>(d.cp); } static void set(data_t& d, const string& x) { d.cp = x.toCString().chars(); } };
 	template <> struct access_t<const cstring&> { typedef cstring rt; static cstring get(const data_t& d) { return static_cast<const char *>(d.cp); } static void set(data_t& d, cstring x) { d.cp = x.chars(); } };
-	template <> struct access_t<const string&>	{ typedef string  rt; static string get(const data_t& d)  { return static_cast<const char *>(d.cp); } static void set(data_t& d, string x)	 { d.cp = x.toCString().chars(); } };
+	template <> struct access_t<const string&>	{ typedef string  rt; static string get(const data_t& d)  { return static_cast<const char *>(d.cp); } static void set(data_t& d, const string& x) { d.cp = x.toCString().chars(); } };
 
 	template <class T> struct access_t<T *> {
 		typedef T *rt;
@@ -91,12 +91,19 @@ namespace variant {
 
 class Variant {
 public:
-	inline Variant() { }
-	template <class T> Variant(const T& x) { variant::access_t<T>::set(_data, x); }
+	inline Variant(): _own(false) { }
+	template <class T> Variant(const T& x): _own(false) { variant::access_t<T>::set(_data, x); }
+	inline Variant(const string& s): _own(false) { own(s); }
+	inline Variant(const Variant& v): _data(v._data), _own(false) { if(v._own) own(v._str); }
+	inline Variant& operator=(const Variant& v)
+		{ if(this != &v) { _data = v._data; _own = false; _str = string(); if(v._own) own(v._str); } return *this; }
 	inline void *asPointer(void) const { return _data.p; }
 	template <class T> typename variant::access_t<T>::rt as() const { return variant::access_t<T>::get(_data); }
 private:
+	inline void own(const string& s) { _str = s; _own = true; _data.cp = _str.toCString().chars(); }
 	variant::data_t _data;
+	string _str;
+	bool _own;
 };
 
 }	// elm
@@ -38,6 +38,7 @@ public:
 	//Attribute(String name, String URI, String value, Attribute.Type type)
 
 	String getLocalName(void) const;
+	Symbol getLocalSymbol(void) const;
 	String getNamespacePrefix(void) const;
 	String getNamespaceURI(void) const;
 	String getQualifiedName(void) const;
@@ -62,6 +63,7 @@ private:
 	friend class Node;
 	Attribute(void *node);
 	mutable String ns, name;
+	mutable Symbol sym;
 	elm::string val;
 };
 
@@ -46,6 +46,7 @@ public:
 	virtual Element	*getFirstChildElement(String name);
 	virtual Element	*getFirstChildElement(String localName, String ns);
 	virtual String getLocalName(void);
+	virtual Symbol getLocalSymbol(void);
 	virtual int	getNamespaceDeclarationCount(void);
 	virtual String getNamespacePrefix(void);
 	virtual String getNamespacePrefix(int index);
@@ -64,6 +65,8 @@ public:
 	virtual void setNamespaceURI(String uri);
 	virtual String toString(void);
 	virtual String toXML(void);
+private:
+	Symbol sym;
 };
 
 } } // elm::xom
@@ -22,6 +22,7 @@
 #ifndef ELM_XOM_NODE_H
 #define ELM_XOM_NODE_H
 
+#include <elm/string/Symbol.h>
 #include <elm/xom/String.h>
 
 namespace elm { namespace xom {
@@ -0,0 +1,64 @@
+/*
+ *	performance measurement helpers
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef ELM_PERF_BENCH_H_
+#define ELM_PERF_BENCH_H_
+
+#include <time.h>
+#include <elm/io.h>
+
+namespace elm {
+
+// wall-clock time in ns (sys::StopWatch measures the CPU time of the thread
+// with a too coarse resolution for short or multi-threaded measures)
+inline t::int64 now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return t::int64(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// measure the time taken by f in ns
+template <class F>
+t::int64 measure(F f) {
+	t::int64 start = now();
+	f();
+	return now() - start;
+}
+
+// display a measure in ns for n operations
+inline void report(const string& name, t::int64 t, long n) {
+	double ns = n == 0 ? 0 : double(t) / n;
+	cout << io::fmt(name).width(40)
+		 << io::fmt(double(t) / 1000000).decimal().width(10, 2).right() << " ms "
+		 << io::fmt(ns).decimal().width(10, 2).right() << " ns/op\n";
+}
+
+// parse the size argument
+inline long size_arg(int argc, char **argv, long def) {
+	if(argc <= 1)
+		return def;
+	long n = 0;
+	string(argv[1]) >> n;
+	return n > 0 ? n : def;
+}
+
+}	// elm
+
+#endif /* ELM_PERF_BENCH_H_ */
@@ -0,0 +1,52 @@
+/*
+ *	formatted output performance measurement
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/io/BlockOutStream.h>
+#include "bench.h"
+
+using namespace elm;
+
+int main(int argc, char **argv) {
+	long n = size_arg(argc, argv, 1000000);
+	cout << "format " << n << " lines\n";
+
+	io::BlockOutStream block;
+	io::Output out(block);
+	report("Output::format() (printf)", measure([&]() {
+		for(long i = 0; i < n; i++) {
+			out.format("%s at %08lx: %ld\n", "main", i * 4, i);
+			block.clear();
+		}
+	}), n);
+	report("operator <<", measure([&]() {
+		for(long i = 0; i < n; i++) {
+			out << "main" << " at " << io::fmt(i * 4).hex().right().width(8).pad('0') << ": " << i << '\n';
+			block.clear();
+		}
+	}), n);
+	report("ELM_FORMAT", measure([&]() {
+		for(long i = 0; i < n; i++) {
+			ELM_FORMAT(out, "{} at {:08x}: {}\n", "main", i * 4, i);
+			block.clear();
+		}
+	}), n);
+	return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ *	hash table performance measurement
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/FlatHashMap.h>
+#include <elm/data/HashMap.h>
+#include <elm/data/Vector.h>
+#include "bench.h"
+
+using namespace elm;
+
+template <class M, class K>
+void bench(cstring name, const Vector<K>& keys, const Vector<K>& misses) {
+	long sum = 0;
+	M map;
+	cout << name << io::endl;
+	report("put", measure([&]() {
+		for(int i = 0; i < keys.length(); i++)
+			map.put(keys[i], i);
+	}), keys.length());
+	report("get (hit)", measure([&]() {
+		for(int i = 0; i < keys.length(); i++)
+			sum += map.get(keys[i], 0);
+	}), keys.length());
+	report("get (miss)", measure([&]() {
+		for(int i = 0; i < misses.length(); i++)
+			sum += map.get(misses[i], 0);
+	}), misses.length());
+	report("iterate", measure([&]() {
+		for(auto x: map)
+			sum += x;
+	}), map.count());
+	report("remove", measure([&]() {
+		for(int i = 0; i < keys.length(); i++)
+			map.remove(keys[i]);
+	}), keys.length());
+	if(sum == 0)
+		cout << "unexpected null sum\n";
+}
+
+// shuffle the vector to avoid measuring a favorable access order
+template <class T>
+void shuffle(Vector<T>& v) {
+	t::uint32 r = 12345;
+	for(int i = v.length() - 1; i > 0; i--) {
+		r = r * 1103515245 + 12345;
+		swap(v[i], v[(r >> 8) % (i + 1)]);
+	}
+}
+
+int main(int argc, char **argv) {
+	long n = size_arg(argc, argv, 1000000);
+
+	Vector<int> ikeys, imisses;
+	for(int i = 0; i < n; i++) {
+		ikeys.add(i * 7);
+		imisses.add(i * 7 + 3);
+	}
+	shuffle(ikeys);
+	shuffle(imisses);
+	bench<HashMap<int, int> >("HashMap<int, int>", ikeys, imisses);
+	bench<FlatHashMap<int, int> >("FlatHashMap<int, int>", ikeys, imisses);
+
+	Vector<string> skeys, smisses;
+	for(int i = 0; i < n; i++) {
+		skeys.add(_ << "id_" << i);
+		smisses.add(_ << "xd_" << i);
+	}
+	shuffle(skeys);
+	shuffle(smisses);
+	bench<HashMap<string, int> >("HashMap<string, int>", skeys, smisses);
+	bench<FlatHashMap<string, int> >("FlatHashMap<string, int>", skeys, smisses);
+
+	return 0;
+}
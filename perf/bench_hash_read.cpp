@@ -0,0 +1,114 @@
+/*
+ *	concurrent hash table read performance measurement
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/HashMap.h>
+#include <elm/data/Vector.h>
+#include <elm/sys/System.h>
+#include <elm/sys/Thread.h>
+#include "bench.h"
+
+using namespace elm;
+
+typedef HashMap<int, int> map_t;
+
+class Reader: public sys::Runnable {
+public:
+	Reader(const map_t& map, int n, int seed): _map(map), _n(n), _seed(seed), sum(0) { }
+	void run() override {
+		t::uint32 r = _seed;
+		int size = _map.count();
+		for(int i = 0; i < _n; i++) {
+			r = r * 1103515245 + 12345;
+			sum += _map.get((r >> 8) % size, 0);
+		}
+	}
+private:
+	const map_t& _map;
+	int _n, _seed;
+public:
+	long sum;
+};
+
+// perform n look-ups in each of t threads
+t::int64 run(const map_t& map, int t, int n) {
+	Vector<Reader *> readers;
+	Vector<sys::Thread *> threads;
+	for(int i = 0; i < t; i++) {
+		readers.add(new Reader(map, n, i + 1));
+		threads.add(sys::Thread::make(*readers[i]));
+	}
+	t::int64 time = measure([&]() {
+		for(auto t: threads)
+			t->start();
+		for(auto t: threads)
+			t->join();
+	});
+	long sum = 0;
+	for(int i = 0; i < t; i++) {
+		sum += readers[i]->sum;
+		delete threads[i];
+		delete readers[i];
+	}
+	if(sum == 0)
+		cout << "unexpected null sum\n";
+	return time;
+}
+
+int main(int argc, char **argv) {
+	long n = size_arg(argc, argv, 1000000);
+	int cores = sys::System::coreCount();
+	if(argc > 2)
+		string(argv[2]) >> cores;
+
+	map_t map;
+	for(int i = 0; i < n; i++)
+		map.put(i, i + 1);
+
+	cout << "single thread\n";
+	report("get", measure([&]() {
+		long sum = 0;
+		for(int i = 0; i < n; i++)
+			sum += map.get(i, 0);
+		if(sum == 0)
+			cout << "unexpected null sum\n";
+	}), n);
+	map.setAdaptive(true);
+	report("get (adaptive)", measure([&]() {
+		long sum = 0;
+		for(int i = 0; i < n; i++)
+			sum += map.get(i, 0);
+		if(sum == 0)
+			cout << "unexpected null sum\n";
+	}), n);
+	map.setAdaptive(false);
+
+	cout << "concurrent reads (" << cores << " cores)\n";
+	t::int64 base = 0;
+	for(int t = 1; t <= cores; t = t * 2 <= cores || t == cores ? t * 2 : cores) {
+		t::int64 time = run(map, t, n);
+		if(t == 1)
+			base = time;
+		report(_ << t << " thread(s)", time, long(n) * t);
+		cout << io::fmt("").width(40) << "speedup "
+			 << io::fmt(double(base) * t / time).decimal().width(5, 2) << io::endl;
+	}
+	return 0;
+}
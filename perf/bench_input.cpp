@@ -0,0 +1,89 @@
+/*
+ *	numeric input benchmark
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <stdlib.h>
+#include <elm/io/BlockInStream.h>
+#include <elm/io/BufferedInStream.h>
+#include <elm/io/Input.h>
+#include <elm/string/StringBuffer.h>
+#include "bench.h"
+
+using namespace elm;
+
+// stream without window: Input reads it character per character
+// as it did for every stream before
+class CharInStream: public io::InStream {
+public:
+	CharInStream(io::InStream& in): _in(in) { }
+	int read(void *buffer, int size) override { return _in.read(buffer, size); }
+	int read(void) override { return _in.read(); }
+private:
+	io::InStream& _in;
+};
+
+int main(int argc, char **argv) {
+	long n = size_arg(argc, argv, 1000000);
+
+	// build the numeric file: one integer and one double per line
+	StringBuffer sbuf;
+	t::uint64 bits = 0x123456789abcdefULL;
+	for(long i = 0; i < n; i++) {
+		bits = bits * 6364136223846793005ULL + 1442695040888963407ULL;
+		sbuf << t::int64(bits >> 20) - (t::int64(1) << 43) << ' '
+			 << double(bits >> 11) / double(t::uint64(1) << 40) << '\n';
+	}
+	string text = sbuf.toString();
+	cout << "scan " << n << " lines (" << text.length() << " bytes)\n";
+
+	volatile double r = 0;
+	auto scan = [&](io::InStream& s) {
+		io::Input in(s);
+		for(long i = 0; i < n; i++) {
+			r += in.scanLLong();
+			r += in.scanDouble();
+		}
+		if(in.failed())
+			cerr << "ERROR: scan failed\n";
+	};
+	report("Input, character path (previous)", measure([&]() {
+		io::BlockInStream block(text);
+		CharInStream chars(block);
+		scan(chars);
+	}), n);
+	report("Input, BufferedInStream", measure([&]() {
+		io::BlockInStream block(text);
+		CharInStream chars(block);
+		io::BufferedInStream buf(chars);
+		scan(buf);
+	}), n);
+	report("Input, BlockInStream", measure([&]() {
+		io::BlockInStream block(text);
+		scan(block);
+	}), n);
+	report("strtoll() + strtod()", measure([&]() {
+		char *p = const_cast<char *>(text.chars());
+		for(long i = 0; i < n; i++) {
+			r += strtoll(p, &p, 10);
+			r += strtod(p, &p);
+		}
+	}), n);
+	return 0;
+}
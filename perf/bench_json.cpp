@@ -0,0 +1,242 @@
+/*
+ *	JSON parsing benchmark
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/HashMap.h>
+#include <elm/data/Vector.h>
+#include <elm/io/BlockInStream.h>
+#include <elm/json.h>
+#include <elm/json/Indexer.h>
+#include <elm/string/StringBuffer.h>
+#include "bench.h"
+
+using namespace elm;
+
+// maker counting the events
+class CountMaker: public json::Maker {
+public:
+	long n = 0;
+	void beginObject(void) override { n++; }
+	void beginArray(void) override { n++; }
+	void onField(string name) override { n += name.length(); }
+	void onNull(void) override { n++; }
+	void onValue(bool value) override { n++; }
+	void onValue(int value) override { n++; }
+	void onValue(double value) override { n++; }
+	void onValue(string value) override { n += value.length(); }
+};
+
+// maker building a hash map of strings per object, as done by hand
+class MapMaker: public json::Maker {
+public:
+	~MapMaker(void) { clear(); }
+	void clear(void) { for(auto m: maps) delete m; maps.clear(); }
+	void beginObject(void) override { stack.push(new HashMap<String, String>()); }
+	void endObject(void) override { maps.add(stack.pop()); }
+	void beginArray(void) override { }
+	void endArray(void) override { }
+	void onField(string name) override { key = name; }
+	void onNull(void) override { put("null"); }
+	void onValue(bool value) override { put(value ? "true" : "false"); }
+	void onValue(int value) override { put(_ << value); }
+	void onValue(double value) override { put(_ << value); }
+	void onValue(string value) override { put(value); }
+	Vector<HashMap<String, String> *> maps, stack;
+private:
+	void put(String value) { if(stack) stack.top()->put(key, value); }
+	String key;
+};
+
+// stream without window, as a file
+class CharInStream: public io::InStream {
+public:
+	CharInStream(io::InStream& in): _in(in) { }
+	int read(void *buffer, int size) override { return _in.read(buffer, size); }
+	int read(void) override { return _in.read(); }
+private:
+	io::InStream& _in;
+};
+
+// build a JSON trace of n events
+string make_trace(long n) {
+	StringBuffer buf;
+	t::uint64 bits = 0x123456789abcdefULL;
+	buf << "{\"version\": 1, \"events\": [\n";
+	for(long i = 0; i < n; i++) {
+		bits = bits * 6364136223846793005ULL + 1442695040888963407ULL;
+		if(i != 0)
+			buf << ",\n";
+		buf << "\t{\"id\": " << i
+			<< ", \"addr\": " << t::int32(bits >> 40)
+			<< ", \"time\": " << double(bits >> 11) / double(t::uint64(1) << 40)
+			<< ", \"name\": \"function_" << t::uint32(bits >> 50) << "\""
+			<< ", \"taken\": " << ((bits >> 3) & 1 ? "true" : "false")
+			<< ", \"path\": \"src/module_" << t::uint32(bits >> 56) << "/file.c:" << t::uint32(bits >> 52) << "\""
+			<< ", \"stack\": [" << t::uint32(bits >> 44) << ", " << t::uint32(bits >> 45) << ", null]";
+		if((i & 15) == 0)
+			buf << ", \"msg\": \"say \\\"hello\\\"\\n\\tand \\u00e9\"";
+		buf << "}";
+	}
+	buf << "\n]}\n";
+	return buf.toString();
+}
+
+// build a JSON log of n messages (long strings)
+string make_log(long n) {
+	StringBuffer buf;
+	buf << "[\n";
+	for(long i = 0; i < n; i++) {
+		if(i != 0)
+			buf << ",\n";
+		buf << "\t{\"level\": \"info\", \"text\": \"";
+		for(int j = 0; j < 8; j++)
+			buf << "cache line " << i + j << " of the loop body is always hit in the instruction cache; ";
+		buf << "\"}";
+	}
+	buf << "\n]\n";
+	return buf.toString();
+}
+
+// compare the engines on the given text
+void compare(string name, string text) {
+	cout << name << ": " << text.length() << " bytes (ns per byte)\n";
+	CountMaker maker;
+	json::Parser parser(maker);
+	parser.setEngine(json::Parser::CLASSIC);
+	report("Parser, string, classic", measure([&]() {
+		parser.parse(text);
+	}), text.length());
+	long events = maker.n;
+	maker.n = 0;
+	parser.setEngine(json::Parser::STRUCTURAL);
+	report(json::Indexer::accelerated() ? "Parser, string, structural" : "Parser, string, structural (no SIMD)",
+		measure([&]() { parser.parse(text); }), text.length());
+	if(maker.n != events)
+		cerr << "ERROR: engines disagree\n";
+	json::Indexer *indexer = new json::Indexer();
+	report("Indexer only", measure([&]() {
+		indexer->reset(text.chars(), text.length());
+		while(indexer->next())
+			maker.n += indexer->end() - indexer->begin();
+	}), text.length());
+	delete indexer;
+	if(maker.n == 0)
+		cerr << "ERROR: no event\n";
+}
+
+// write a document value with a saver (JSON, CBOR or MessagePack)
+template <class S>
+void emit(S& save, const json::Value& v) {
+	switch(v.type()) {
+	case json::Value::NULL_VALUE:	save.put(); break;
+	case json::Value::BOOLEAN:		save.write(v.asBool()); break;
+	case json::Value::INTEGER:		save.write(v.asInt()); break;
+	case json::Value::FLOAT:		save.write(v.asFloat()); break;
+	case json::Value::STRING:		save.write(v.asString()); break;
+	case json::Value::ARRAY:
+		save.beginList();
+		for(int i = 0; i < v.count(); i++)
+			emit(save, v[i]);
+		save.endList();
+		break;
+	case json::Value::OBJECT:
+		save.beginMap();
+		for(int i = 0; i < v.count(); i++) {
+			save.key(v.key(i));
+			emit(save, v[i]);
+		}
+		save.endMap();
+		break;
+	}
+}
+
+// encode a document in a format and decode it
+template <class S, class P>
+void format(string name, const json::Document& doc, long events) {
+	string data;
+	auto encode = [&]() {
+		StringBuffer buf;
+		S save(buf);
+		emit(save, doc.root());
+		save.close();
+		data = buf.toString();
+	};
+	encode();
+	cout << name << ": " << data.length() << " bytes (ns per byte)\n";
+	report(_ << name << ", encode", measure(encode), data.length());
+	CountMaker maker;
+	P parser(maker);
+	report(_ << name << ", decode", measure([&]() {
+		maker.n = 0;
+		parser.parse(data);
+	}), data.length());
+	if(maker.n != events)
+		cerr << "ERROR: " << name << " events differ\n";
+}
+
+int main(int argc, char **argv) {
+	long n = size_arg(argc, argv, 200000);
+	string text = make_trace(n);
+	compare("trace", text);
+	compare("log", make_log(n / 4));
+
+	MapMaker map_maker;
+	json::Parser map_parser(map_maker);
+	report("HashMap maker", measure([&]() {
+		map_maker.clear();
+		map_parser.parse(text);
+	}), text.length());
+	json::Document doc;
+	t::int64 id = 0;
+	report("Document, one field", measure([&]() {
+		doc.parse(text);
+		id = doc.root()["events"][int(n / 2)]["id"].asInt();
+	}), text.length());
+	doc.setLazy(true);
+	report("Document, lazy, one field", measure([&]() {
+		doc.parse(text);
+		if(doc.root()["events"][int(n / 2)]["id"].asInt() != id)
+			cerr << "ERROR: documents disagree\n";
+	}), text.length());
+
+	doc.setLazy(false);
+	doc.parse(text);
+	CountMaker count;
+	json::Parser count_parser(count);
+	count_parser.parse(text);
+	format<json::Saver, json::Parser>("JSON", doc, count.n);
+	format<json::CBORSaver, json::CBORParser>("CBOR", doc, count.n);
+	format<json::MessagePackSaver, json::MessagePackParser>("MessagePack", doc, count.n);
+	string log = _ << "{\"log\": " << make_log(n / 4) << "}";
+	doc.parse(log);
+	count.n = 0;
+	count_parser.parse(log);
+	format<json::Saver, json::Parser>("JSON (log)", doc, count.n);
+
+	CountMaker maker;
+	json::Parser parser(maker);
+	parser.setReadAhead(true);
+	report("Parser, unbuffered stream", measure([&]() {
+		io::BlockInStream block(text);
+		CharInStream chars(block);
+		parser.parse(chars);
+	}), text.length());
+	return 0;
+}
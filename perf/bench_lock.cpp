@@ -0,0 +1,119 @@
+/*
+ *	lock performance measurement
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/Vector.h>
+#include <elm/sys/Lock.h>
+#include <elm/sys/System.h>
+#include "bench.h"
+
+using namespace elm;
+
+template <class L> inline void lock(L& l) { l.lock(); }
+template <class L> inline void unlock(L& l) { l.unlock(); }
+inline void lock(sys::Mutex *m) { m->lock(); }
+inline void unlock(sys::Mutex *m) { m->unlock(); }
+
+struct ReadLock {
+	inline void lock() { l.lockRead(); }
+	inline void unlock() { l.unlockRead(); }
+	sys::ReadWriteLock l;
+};
+
+struct SemLock {
+	inline SemLock(): s(1) { }
+	inline void lock() { s.acquire(); }
+	inline void unlock() { s.release(); }
+	sys::Semaphore s;
+};
+
+template <class L>
+class Locker: public sys::Runnable {
+public:
+	Locker(L& l, long n, volatile long& c): _l(l), _n(n), _c(c) { }
+	void run() override {
+		for(long i = 0; i < _n; i++) {
+			lock(_l);
+			_c++;
+			unlock(_l);
+		}
+	}
+private:
+	L& _l;
+	long _n;
+	volatile long& _c;
+};
+
+// lock/unlock n times in each of nt threads
+template <class L>
+void bench_threads(cstring name, L& l, int nt, long n) {
+	volatile long c = 0;
+	Vector<Locker<L> *> lockers;
+	Vector<sys::Thread *> threads;
+	for(int i = 0; i < nt; i++) {
+		lockers.add(new Locker<L>(l, n, c));
+		threads.add(sys::Thread::make(*lockers[i]));
+	}
+	t::int64 time = measure([&]() {
+		if(nt == 1)
+			lockers[0]->run();
+		else {
+			for(auto th: threads)
+				th->start();
+			for(auto th: threads)
+				th->join();
+		}
+	});
+	for(int i = 0; i < nt; i++) {
+		delete threads[i];
+		delete lockers[i];
+	}
+	if(c != nt * n)
+		cout << "ERROR: bad count\n";
+	report(_ << name << " (" << nt << " thread" << (nt > 1 ? "s" : "") << ")", time, nt * n);
+}
+
+template <class L>
+void bench(cstring name, L& l, int cores, long n) {
+	bench_threads(name, l, 1, n);
+	if(cores > 1)
+		bench_threads(name, l, cores, n / cores);
+}
+
+int main(int argc, char **argv) {
+	long n = size_arg(argc, argv, 10000000);
+	int cores = sys::System::coreCount();
+	if(argc > 2)
+		string(argv[2]) >> cores;
+	cout << "lock/unlock pairs, " << n << " by test\n";
+
+	sys::Mutex *mutex = sys::Mutex::make();
+	bench("Mutex", mutex, cores, n);
+	delete mutex;
+	sys::SpinLock spin;
+	bench("SpinLock", spin, cores, n);
+	sys::ReadWriteLock rw;
+	bench("ReadWriteLock (write)", rw, cores, n);
+	ReadLock rl;
+	bench("ReadWriteLock (read)", rl, cores, n);
+	SemLock sem;
+	bench("Semaphore", sem, cores, n);
+	return 0;
+}
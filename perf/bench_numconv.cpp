@@ -0,0 +1,97 @@
+/*
+ *	number to text conversion performance
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <stdio.h>
+#include <elm/io/BlockOutStream.h>
+#include <elm/io/numconv.h>
+#include "bench.h"
+
+using namespace elm;
+
+// conversion of integers used before the digit pair table
+__attribute__((noinline)) static char *horner(char *p, t::uint64 val, int base) {
+	if(!val)
+		*--p = '0';
+	else
+		while(val) {
+			int digit = val % base;
+			val /= base;
+			*--p = digit < 10 ? '0' + digit : 'a' + digit - 10;
+		}
+	return p;
+}
+
+int main(int argc, char **argv) {
+	long n = size_arg(argc, argv, 1000000);
+	cout << "convert " << n << " numbers\n";
+
+	// integers
+	volatile long r = 0;
+	char buf[64];
+	report("horner() (previous)", measure([&]() {
+		for(long i = 0; i < n; i++)
+			r += horner(buf + sizeof(buf), t::uint64(i) * 2654435761U, 10) - buf;
+	}), n);
+	report("toChars(uint64)", measure([&]() {
+		for(long i = 0; i < n; i++)
+			r += io::toChars(buf, t::uint64(i) * 2654435761U) - buf;
+	}), n);
+
+	// doubles
+	t::uint64 bits = 0x123456789abcdefULL;
+	double *xs = new double[1024];
+	for(int i = 0; i < 1024; i++) {
+		bits = bits * 6364136223846793005ULL + 1442695040888963407ULL;
+		xs[i] = double(bits >> 11) / double(t::uint64(1) << 30);
+	}
+	report("snprintf(%g) (previous)", measure([&]() {
+		for(long i = 0; i < n; i++)
+			r += snprintf(buf, sizeof(buf), "%g", xs[i & 1023]);
+	}), n);
+	report("snprintf(%.17g)", measure([&]() {
+		for(long i = 0; i < n; i++)
+			r += snprintf(buf, sizeof(buf), "%.17g", xs[i & 1023]);
+	}), n);
+	report("toChars(double)", measure([&]() {
+		for(long i = 0; i < n; i++)
+			r += io::toChars(buf, xs[i & 1023]) - buf;
+	}), n);
+
+	// through an output
+	io::BlockOutStream block;
+	io::Output out(block);
+	report("Output << int", measure([&]() {
+		for(long i = 0; i < n; i++) {
+			out << t::int32(i);
+			if((i & 1023) == 0)
+				block.clear();
+		}
+	}), n);
+	report("Output << double", measure([&]() {
+		for(long i = 0; i < n; i++) {
+			out << xs[i & 1023];
+			if((i & 1023) == 0)
+				block.clear();
+		}
+	}), n);
+	delete [] xs;
+	return 0;
+}
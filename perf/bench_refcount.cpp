@@ -0,0 +1,81 @@
+/*
+ *	reference counting performance measurement
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <atomic>
+#include <elm/util/SharedPtr.h>
+#include "bench.h"
+
+using namespace elm;
+
+// incr/decr pairs on a counter with policy C
+// (the signal fence prevents the compiler to merge the plain operations)
+template <class C>
+void bench_count(cstring name, long n) {
+	t::intptr c = 1;
+	t::int64 time = measure([&]() {
+		for(long i = 0; i < n; i++) {
+			C::incr(c);
+			std::atomic_signal_fence(std::memory_order_seq_cst);
+			C::decr(c);
+			std::atomic_signal_fence(std::memory_order_seq_cst);
+		}
+	});
+	if(c != 1)
+		cout << "ERROR: bad count\n";
+	report(name, time, n);
+}
+
+// copies of a shared pointer
+template <class P>
+void bench_ptr(cstring name, long n) {
+	P p = new int(0);
+	t::int64 time = measure([&]() {
+		for(long i = 0; i < n; i++) {
+			P q = p;
+			*q = i;
+		}
+	});
+	report(name, time, n);
+}
+
+int main(int argc, char **argv) {
+	long n = size_arg(argc, argv, 100000000);
+	cout << "single-threaded reference counting, " << n << " by test\n";
+#	ifdef ELM_ATOMIC_REF
+		cout << "configured with ELM_ATOMIC_REF\n";
+#	endif
+
+	bench_count<PlainCount<t::intptr> >("PlainCount incr/decr", n);
+	bench_count<AtomicCount<t::intptr> >("AtomicCount incr/decr", n);
+	bench_ptr<SharedPtr<int, PlainCount<t::uint32> > >("SharedPtr copy (plain)", n);
+	bench_ptr<AtomicSharedPtr<int> >("SharedPtr copy (atomic)", n);
+
+	string s = "a string long enough to be shared";
+	t::int64 time = measure([&]() {
+		for(long i = 0; i < n; i++) {
+			string c = s;
+			if(c.length() != s.length())
+				cout << "ERROR: bad copy\n";
+		}
+	});
+	report("String copy (configured)", time, n);
+	return 0;
+}
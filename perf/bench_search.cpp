@@ -0,0 +1,70 @@
+/*
+ *	string search performance measurement
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/string/Split.h>
+#include <elm/string/StringBuffer.h>
+#include "bench.h"
+
+using namespace elm;
+
+// byte loop used before the search primitives
+static int scalar_index(const string& s, char c) {
+	for(int i = 0; i < s.length(); i++)
+		if(s[i] == c)
+			return i;
+	return -1;
+}
+
+int main(int argc, char **argv) {
+	long n = size_arg(argc, argv, 1000);
+
+	// build a log-like text
+	StringBuffer buf;
+	for(int i = 0; i < 10000; i++)
+		buf << "0x" << io::hex(i * 4) << ": instruction executed at cycle " << i * 3 << ";\n";
+	string text = buf.toString();
+	cout << "search in " << text.length() << " characters, " << n << " times\n";
+
+	volatile long r = 0;
+	report("scalar loop indexOf(char)", measure([&]() {
+		for(long i = 0; i < n; i++)
+			r += scalar_index(text, '#');
+	}), n * text.length());
+	report("String::indexOf(char)", measure([&]() {
+		for(long i = 0; i < n; i++)
+			r += text.indexOf('#');
+	}), n * text.length());
+	report("String::indexOf(string)", measure([&]() {
+		for(long i = 0; i < n; i++)
+			r += text.indexOf("cycle 0;");
+	}), n * text.length());
+	chars::Set set("#@%");
+	report("String::indexOf(set)", measure([&]() {
+		for(long i = 0; i < n; i++)
+			r += text.indexOf(set);
+	}), n * text.length());
+	report("StringSplit(set)", measure([&]() {
+		for(long i = 0; i < n / 10; i++)
+			for(StringSplit sp(text, chars::Set(":;\n")); sp; sp++)
+				r++;
+	}), n / 10 * text.length());
+	return 0;
+}
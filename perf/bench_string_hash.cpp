@@ -0,0 +1,144 @@
+/*
+ *	string hashing performance measurement
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/HashSet.h>
+#include <elm/data/Vector.h>
+#include <elm/io/InStream.h>
+#include <elm/string/StringBuffer.h>
+#include <elm/sys/System.h>
+#include "bench.h"
+
+using namespace elm;
+
+// former ELF/PJW hash, for comparison
+static t::hash hash_elf(const char *chars, int length) {
+	t::hash h = 0, g;
+	for(int i = 0; i < length; i++) {
+		h = (h << 4) + chars[i];
+		if((g = h & 0xf0000000)) {
+			h = h ^ (g >> 24);
+			h = h ^ g;
+		}
+	}
+	return h;
+}
+
+static t::hash hash_oaat(const char *chars, int length) { return hash_jenkins(chars, length); }
+static t::hash hash_wy(const char *chars, int length) { return hash_string(chars, length); }
+
+typedef t::hash (*fun_t)(const char *chars, int length);
+
+// collect the identifiers of a file
+static void scan(sys::Path path, HashSet<string>& ids) {
+	io::InStream *in = sys::System::readFile(path);
+	char buf[4096];
+	StringBuffer id;
+	for(int n = in->read(buf, sizeof(buf)); n > 0; n = in->read(buf, sizeof(buf)))
+		for(int i = 0; i < n; i++) {
+			char c = buf[i];
+			if(c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (id.length() && c >= '0' && c <= '9'))
+				id << c;
+			else if(id.length()) {
+				ids.add(id.toString());
+				id.reset();
+			}
+		}
+	delete in;
+}
+
+// collect the identifiers of a file or of the files of a directory
+static void collect(sys::Path path, HashSet<string>& ids) {
+	if(path.isDir()) {
+		for(auto name: sys::System::contentOf(path))
+			if(name != "." && name != "..")
+				collect(path / name, ids);
+	}
+	else if(path.extension() == "h" || path.extension() == "cpp")
+		scan(path, ids);
+}
+
+// measure throughput and distribution
+static void bench(cstring name, fun_t f, const Vector<string>& ids, int reps) {
+	cout << name << io::endl;
+	t::hash sum = 0;
+	report("hashing (per identifier)", measure([&]() {
+		for(int r = 0; r < reps; r++)
+			for(const auto& id: ids)
+				sum += f(id.chars(), id.length());
+	}), long(reps) * ids.length());
+	if(sum == 0)
+		cout << "unexpected null sum\n";
+
+	// full collisions
+	HashSet<t::hash> hashes;
+	for(const auto& id: ids)
+		hashes.add(f(id.chars(), id.length()));
+	cout << io::fmt("full collisions").width(40) << (ids.length() - hashes.count()) << io::endl;
+
+	// bucket distribution for prime modulo and power of 2 mask
+	for(int k = 0; k < 2; k++) {
+		int size = k == 0 ? 4099 : 4096;
+		Vector<int> buckets(size);
+		for(int i = 0; i < size; i++)
+			buckets.add(0);
+		for(const auto& id: ids) {
+			t::hash h = f(id.chars(), id.length());
+			buckets[k == 0 ? h % size : h & (size - 1)]++;
+		}
+		int max = 0, empty = 0;
+		for(auto b: buckets) {
+			if(b > max)
+				max = b;
+			if(b == 0)
+				empty++;
+		}
+		cout << io::fmt(_ << (k == 0 ? "% " : "& ") << size << " max bucket / empty").width(40)
+			 << max << " / " << empty << io::endl;
+	}
+}
+
+int main(int argc, char **argv) {
+
+	// collect the corpus
+	HashSet<string> set;
+	if(argc <= 1)
+		collect("../include", set);
+	else
+		for(int i = 1; i < argc; i++)
+			collect(argv[i], set);
+	Vector<string> ids;
+	int bytes = 0;
+	for(const auto& id: set) {
+		ids.add(id);
+		bytes += id.length();
+	}
+	if(!ids) {
+		cerr << "ERROR: no identifier found\n";
+		return 1;
+	}
+	cout << ids.length() << " identifiers, " << (double(bytes) / ids.length()) << " characters on average\n";
+
+	int reps = 20000000 / ids.length() + 1;
+	bench("ELF (former hash_string)", hash_elf, ids, reps);
+	bench("Jenkins one-at-a-time (hash_jenkins)", hash_oaat, ids, reps);
+	bench("wyhash (hash_string)", hash_wy, ids, reps);
+	return 0;
+}
@@ -0,0 +1,70 @@
+/*
+ *	UTF-8 processing performance measurement
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/string/StringBuffer.h>
+#include <elm/string/utf8.h>
+#include "bench.h"
+
+using namespace elm;
+
+// character iteration used before the bulk functions
+static bool iter_validate(const string& s) {
+	try {
+		for(utf8::Iter i(s); i(); i++)
+			;
+		return true;
+	}
+	catch(utf8::Exception& e) {
+		return false;
+	}
+}
+
+int main(int argc, char **argv) {
+	long n = size_arg(argc, argv, 1000);
+
+	// build a JSON-like text, mostly ASCII with some accented words
+	StringBuffer buf;
+	for(int i = 0; i < 5000; i++)
+		buf << "{\"id\": " << i << ", \"name\": \"caf\xc3\xa9 " << i << "\", \"tag\": \"\xe2\x82\xac\"},\n";
+	string text = buf.toString();
+	cout << "process " << text.length() << " bytes, " << n << " times\n";
+
+	volatile long r = 0;
+	report("utf8::Iter", measure([&]() {
+		for(long i = 0; i < n; i++)
+			r += iter_validate(text);
+	}), n * text.length());
+	report("utf8::validate()", measure([&]() {
+		for(long i = 0; i < n; i++)
+			r += utf8::validate(text);
+	}), n * text.length());
+	report("utf8::count()", measure([&]() {
+		for(long i = 0; i < n; i++)
+			r += utf8::count(text);
+	}), n * text.length());
+	t::uint16 *out = new t::uint16[text.length()];
+	report("utf8::toUtf16()", measure([&]() {
+		for(long i = 0; i < n; i++)
+			r += utf8::toUtf16(text.chars(), text.length(), out);
+	}), n * text.length());
+	delete [] out;
+	return 0;
+}
@@ -70,10 +70,12 @@ StackAllocator::~StackAllocator(void) {
  * @param size	Size of the block.
  * @return		Allocated block.
  * @throws BadAlloc		If there is no more memory.
- * @note	The size must not be greater than the size of the chunks.
+ * @note	A block bigger than the chunks gets its own chunk and the following
+ * 			allocations start a new chunk.
  */
 void *StackAllocator::allocate(t::size size) {
-	ASSERTP(size <= _size, "allocated block too big !")
+	if(size > _size)
+		return allocateBig(size);
 	if(!cur || size_t(max - top) < size)
 		return chunkFilled(size);
 	char *res = top;
@@ -95,6 +97,22 @@ void *StackAllocator::chunkFilled(t::size size) {
 }
 
 
+// allocate a block bigger than the chunks in its own chunk,
+// inserted under a new current chunk so that the marks stay valid
+void *StackAllocator::allocateBig(t::size size) {
+	try {
+		chunk_t *chunk = (chunk_t *)new char[sizeof(chunk_t) + size];
+		chunk->next = cur;
+		cur = chunk;
+		newChunk();
+		return chunk->buffer;
+	}
+	catch(std::bad_alloc&) {
+		throw BadAlloc();
+	}
+}
+
+
 /**
  * @fn void StackAllocator::free(void *block);
  * Free the given block.
@@ -112,6 +130,7 @@ void StackAllocator::clear(void) {
 		delete [] (char *)cur;
 		cur = next;
 	}
+	top = max = 0;
 }
 
 
@@ -145,10 +164,15 @@ StackAllocator::mark_t StackAllocator::mark(void) {
 
 
 /**
- * Release the stack onto the given mark.
+ * Release the stack onto the given mark. The mark of an allocator
+ * without any allocation releases all its memory.
  * @param mark		Stack position to free onto.
  */
 void StackAllocator::release(mark_t mark) {
+	if(!mark) {
+		clear();
+		return;
+	}
 	while(cur) {
 		if(mark >= cur->buffer && mark < cur->buffer + _size) {
 			top = mark;
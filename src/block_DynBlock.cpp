@@ -13,7 +13,16 @@ namespace elm { namespace block {
 
 /**
  * @class DynBlock
- * This class implements an exyensible block of memory.
+ * This class implements an extensible block of memory.
+ *
+ * When the block is full, its capacity is multiplied by the growth factor
+ * (2 as a default) so that building a block of n bytes costs O(n) copies.
+ * The capacity grows at least by the increment. A factor less or equal to 1
+ * restores the old linear growth by increment.
+ *
+ * As the buffer returned by detach() must be freed with "delete []"
+ * (it is adopted by String and CString), growing cannot use realloc():
+ * the geometric growth makes the copy amortized.
  */
 
 /*
@@ -24,22 +33,28 @@ void DynBlock::grow(int min) {
 
 	// Compute new size
 	int new_size = cap + ((min > inc) ? min : inc);
-	
+	if(fact > 1 && cap * fact > new_size)
+		new_size = int(cap * fact);
+
 	// Allocate it
 	char *new_buf = new char[new_size];
-	
+
 	// Initialize it
-	memcpy(new_buf, buf, _size);
-	delete [] buf;
+	if(buf) {
+		memcpy(new_buf, buf, _size);
+		delete [] buf;
+	}
 	buf = new_buf;
+	cap = new_size;
 }
 
 
 /**
- * @fn DynBlock::DynBlock(int capacity, int increment);
+ * @fn DynBlock::DynBlock(int capacity, int increment, float factor);
  * Build a new dynamic block.
- * @param capacity		Initial capacity of allocated buffer.
- * @param increment	Increment for enlarging the buffer.
+ * @param capacity	Initial capacity of allocated buffer.
+ * @param increment	Minimal increment for enlarging the buffer.
+ * @param factor	Growth factor of the capacity (default to 2).
  */
 
 
@@ -103,6 +118,29 @@ void DynBlock::get(char *block, int size, int pos) {
  */
  
 
+/**
+ * @fn float DynBlock::factor(void) const;
+ * Get the growth factor of the capacity.
+ * @return	Growth factor.
+ */
+
+
+/**
+ * @fn void DynBlock::setFactor(float factor);
+ * Set the growth factor of the capacity (less or equal to 1 for a linear
+ * growth by increment).
+ * @param factor	New growth factor.
+ */
+
+
+/**
+ * @fn void DynBlock::reserve(int capacity);
+ * Ensure that the block capacity is at least the given one
+ * so that no more allocation is performed until this size is reached.
+ * @param capacity	Minimal capacity.
+ */
+
+
 /**
  * @fn void DynBlock::setSize(int new_size);
  * Set the size of the block. Must be less or equal to the current block size.
@@ -116,6 +154,20 @@ void DynBlock::get(char *block, int size, int pos) {
  */
 
 
+/**
+ * Reset the block to a size of 0 and allocate a new buffer of the given
+ * capacity (the current buffer is released if not detached).
+ * @param capacity	New capacity.
+ */
+void DynBlock::reset(int capacity) {
+	if(buf)
+		delete [] buf;
+	_size = 0;
+	cap = capacity;
+	buf = new char[cap];
+}
+
+
 /**
 * @fn const char *DynBlock::base(void) const;
 * Get the buffer base of the block.
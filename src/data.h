@@ -61,13 +61,14 @@ namespace elm {
  * 	* small -- Vector, VectorQueue
  * 	* medium -- List, SortedList, BiDiList, TreeBag, TreeMap
  * 	* big -- FragTable, avl::Tree, avl::Map,
- * avl::Set, ListQueue, HashMap, HashSet
+ * avl::Set, ListQueue, HashMap, HashSet, FlatHashMap, FlatHashSet
  *
  * Access type:
  *  * indexed -- Vector, FragTable
  *	* sequential -- Vector, List, SortedList, BiDiList, FragTable, avl::Tree
  *	* fast lookup -- avl::Tree, TreeBag, SortedList
- *	* key access -- ListMap, HashMap, avl::Map, TreeMap
+ *	* key access -- ListMap, HashMap, FlatHashMap, avl::Map, TreeMap
+ *	* concurrent key access -- ConcurrentHashMap
  *
  * Modification type:
  *	* append -- Vector, FragTable, BiDiList
@@ -75,14 +76,15 @@ namespace elm {
  *	* push / pop (stack) -- StaticStack, Vector, List, BiDiList, FragTable
  *	* append / remove first (queue) -- BiDiList, VectorQueue, ListQueue
  *	* random -- List, BiDiList
- *	* uniqueness of elements (set) -- ListSet, avl::Set, HashSet
- *	* key access (map) -- ListMap, HashMap, avl::Map, TreeMap
+ *	* uniqueness of elements (set) -- ListSet, avl::Set, HashSet, FlatHashSet
+ *	* key access (map) -- ListMap, HashMap, FlatHashMap, avl::Map, TreeMap
  *	* inter-set operation (efficient) -- BitVector
  *
  * Memory footprint:
  *	* light -- Array, Vector, VectorQueue, BitVector, StaticStack, List, ListQueue, SortedList, ListMap
  *	* medium -- BiDiList, TreeBag, TreeMap, avl::Tree, avl::Map, avl::Set, FragTable
  *	* heavy at startup -- HashTable, HashMap, HashSet
+ *	* proportional to capacity -- FlatHashTable, FlatHashMap, FlatHashSet
  *
  * The array below sum up the complexity of operations for the data structures
  * described above. When 2 complexity are give o1/o2, o1 is the average case
@@ -98,6 +100,7 @@ namespace elm {
  * FragTable      | O(1)           | O(n)           | O(n)         | O(n)
  * HashTable      | O(b)           | O(b)           | O(1)         | O(1)
  * HashSet        | O(b)           | O(b)           | O(1)         | O(1)
+ * FlatHashSet    | O(1)           | O(1)           | O(1)         | O(1)
  * avl::Tree      | O(log(n))      | O(log(n))      | O(1)         | O(log(n))
  * avl::Set       | O(log(n))      | O(log(n))      | O(1)         | O(log(n))
  *
@@ -112,6 +115,7 @@ namespace elm {
  * Data Structure | lookup         | insertion      | removal
  * -------------- | -------------- | -------------- | --------------
  * HashMap        | O(b)           | O(b)           | O(b)
+ * FlatHashMap    | O(1)           | O(1)           | O(1)
  * avl::Map       | O(log(n))      | O(log(n))      | O(log(n))
  * TreeMap        | O(log(n))/O(n) | O(log(n))/O(n) | O(log(n))/O(n)
  * ListMap        | O(n)           | O(n)           | O(n)
@@ -154,6 +158,7 @@ namespace elm {
  * Data Structure | join   | meet   | difference
  * -------------- | ------ | ------ | ----------
  * HashSet        | O(bn)  | O(bn)  | O(bn)
+ * FlatHashSet    | O(n)   | O(n)   | O(n)
  * avl::Set       | O(n)   | O(n)   | O(n)
  * BitVector      | O(n)   | O(n)   | O(n)
  *
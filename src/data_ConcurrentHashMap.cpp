@@ -0,0 +1,161 @@
+/*
+ *	ConcurrentHashMap class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/ConcurrentHashMap.h>
+
+namespace elm {
+
+/**
+ * @class ConcurrentHashMap
+ * Map that may be accessed and modified concurrently by several threads.
+ *
+ * The map is split in several stripes, each one made of a @ref HashMap and
+ * of a @ref sys::ReadWriteLock. A key is always stored in the same stripe, selected
+ * from its hash, so that threads working on keys of different stripes do not
+ * contend. As the look-ups of @ref HashMap do not modify the table, they
+ * only lock the stripe for reading and may run concurrently; the stripes
+ * are only locked for the duration of the accessed operation.
+ *
+ * As the values are copied out of the map in mutual exclusion,
+ * no reference to the stored values is provided. Unlike @ref HashMap, there
+ * is no iterator: @ref forEach() provides a traversal locking a stripe
+ * at a time. The map cannot be copied.
+ *
+ * @par Characteristics
+ * @li average access time: O(1)
+ * @li average add time: O(1) (amortized)
+ * @li average remove time: O(1)
+ *
+ * @param K		Type of the key.
+ * @param T		Type of values.
+ * @param H		Hash key on K.
+ * @param A		Allocator.
+ * @ingroup data
+ */
+
+/**
+ * @fn ConcurrentHashMap::ConcurrentHashMap(int stripes);
+ * Build a concurrent map.
+ * @param stripes	Number of stripes (rounded up to the next power of 2, default to 16).
+ * 					A number close to the number of cores is a good choice.
+ */
+
+/**
+ * @fn int ConcurrentHashMap::stripes() const;
+ * Get the number of stripes of the map.
+ * @return	Number of stripes.
+ */
+
+/**
+ * @fn Option<T> ConcurrentHashMap::get(const K& k) const;
+ * Get the value associated with a key.
+ * @param k		Looked key.
+ * @return		Value associated with k or none.
+ */
+
+/**
+ * @fn T ConcurrentHashMap::get(const K& k, const T& def) const;
+ * Get the value associated with a key.
+ * @param k		Looked key.
+ * @param def	Default value.
+ * @return		Value associated with k or def.
+ */
+
+/**
+ * @fn bool ConcurrentHashMap::hasKey(const K& k) const;
+ * Test if a key is in the map.
+ * @param k		Looked key.
+ * @return		True if k is in the map, false else.
+ */
+
+/**
+ * @fn void ConcurrentHashMap::put(const K& k, const T& v);
+ * Associate a value with a key, replacing the current value if any.
+ * @param k		Key.
+ * @param v		Value.
+ */
+
+/**
+ * @fn Option<T> ConcurrentHashMap::putIfAbsent(const K& k, const T& v);
+ * Associate a value with a key only if the key is not already in the map.
+ * The test and the addition are performed atomically.
+ * @param k		Key.
+ * @param v		Value.
+ * @return		Value currently associated with k or none if v has been added.
+ */
+
+/**
+ * @fn T ConcurrentHashMap::computeIfAbsent(const K& k, F f);
+ * Get the value associated with a key. If the key is not in the map,
+ * the value is computed by calling f(k) and added to the map.
+ * The key is marked as in computation while f runs, so that f is called
+ * at most once per key: the other threads calling computeIfAbsent() on
+ * the same key wait for the result, while the computations of other keys,
+ * even of the same stripe, run concurrently. f runs without any lock: it may
+ * use any function of the map, including computeIfAbsent() on other keys
+ * (to memoize a recursive function for example), but not on k itself.
+ * If the key is put by another thread while f runs, the value of this thread
+ * is kept and the result of f is dropped. If f throws an exception,
+ * nothing is added and the exception is propagated (a waiting thread
+ * then computes the value).
+ *
+ * @code
+ * ConcurrentHashMap<int, t::uint64> memo;
+ * std::function<t::uint64(int)> fib = [&](int n) -> t::uint64
+ *	{ return n < 2 ? n : memo.computeIfAbsent(n - 1, fib) + memo.computeIfAbsent(n - 2, fib); };
+ * @endcode
+ * @param k		Key.
+ * @param f		Function computing the value from the key.
+ * @return		Value associated with k.
+ */
+
+/**
+ * @fn void ConcurrentHashMap::remove(const K& k);
+ * Remove a key and its value from the map.
+ * @param k		Removed key.
+ */
+
+/**
+ * @fn int ConcurrentHashMap::count() const;
+ * Count the items of the map. As the stripes are counted one after the
+ * other, the result is only a snapshot if other threads modify the map.
+ * @return	Number of items.
+ */
+
+/**
+ * @fn bool ConcurrentHashMap::isEmpty() const;
+ * Test if the map is empty.
+ * @return	True if the map is empty, false else.
+ */
+
+/**
+ * @fn void ConcurrentHashMap::clear();
+ * Remove all items of the map.
+ */
+
+/**
+ * @fn void ConcurrentHashMap::forEach(F f) const;
+ * Call f(key, value) on each item of the map, locking each stripe in turn.
+ * f must not access the map.
+ * @param f		Function to call.
+ */
+
+}	// elm
@@ -0,0 +1,160 @@
+/*
+ *	FlatHashTable class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/FlatHashMap.h>
+#include <elm/data/FlatHashSet.h>
+
+namespace elm {
+
+/**
+ * @class FlatHashTable
+ * Hash table implemented with open addressing: the items are stored
+ * directly in an array of slots and collisions are solved by linear probing.
+ * Unlike @ref HashTable, no node is allocated per item and look-ups scan
+ * contiguous memory without following pointers.
+ *
+ * The insertion uses the "Robin Hood" policy: an item travelling
+ * far from its home slot takes the place of an item closer to its own home.
+ * This keeps the probe sequences short and allows a look-up to stop as soon
+ * as it meets an item closer to its home than the looked key would be.
+ * Removal shifts backward the following items of the probe sequence
+ * so that no tombstone is needed.
+ *
+ * The capacity is always a power of 2 and the table doubles as soon as
+ * the load (ratio of items on capacity) exceeds the maximum load
+ * (0.8 by default). The hash of the key is scrambled with
+ * a Fibonacci multiplication so that even the weak hash functions
+ * (identity on integers, pointer alignment) distribute well over the slots.
+ *
+ * The items are moved when the table grows or an item is removed: pointers
+ * on stored items and iterators are invalidated by any modification of the table,
+ * except the removal of the current item of an iterator with remove(const Iter&):
+ * the iteration can then go on with next() and visits each remaining item once
+ * (the slots are scanned backward from an empty slot so that the items moved
+ * back by the removal have already been visited).
+ *
+ * To use it as a map, refer to @ref FlatHashMap. To use it as a set, refer
+ * to @ref FlatHashSet.
+ *
+ * @param T	Type of stored data.
+ * @param H	Hash key (must implement @ref concept::Hash).
+ * @param A	Allocator.
+ * @ingroup data
+ */
+
+/**
+ * @fn FlatHashTable::FlatHashTable(int size);
+ * Build a flat hash table with the given initial capacity (rounded up
+ * to the next power of 2).
+ * @param size	Initial capacity (default to 16).
+ */
+
+/**
+ * @fn float FlatHashTable::maxLoad() const;
+ * Get the maximum load, that is the maximum ratio between the number of items
+ * and the capacity, before the table grows.
+ * @return	Maximum load.
+ */
+
+/**
+ * @fn void FlatHashTable::setMaxLoad(float load);
+ * Set the maximum load of the table. As an open-addressing table cannot
+ * store more items than its capacity, a load out of ]0, 1] is replaced by 1.
+ * @param load	New maximum load.
+ */
+
+/**
+ * @fn void FlatHashTable::reserve(int n);
+ * Ensure the table can store n items without growing.
+ * @param n		Number of items to reserve space for.
+ */
+
+/**
+ * @fn int FlatHashTable::size() const;
+ * Get the current capacity of the table.
+ * @return	Capacity in slots.
+ */
+
+
+/**
+ * @class FlatHashMap
+ * Map implemented using a @ref FlatHashTable. It provides the same interface
+ * as @ref HashMap and may replace it simply by changing the type, providing
+ * the user code does not keep pointers or iterators on the map while modifying it.
+ *
+ * @par Implemented Concepts
+ * @li @ref Collection
+ * @li @ref Map
+ * @li @ref MutableMap
+ *
+ * @par Characteristics
+ * C is the capacity of the table, growing to keep n / C under the maximum load.
+ * @li average access time: O(1)
+ * @li average add time: O(1) (amortized)
+ * @li average remove time: O(1)
+ * @li memory space: C * (key size + value size + 1)
+ *
+ * @param K		Type of the key.
+ * @param T		Type of values.
+ * @param H		Hash key on K.
+ * @param A		Allocator.
+ * @param E		Equivalence on values.
+ * @ingroup data
+ */
+
+/**
+ * @fn int FlatHashMap::size() const;
+ * Get the current capacity of the underlying table.
+ * @return	Capacity in slots.
+ */
+
+
+/**
+ * @class FlatHashSet
+ * Set implemented using a @ref FlatHashTable. It provides the same interface
+ * as @ref HashSet and may replace it simply by changing the type, providing
+ * the user code does not keep iterators on the set while modifying it.
+ *
+ * @par Implemented Concepts
+ * @li @ref Collection
+ * @li @ref MutableCollection
+ * @li @ref Set
+ *
+ * @par Characteristics
+ * C is the capacity of the table, growing to keep n / C under the maximum load.
+ * @li average access time: O(1)
+ * @li average add time: O(1) (amortized)
+ * @li average remove time: O(1)
+ * @li memory space: C * (data size + 1)
+ *
+ * @param T		Type of set elements.
+ * @param H		Hash key on T.
+ * @param A		Allocator.
+ * @ingroup data
+ */
+
+/**
+ * @fn int FlatHashSet::size() const;
+ * Get the current capacity of the underlying table.
+ * @return	Capacity in slots.
+ */
+
+}	// elm
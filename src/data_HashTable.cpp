@@ -27,8 +27,23 @@ namespace elm {
 /**
  * @class HashTable
  * This class provides an hashing table implementation as an array of linked
- * list. A small caching feature put to the head of the linked list last
- * accessed items.
+ * list.
+ *
+ * Look-ups do not modify the table: as long as no thread modifies it, a table
+ * may be shared and read concurrently by several threads without locking.
+ * Optionally, an adaptive mode (see @ref setAdaptive()) moves the last
+ * accessed items to the head of their linked list. This speeds up tables
+ * where few keys are accessed very often but makes look-ups writes:
+ * an adaptive table must not be shared between threads.
+ * The functions suffixed by "_const" never use the adaptive mode.
+ *
+ * The table grows automatically as soon as the ratio between the number
+ * of items and the number of buckets exceeds the maximum load (1 by default,
+ * see @ref setMaxLoad()). To avoid a long pause, the growth is incremental:
+ * a new bucket array is allocated and the items of the old one are migrated
+ * a few buckets at a time, at each addition. Meanwhile, look-ups work on both arrays.
+ * The function @ref reserve() may be used to size the table in one step
+ * when the final number of items is known.
  *
  * This class is the basic implementation of hash table.
  * To use it as a map, refer to @ref HashMap. To use it as a set, refer
@@ -61,6 +76,43 @@ namespace elm {
  * @param h	Hash table to clone.
  */
 
+/**
+ * @fn bool HashTable::isAdaptive() const;
+ * Test if the adaptive mode is enabled, that is, if look-ups move the found
+ * item at the head of its linked list.
+ * @return	True if the adaptive mode is enabled, false else.
+ */
+
+/**
+ * @fn void HashTable::setAdaptive(bool adaptive);
+ * Enable or disable the adaptive mode (disabled by default). In adaptive
+ * mode, look-ups move the found item at the head of its linked list and
+ * the table cannot be read concurrently by several threads anymore.
+ * @param adaptive	True to enable the adaptive mode, false to disable it.
+ */
+
+/**
+ * @fn float HashTable::maxLoad() const;
+ * Get the maximum load, that is the maximum ratio between the number of items
+ * and the number of buckets, before the table grows.
+ * @return	Maximum load.
+ */
+
+/**
+ * @fn void HashTable::setMaxLoad(float load);
+ * Set the maximum load, that is the maximum ratio between the number of items
+ * and the number of buckets, before the table grows. A null or negative
+ * load disables the growth of the table.
+ * @param load	New maximum load.
+ */
+
+/**
+ * @fn void HashTable::reserve(int n);
+ * Ensure the table has enough buckets to store n items without
+ * growing. The re-hashing, if any, is performed immediately.
+ * @param n		Number of items to reserve space for.
+ */
+
 /**
  * @fn bool HashTable::isEmpty(void) const;
  * Test if the table is empty.
@@ -137,10 +189,10 @@ namespace elm {
  * @li @ref MutableMap
  *
  * @par Characteristics
- * S is the size of the table.
- * @li average access time: O(n / S)
- * @li average add time: O(n / S)
- * @li average remove time: O(n / S)
+ * S is the size of the table, growing to keep n / S under the maximum load.
+ * @li average access time: O(1)
+ * @li average add time: O(1) (amortized)
+ * @li average remove time: O(1)
  * @li memory space: pointer size * S + n * (key size + value size + pointer size)
  *
  * @param K		Type of the key.
@@ -173,6 +225,41 @@ namespace elm {
  * @return		Reference to data associated with key.
  */
 
+/**
+ * @fn bool HashMap::isAdaptive() const;
+ * Test if the adaptive mode of the underlying table is enabled.
+ * @return	True if the adaptive mode is enabled, false else.
+ * @see HashTable::setAdaptive()
+ */
+
+/**
+ * @fn void HashMap::setAdaptive(bool adaptive);
+ * Enable or disable the adaptive mode of the underlying table.
+ * @param adaptive	True to enable the adaptive mode, false to disable it.
+ * @see HashTable::setAdaptive()
+ */
+
+/**
+ * @fn float HashMap::maxLoad() const;
+ * Get the maximum load of the underlying hash table.
+ * @return	Maximum load.
+ * @see HashTable::maxLoad()
+ */
+
+/**
+ * @fn void HashMap::setMaxLoad(float load);
+ * Set the maximum load of the underlying hash table.
+ * @param load	New maximum load (null or negative to disable growth).
+ * @see HashTable::setMaxLoad()
+ */
+
+/**
+ * @fn void HashMap::reserve(int n);
+ * Ensure the underlying table can store n items without growing.
+ * @param n		Number of items to reserve space for.
+ * @see HashTable::reserve()
+ */
+
 /**
  * @fn bool HashMap::isEmpty(void) const;
  * Test if the map is empty.
@@ -283,10 +370,10 @@ namespace elm {
  * @li @ref Set
  *
  * @par Characteristics
- * S is the size of the table.
- * @li average access time: O(n / S)
- * @li average add time: O(n / S)
- * @li average remove time: O(n / S)
+ * S is the size of the table, growing to keep n / S under the maximum load.
+ * @li average access time: O(1)
+ * @li average add time: O(1) (amortized)
+ * @li average remove time: O(1)
  * @li memory space: pointer size * S + n * (data size + pointer size)
  *
  * @param T		Type of set elements.
@@ -334,6 +421,41 @@ namespace elm {
  * @return		True if all collection items are in the set, false else.
  */
 
+/**
+ * @fn bool HashSet::isAdaptive() const;
+ * Test if the adaptive mode of the underlying table is enabled.
+ * @return	True if the adaptive mode is enabled, false else.
+ * @see HashTable::setAdaptive()
+ */
+
+/**
+ * @fn void HashSet::setAdaptive(bool adaptive);
+ * Enable or disable the adaptive mode of the underlying table.
+ * @param adaptive	True to enable the adaptive mode, false to disable it.
+ * @see HashTable::setAdaptive()
+ */
+
+/**
+ * @fn float HashSet::maxLoad() const;
+ * Get the maximum load of the underlying hash table.
+ * @return	Maximum load.
+ * @see HashTable::maxLoad()
+ */
+
+/**
+ * @fn void HashSet::setMaxLoad(float load);
+ * Set the maximum load of the underlying hash table.
+ * @param load	New maximum load (null or negative to disable growth).
+ * @see HashTable::setMaxLoad()
+ */
+
+/**
+ * @fn void HashSet::reserve(int n);
+ * Ensure the underlying table can store n items without growing.
+ * @param n		Number of items to reserve space for.
+ * @see HashTable::reserve()
+ */
+
 /**
  * @fn bool HashSet::isEmpty(void) const;
  * Test if the set is empty.
@@ -64,11 +64,35 @@ BlockInStream::BlockInStream(const CString& str)
 
 
 /**
- * Build a block input stream from a String object.
+ * Build a block input stream from a String object. The stream keeps
+ * a copy of the string: it may be built from a temporary.
  * @param str	String to read from.
  */
 BlockInStream::BlockInStream(const String& str)
-: _block(str.chars()), _size(str.length()), off(0) {
+: _str(str), _block(_str.chars()), _size(_str.length()), off(0) {
+}
+
+
+/**
+ * Copy constructor.
+ * @param s		Copied stream.
+ */
+BlockInStream::BlockInStream(const BlockInStream& s)
+: _str(s._str), _block(s._str ? _str.chars() : s._block), _size(s._size), off(s.off) {
+}
+
+
+/**
+ * Assignment.
+ * @param s		Assigned stream.
+ * @return		Current stream.
+ */
+BlockInStream& BlockInStream::operator=(const BlockInStream& s) {
+	_str = s._str;
+	_block = s._str ? _str.chars() : s._block;
+	_size = s._size;
+	off = s.off;
+	return *this;
 }
 
 
@@ -145,5 +169,23 @@ int BlockInStream::read(void) {
 	return res;
 }
 
+
+/**
+ */
+int BlockInStream::peek(const char *&p) {
+	if(off >= _size)
+		return ENDED;
+	p = _block + off;
+	return _size - off;
+}
+
+
+/**
+ */
+void BlockInStream::advance(int n) {
+	ASSERT(off + n <= _size);
+	off += n;
+}
+
 } } // elm::io
 
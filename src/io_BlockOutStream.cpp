@@ -29,23 +29,57 @@ namespace elm { namespace io {
 /**
  * @class BlockOutStream
  * This class provides an out stream stocking output bytes in memory
- * in a continuous blocks.
+ * in a continuous blocks. The block capacity grows geometrically
+ * (see block::DynBlock) so that producing n bytes costs O(n) copies.
+ *
+ * In chunked mode, the bytes are stored in a list of chunks whose size
+ * doubles up to @ref max_chunk: the written bytes are never copied again.
+ * The chunks can be visited with chunkCount() and chunk() or detached
+ * as a scatter list with detachChunks(). The functions requiring
+ * a contiguous block (block(), detach(), setSize(), toString(), toCString())
+ * gather the chunks first.
  * @ingroup ios
  */
 
 
 /**
- * @fn BlockOutStream::BlockOutStream(int size, int inc);
+ * @fn BlockOutStream::BlockOutStream(int size, int inc, bool chunked);
  * Build a new block output stream.
- * @param size	Initial size of the block.
- * @param inc	Value of the increment for enlarging the block.
+ * @param size		Initial size of the block.
+ * @param inc		Value of the minimal increment for enlarging the block.
+ * @param chunked	True to store the bytes in a list of chunks.
+ */
+
+
+/**
  */
+BlockOutStream::~BlockOutStream(void) {
+	for(int i = 0; i < _ccnt; i++)
+		delete [] _chunks[i].base;
+	if(_chunks)
+		delete [] _chunks;
+}
 
 
 /**
- * @fn char *BlockOutStream::block(void) const;
  * Get a pointer on the start of the storage block. This pointer remains
  * only valid until an output is performed on the stream.
+ * On a constant stream, the bytes must be stored in one block
+ * (the stream is not chunked or has been gathered by the non-constant
+ * version of block()).
+ * @return	Current storage memory block.
+ */
+const char *BlockOutStream::block(void) const {
+	ASSERTP(_ccnt == 0, "BlockOutStream::block() const on split chunks");
+	return _block.base();
+}
+
+
+/**
+ * @fn const char *BlockOutStream::block(void);
+ * Get a pointer on the start of the storage block, gathering
+ * the chunks in chunked mode. This pointer remains only valid until
+ * an output is performed on the stream.
  * @return	Current storage memory block.
  */
 
@@ -68,9 +102,36 @@ namespace elm { namespace io {
 
 
 /**
- * @fn void BlockOutStream::clear(void);
+ * Detach the stored bytes as a list of chunks: the caller becomes
+ * responsible for deleting the returned array and the chunk bases
+ * with "delete []". The stream is then cleared and can be used again.
+ * @param count		Set to the number of chunks.
+ * @return			Array of chunks.
+ */
+BlockOutStream::chunk_t *BlockOutStream::detachChunks(int& count) {
+	chunk_t *r = new chunk_t[_ccnt + 1];
+	for(int i = 0; i < _ccnt; i++)
+		r[i] = _chunks[i];
+	int size = _block.size();
+	r[_ccnt] = chunk_t(_block.detach(), size);
+	count = _ccnt + 1;
+	_ccnt = 0;
+	_done = 0;
+	_block.reset(_block.capacity());
+	return r;
+}
+
+
+/**
  * Clear the block receiving bytes from output.
  */
+void BlockOutStream::clear(void) {
+	for(int i = 0; i < _ccnt; i++)
+		delete [] _chunks[i].base;
+	_ccnt = 0;
+	_done = 0;
+	_block.reset();
+}
 
 
 /**
@@ -81,9 +142,130 @@ namespace elm { namespace io {
 
 
 /**
- */	
+ * @fn void BlockOutStream::reserve(int size);
+ * Ensure that the block can contain size bytes without re-allocation
+ * (no effect in chunked mode).
+ * @param size	Reserved size.
+ */
+
+
+/**
+ * @fn float BlockOutStream::factor(void) const;
+ * Get the growth factor of the block.
+ * @return	Growth factor.
+ */
+
+
+/**
+ * @fn void BlockOutStream::setFactor(float factor);
+ * Set the growth factor of the block.
+ * @param factor	Growth factor.
+ */
+
+
+/**
+ * @fn bool BlockOutStream::isChunked(void) const;
+ * Test if the stream is in chunked mode.
+ * @return	True if it is chunked.
+ */
+
+
+/**
+ * @fn int BlockOutStream::chunkCount(void) const;
+ * Get the number of chunks (1 when the stream is not chunked).
+ * @return	Chunk count.
+ */
+
+
+/**
+ * @fn chunk_t BlockOutStream::chunk(int i) const;
+ * Get a chunk of stored bytes.
+ * @param i	Chunk index.
+ * @return	Chunk base and size.
+ */
+
+
+/**
+ * Get a pointer to write directly up to n bytes at the end of the stream.
+ * The written bytes are only added to the stream by a call to commit()
+ * with the pointer after the last written byte, before any other output.
+ * @param n		Maximum number of bytes to write.
+ * @return		Pointer to write to.
+ */
+char *BlockOutStream::allocate(int n) {
+	if(_chunked && _block.size() != 0 && _block.capacity() - _block.size() < n)
+		next();
+	char *p = _block.alloc(n);
+	_block.setSize(_block.size() - n);
+	return p;
+}
+
+
+/**
+ * @fn void BlockOutStream::commit(char *p);
+ * Add to the stream the bytes written after a call to allocate().
+ * @param p		Pointer after the last written byte.
+ */
+
+
+/**
+ * In chunked mode, close the current chunk and start a new one.
+ */
+void BlockOutStream::next(void) {
+	if(_ccnt == _ccap) {
+		_ccap = _ccap == 0 ? 8 : _ccap * 2;
+		chunk_t *cs = new chunk_t[_ccap];
+		for(int i = 0; i < _ccnt; i++)
+			cs[i] = _chunks[i];
+		if(_chunks)
+			delete [] _chunks;
+		_chunks = cs;
+	}
+	int size = _block.size(), cap = _block.capacity();
+	_chunks[_ccnt++] = chunk_t(_block.detach(), size);
+	_done += size;
+	_block.reset(cap * 2 <= max_chunk ? cap * 2 : max_chunk);
+}
+
+
+/**
+ * Gather the chunks in one contiguous block.
+ */
+void BlockOutStream::gather(void) {
+	if(_ccnt == 0)
+		return;
+	int size = _block.size();
+	char *last = _block.detach();
+	_block.reset(_done + size + _block.increment());
+	for(int i = 0; i < _ccnt; i++) {
+		_block.put(_chunks[i].base, _chunks[i].size);
+		delete [] _chunks[i].base;
+	}
+	_block.put(last, size);
+	delete [] last;
+	_ccnt = 0;
+	_done = 0;
+}
+
+
+/**
+ */
 int BlockOutStream::write(const char *buffer, int size) {
-	_block.put(buffer, size);
+	if(!_chunked)
+		_block.put(buffer, size);
+	else
+		for(int s = size; s > 0; ) {
+			int n = _block.capacity() - _block.size();
+			if(n == 0) {
+				next();
+				continue;
+			}
+			if(n > s)
+				n = s;
+			_block.put(buffer, n);
+			buffer += n;
+			s -= n;
+		}
 	return size;
 }
 
@@ -91,6 +273,8 @@ int BlockOutStream::write(const char *buffer, int size) {
 /**
  */
 int BlockOutStream::write(char byte) {
+	if(_chunked && _block.size() == _block.capacity())
+		next();
 	_block.put(&byte, 1);
 	return 1;
 }
@@ -120,6 +304,7 @@ CString BlockOutStream::toCString(void) {
  * @return	String object.
  */
 String BlockOutStream::toString(void) {
+	gather();
 	return String(_block.base(), _block.size());
 }
 
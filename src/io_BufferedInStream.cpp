@@ -132,6 +132,27 @@ int BufferedInStream::read(void) {
 }
 
 
+/**
+ */
+int BufferedInStream::peek(const char *&p) {
+	if(pos >= top) {
+		int nsize = refill();
+		if(nsize <= 0)
+			return nsize == 0 ? ENDED : FAILED;
+	}
+	p = buf + pos;
+	return top - pos;
+}
+
+
+/**
+ */
+void BufferedInStream::advance(int n) {
+	ASSERT(pos + n <= top);
+	pos += n;
+}
+
+
 /**
  * Reload the buffer.
  */
@@ -135,6 +135,31 @@ void BufferedOutStream::setStream(OutStream& str) {
  */
 
 
+/**
+ * @fn int BufferedOutStream::size(void) const;
+ * Get the size of the buffer.
+ * @return	Buffer size in bytes.
+ */
+
+
+/**
+ * @fn char *BufferedOutStream::reserve(int n);
+ * Get a pointer in the buffer where at least n bytes can be written directly,
+ * flushing the buffer if there is not enough room. The written bytes are
+ * only taken into account by a call to commit(). n must not be bigger than
+ * the buffer size.
+ * @param n		Number of bytes to write.
+ * @return		Pointer in the buffer or null if the flush failed.
+ */
+
+
+/**
+ * @fn void BufferedOutStream::commit(char *p);
+ * Commit the bytes written directly in the buffer after a call to reserve().
+ * @param p		Pointer after the last written byte.
+ */
+
+
 /**
  */
 CString BufferedOutStream::lastErrorMessage(void) {
@@ -72,6 +72,38 @@ int InStream::read(void) {
 }
 
 
+/**
+ * Get a window on the bytes of the stream that are already in memory,
+ * without consuming them. This lets parsers scan the stream without a virtual
+ * call per byte: the scanned bytes are then consumed with advance().
+ * If the window is empty, the stream tries to fill it.
+ * The window is invalidated by any other operation on the stream.
+ *
+ * The default implementation returns UNBUFFERED: the stream has to be read
+ * byte per byte.
+ *
+ * @param p		Set to the address of the first available byte.
+ * @return		Number of available bytes, ENDED for end of stream,
+ *				FAILED for an error or UNBUFFERED if the stream does not
+ *				support windows.
+ */
+int InStream::peek(const char *&p) {
+	return UNBUFFERED;
+}
+
+
+/**
+ * Consume bytes from the stream, generally after a call to peek().
+ * The default implementation reads and drops the bytes.
+ * @param n		Number of bytes to consume (at most the size of the window
+ *				returned by peek() if any).
+ */
+void InStream::advance(int n) {
+	for(; n > 0; n--)
+		read();
+}
+
+
 /**
  * Return a message for the last error.
  * @return	Message of the last error.
@@ -19,11 +19,14 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <type_traits>
 #include <elm/assert.h>
+#include <elm/data/Vector.h>
 #include <elm/io/io.h>
 #include <elm/io/Input.h>
 #include <elm/io/StringInput.h>
 #include <elm/io/FileInput.h>
+#include <elm/io/numconv.h>
 #include <elm/string/StringBuffer.h>
 #include <math.h>
 #include <ctype.h>
@@ -42,6 +45,14 @@ namespace elm { namespace io {
  * in error (reflecting an error in the underlying stream). In addition its
  * states records also the end of the stream.
  *
+ * When the stream provides a window on its buffer (see InStream::peek()),
+ * as @ref BufferedInStream or @ref BlockInStream, the numbers are parsed
+ * directly in the buffer with the fromChars() functions instead of reading
+ * the characters one by one. In both cases, a scanned number follows the
+ * syntax of fromChars() (in particular, no blank is allowed after the sign)
+ * and the characters matching this syntax are consumed, even if the scan
+ * fails: the result does not depend on the type of the stream.
+ *
  * @ingroup ios
  */
 
@@ -115,6 +126,50 @@ void Input::back(int chr) {
 }
 
 
+// blank characters
+static inline bool is_blank(char c) {
+	return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// characters of a number token
+static inline bool is_token(char c) {
+	return ('0' <= c && c <= '9') || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z')
+		|| c == '.' || c == '+' || c == '-';
+}
+
+/**
+ * Skip the blanks and get a window on the stream containing the next token
+ * (made of alphanumeric characters, '.', '+' or '-') and at least
+ * the character following it.
+ * @param b		Set to the start of the window (to compute the number of
+ *				bytes to pass to InStream::advance()).
+ * @param e		Set to the end of the token.
+ * @return		Start of the token, null if the stream does not support
+ *				windows or if the token is not fully in the window.
+ */
+const char *Input::window(const char *&b, const char *&e) {
+	if(buf >= 0) {
+		if(!is_blank(buf))
+			return nullptr;
+		buf = -1;
+	}
+	while(true) {
+		int n = strm->peek(b);
+		if(n <= 0)
+			return nullptr;
+		const char *p = b, *we = b + n;
+		while(p < we && is_blank(*p))
+			p++;
+		if(p == we) {
+			strm->advance(n);
+			continue;
+		}
+		for(e = p; e < we && is_token(*e); e++);
+		return e < we ? p : nullptr;
+	}
+}
+
+
 /**
  * @fn Input::Input(void);
  * Build a new input using the standard.
@@ -253,6 +308,106 @@ static inline int test_base(char chr, int base) {
 }
 
 
+// convert the characters of a number
+static inline bool convert(const char *p, const char *e, t::uint64& x, int base)
+	{ return p < e && fromChars(p, e, x, base) == e; }
+static inline bool convert(const char *p, const char *e, t::int64& x, int base)
+	{ return p < e && fromChars(p, e, x, base) == e; }
+static inline bool convert(const char *p, const char *e, double& x, int base)
+	{ return p < e && fromChars(p, e, x) == e; }
+
+/**
+ * Read the characters of a number, following the syntax of fromChars():
+ * an optional sign (if sign is true), then, for an integer (base >= 0),
+ * the base prefix if base is 0 and the digits of the base or, for
+ * a float (base < 0), the integral part, the fractional part and the exponent.
+ * @param c		First character.
+ * @param next	Function consuming the given character and returning
+ *				the next one.
+ * @param base	Base of an integer (0 to select it from the prefix),
+ *				negative for a float.
+ * @param sign	True if a sign is accepted.
+ * @return		First character not part of the number.
+ */
+template <class N>
+static int lex_number(int c, N next, int base, bool sign) {
+	if(sign && (c == '-' || c == '+'))
+		c = next(c);
+	if(base < 0) {
+		while('0' <= c && c <= '9')
+			c = next(c);
+		if(c == '.') {
+			c = next(c);
+			while('0' <= c && c <= '9')
+				c = next(c);
+		}
+		if(c == 'e' || c == 'E') {
+			c = next(c);
+			if(c == '-' || c == '+')
+				c = next(c);
+			while('0' <= c && c <= '9')
+				c = next(c);
+		}
+		return c;
+	}
+	if(base == 0) {
+		if(c != '0')
+			base = 10;
+		else {
+			c = next(c);
+			if(c == 'x' || c == 'X') {
+				base = 16;
+				c = next(c);
+			}
+			else if(c == 'b' || c == 'B') {
+				base = 2;
+				c = next(c);
+			}
+			else
+				base = 8;
+		}
+	}
+	while(c >= 0 && test_base(c, base) >= 0)
+		c = next(c);
+	return c;
+}
+
+/**
+ * Scan a number. The blanks are skipped, then the characters matching
+ * the syntax of the number (see lex_number()) are consumed and converted.
+ * The same characters are consumed, and the same numbers are accepted,
+ * whether the number is parsed in the window of the stream or read
+ * character by character.
+ * @param x		Scanned number.
+ * @param base	Base of an integer (0 to select it from the prefix),
+ *				ignored for a float.
+ * @return		True if the consumed characters form a valid number, false
+ *				if they are empty, invalid or the number overflows.
+ */
+template <class T>
+bool Input::scanNumber(T& x, int base) {
+	bool sign = std::is_signed<T>::value;
+	if(std::is_floating_point<T>::value)
+		base = -1;
+
+	// fast path
+	const char *b, *e, *p = window(b, e);
+	if(p != nullptr) {
+		const char *q = p;
+		lex_number(*q, [&q, e](int) { q++; return q < e ? int(*q) : -1; }, base, sign);
+		strm->advance(q - b);
+		return convert(p, q, x, base);
+	}
+
+	// character path
+	Vector<char> t;
+	int c = lex_number(skip(), [this, &t](int c) { t.add(char(c)); return get(); }, base, sign);
+	if(c >= 0)
+		back(c);
+	return t && convert(&t[0], &t[0] + t.length(), x, base);
+}
+
+
 /**
  * Scan a based unsigned long, decimal as a default.
  * Supported base prefixes are '0', '0[xX]' or '0[bB]'.
@@ -261,49 +416,12 @@ static inline int test_base(char chr, int base) {
  * @throw IOException	In case of IO error.
  */
 t::uint32 Input::scanULong(int base) {
-	bool one = false;
-	t::uint32 val = 0;
-
-	// Read the base
-	int chr = skip();
-	if(base == 0) {
-		if(chr == '0')
-			switch(chr = get()) {
-			case 'x': case 'X':
-				base = 16;
-				chr = get();
-				break;
-			case 'b': case 'B':
-				base = 2;
-				chr = get();
-				break;
-			default:
-				one = true;
-				base = 8;
-				break;
-			}
-		else
-			base = 10;
-	}
-
-	// read the digits
-	int digit = test_base(chr, base);
-	while(digit >= 0) {
-		t::uint32 old = val;
-		val = val * base + digit;
-		one = true;
-		if(val < old) {
-			state |= FAILED;
-			return 0;
-		}
-		chr = get();
-		digit = test_base(chr, base);
-	}
-	if(chr >= 0)
-		back(chr);
-	if(!one)
+	t::uint64 x;
+	if(!scanNumber(x, base) || x > 0xffffffffUL) {
 		state |= FAILED;
-	return val;
+		return 0;
+	}
+	return x;
 }
 
 
@@ -315,28 +433,12 @@ t::uint32 Input::scanULong(int base) {
  * @throw IOException	In case of IO or format error.
  */
 t::int32 Input::scanLong(int base) {
-	t::uint32 val = 0;
-	bool neg = false;
-
-	// Read sign
-	int chr = skip();
-	if(chr == '-')
-		neg = true;
-	else if(chr != '+') {
-		if(chr < 0) {
-			state |= FAILED;
-			return 0;
-		}
-		back(chr);
-	}
-
-	// get the value
-	val = scanULong(base);
-	if(val >= (1UL << 31)) {
+	t::int64 x;
+	if(!scanNumber(x, base) || x < -(t::int64(1) << 31) || x >= (t::int64(1) << 31)) {
 		state |= FAILED;
 		return 0;
 	}
-	return neg ? -t::int32(val) : val;
+	return x;
 }
 
 
@@ -348,51 +450,12 @@ t::int32 Input::scanLong(int base) {
  * @throw IOException	In case of IO or format error.
  */
 t::uint64 Input::scanULLong(int base) {
-	t::uint64 val = 0;
-	bool one = false;
-
-	// Read the base
-	int chr = skip();
-	if(base == 0) {
-		if(chr == '0')
-			switch(chr = get()) {
-			case 'x': case 'X':
-				base = 16;
-				chr = get();
-				break;
-			case 'b': case 'B':
-				base = 2;
-				chr = get();
-				break;
-			default:
-				base = 8;
-				one = true;
-				break;
-			}
-		else
-			base = 10;
-	}
-
-	// read the digits
-	int digit = test_base(chr, base);
-	while(digit >= 0) {
-		t::uint32 old = val;
-		val = val * base + digit;
-		one = true;
-		if(val < old) {
-			state |= FAILED;
-			return 0;
-		}
-		chr = get();
-		digit = test_base(chr, base);
-	}
-	if(chr >= 0)
-		back(chr);
-	if(!one) {
+	t::uint64 x;
+	if(!scanNumber(x, base)) {
 		state |= FAILED;
 		return 0;
 	}
-	return val;
+	return x;
 }
 
 
@@ -404,97 +467,27 @@ t::uint64 Input::scanULLong(int base) {
  * @throw IOException	In case of IO or format error.
  */
 t::int64 Input::scanLLong(int base) {
-	t::uint64 val = 0;
-	bool neg = false;
-
-	// Read sign
-	int chr = skip();
-	if(chr == '-')
-		neg = true;
-	else if(chr != '+') {
-		if(chr < 0) {
-			state |= FAILED;
-			return 0;
-		}
-		back(chr);
-	}
-
-	// get the value
-	val = scanULLong(base);
-	if(val >= (1ULL << 63)) {
+	t::int64 x;
+	if(!scanNumber(x, base)) {
 		state |= FAILED;
 		return 0;
 	}
-	return neg ? -t::int64(val) : val;
+	return x;
 }
 
 
 /**
- * Scan a floating value.
+ * Scan a floating value. The result is the closest double to the written
+ * number.
  * @return	Read value.
  */
 double Input::scanDouble(void) {
-	double value = 0;
-	bool neg = false;
-	bool one = false;
-
-	// Read sign
-	int chr = skip();
-	if(chr == '-') {
-		neg = true;
-		chr = get();
-	}
-	else if(chr == '+')
-		chr = get();
-
-	// Read integer part
-	while(chr >= '0' && chr <= '9') {
-		value = value * 10 + (chr - '0');
-		one = true;
-		chr = get();
-	}
-
-	// Read decimal part
-	if(chr == '.') {
-		chr = get();
-		double dec = 0.1;
-		while(chr >= '0' && chr <='9') {
-			value += (chr - '0') * dec;
-			dec = dec / 10;
-			one = true;
-			chr = get();
-		}
-	}
-
-	// Read exponent part
-	if(!one) {
+	double x;
+	if(!scanNumber(x, 0)) {
 		state |= FAILED;
 		return 0;
 	}
-	if(chr == 'e' || chr == 'E') {
-		int exp = 0;
-		chr = get();
-		if(chr == '-')
-			chr = get();
-		else if(chr == '+')
-			chr = get();
-		one = false;
-		while(chr >= '0' && chr <= '9') {
-			exp = exp * 10 + (chr - '0');
-			one = true;
-			chr = get();
-		}
-		if(!one) {
-			state |= FAILED;
-			return 0;
-		}
-		value = value * pow(10, exp);
-	}
-
-	// Return result
-	if(chr >= 0)
-		back(chr);
-	return neg ? -value : value;
+	return x;
 }
 
 
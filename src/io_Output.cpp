@@ -27,6 +27,7 @@
 
 #include <elm/io/BufferedOutStream.h>
 #include <elm/io/io.h>
+#include <elm/io/numconv.h>
 #include <elm/io/StringOutput.h>
 #include <elm/io/FileOutput.h>
 #include <elm/compare.h>
@@ -154,27 +155,8 @@ void Output::print(char chr) {
  * @deprecated
  */
 void Output::print(t::int32 value) {
-	char buffer[16];
-	bool neg = false;
-	t::uint32 uval;
-
-	// Process sign
-	if(value < 0) {
-		neg = true;
-		uval = -value;
-	}
-	else
-		uval = value;
-
-	// Write the digits
-	char *p = horner(buffer + sizeof(buffer), uval, 10);
-
-	// Add the sign
-	if(neg)
-		*--p = '-';
-
-	// Write it
-	if(strm->write(p, buffer + sizeof(buffer) - p) < 0)
+	char buffer[int_chars_max];
+	if(strm->write(buffer, toChars(buffer, value) - buffer) < 0)
 		throw IOException(strm->lastErrorMessage());
 }
 
@@ -185,27 +167,8 @@ void Output::print(t::int32 value) {
  * @deprecated
  */
 void Output::print(t::int64 value) {
-	char buffer[64];
-	bool neg = false;
-	t::uint64 uval;
-
-	// Process sign
-	if(value < 0) {
-		neg = true;
-		uval = -value;
-	}
-	else
-		uval = value;
-
-	// Write the digits
-	char *p = horner(buffer + sizeof(buffer), uval, 10);
-
-	// Add the sign
-	if(neg)
-		*--p = '-';
-
-	// Write it
-	if(strm->write(p, buffer + sizeof(buffer) - p) < 0)
+	char buffer[int_chars_max];
+	if(strm->write(buffer, toChars(buffer, value) - buffer) < 0)
 		throw IOException(strm->lastErrorMessage());
 }
 
@@ -216,13 +179,8 @@ void Output::print(t::int64 value) {
  * @deprecated
  */
 void Output::print(t::uint32 value) {
-	char buffer[16];
-
-	// Write the digits
-	char *p = horner(buffer + sizeof(buffer), value, 10);
-
-	// Write it
-	if(strm->write(p, buffer + sizeof(buffer) - p) < 0)
+	char buffer[int_chars_max];
+	if(strm->write(buffer, toChars(buffer, value) - buffer) < 0)
 		throw IOException(strm->lastErrorMessage());
 }
 
@@ -233,26 +191,31 @@ void Output::print(t::uint32 value) {
  * @deprecated
  */
 void Output::print(t::uint64 value) {
-	char buffer[32];
-
-	// Write the digits
-	char *p = horner(buffer + sizeof(buffer), value, 10);
-
-	// Write it
-	if(strm->write(p, buffer + sizeof(buffer) - p) < 0)
+	char buffer[int_chars_max];
+	if(strm->write(buffer, toChars(buffer, value) - buffer) < 0)
 		throw IOException(strm->lastErrorMessage());
 }
 
 
 /**
- * Print a double value.
+ * Print a double value with the shortest digits allowing to read back
+ * the same value (see @ref numconv).
  * @param value	Double value to print.
  */
 void Output::print(double value) {
-	// !!TODO!!
-	char buffer[32];
-	snprintf(buffer, sizeof(buffer), "%g", value);
-	if(strm->write(buffer, strlen(buffer)) < 0)
+	char buffer[float_chars_max];
+	if(strm->write(buffer, toChars(buffer, value) - buffer) < 0)
+		throw IOException(strm->lastErrorMessage());
+}
+
+/**
+ * Print a float value with the shortest digits allowing to read back
+ * the same value (see @ref numconv).
+ * @param value	Float value to print.
+ */
+void Output::print(float value) {
+	char buffer[float_chars_max];
+	if(strm->write(buffer, toChars(buffer, value) - buffer) < 0)
 		throw IOException(strm->lastErrorMessage());
 }
 
@@ -338,13 +301,179 @@ void Output::format(CString fmt, VarArg& args) {
 }
 
 
+/**
+ * @fn void Output::format<F>(const T&... args);
+ * Print the arguments according to a format string parsed at compile time.
+ * F is a type providing the format string with a static constexpr function
+ * str(): it is commonly built by the @ref ELM_FORMAT macro. In the format,
+ * a placeholder "{}" is replaced by the corresponding argument, as
+ * with the operator <<, and "{{" and "}}" stands for single braces.
+ *
+ * A placeholder may also contain a specification
+ * "{:[[fill]align][+][0][width][.precision][type]}", as in Python or C++20
+ * std::format():
+ * @li align -- '<' (left), '>' (right) or '^' (center),
+ * @li + -- display the sign of integers,
+ * @li 0 -- pad numbers with 0 after the sign ("{:05}" of -3 gives "-0003"),
+ * @li precision -- number of decimal digits of a float or maximum number of
+ *	characters of a string,
+ * @li type -- 'd', 'x', 'X', 'b', 'o' for integers, 'f' (decimal), 'e'
+ *	(scientific), 'g' (shortest) for floats, 'c' for characters and 's' for
+ *	strings.
+ * Numbers are aligned to the right and other values to the left by default.
+ * Only integers, floats, characters and strings accept a specification.
+ *
+ * The count of placeholders, their syntax and their compatibility with the type
+ * of the arguments are checked at compile time. At run time, the text
+ * between the placeholders and the arguments are written directly to the
+ * stream without intermediate buffer.
+ *
+ * @param args	Printed arguments.
+ * @throw IOException	If there is a stream error.
+ */
+
+/**
+ * @fn void Output::fmt<S>(const T&... args);
+ * Same as format<F>() but taking directly the format string as template
+ * argument. Only available in C++20:
+ * @code
+ *	cout.fmt<"{} at {:08x}\n">(name, address);
+ * @endcode
+ * @param args	Printed arguments.
+ * @throw IOException	If there is a stream error.
+ */
+
+/**
+ * @def ELM_FORMAT(out, f, ...)
+ * Print a list of arguments to an output according to a format string
+ * parsed at compile time (see Output::format<F>() for the syntax of the
+ * format):
+ * @code
+ *	ELM_FORMAT(cout, "{} at {:08x}\n", name, address);
+ * @endcode
+ * @param out	Output to print to.
+ * @param f		Format string (a string literal).
+ * @param ...	Printed arguments.
+ * @ingroup ios
+ */
+
+
+namespace impl {
+
+// print the text of a format, replacing doubled braces by single ones
+void fmt_text(Output& out, const char *p, int n, bool raw) {
+	OutStream& s = out.stream();
+	if(raw) {
+		if(s.write(p, n) < 0)
+			throw IOException(s.lastErrorMessage());
+		return;
+	}
+	const char *e = p + n;
+	while(p < e) {
+		const char *q = p;
+		while(q < e && *q != '{' && *q != '}')
+			q++;
+		if(q < e)
+			q++;
+		if(s.write(p, q - p) < 0)
+			throw IOException(s.lastErrorMessage());
+		p = q + 1;
+	}
+}
+
+// print a string with a format specification
+void fmt_str(Output& out, const fmt_spec_t& s, const char *p, int n) {
+	if(s.prec >= 0 && n > s.prec)
+		n = s.prec;
+	int b = 0, a = 0;
+	if(s.width > n) {
+		switch(s.align) {
+		case '>':
+		case '=':	b = s.width - n; break;
+		case '^':	b = (s.width - n) / 2; a = s.width - n - b; break;
+		default:	a = s.width - n; break;
+		}
+	}
+	OutStream& o = out.stream();
+	for(int i = 0; i < b; i++)
+		o.write(s.fill);
+	if(o.write(p, n) < 0)
+		throw IOException(o.lastErrorMessage());
+	for(int i = 0; i < a; i++)
+		o.write(s.fill);
+}
+
+// write the digits of x in base 2^shift
+static char *toPow2Chars(char *p, t::uint64 x, int shift) {
+	int n = 1;
+	for(t::uint64 y = x >> shift; y != 0; y >>= shift)
+		n++;
+	for(char *q = p + n; q > p; x >>= shift)
+		*--q = '0' + (x & ((1 << shift) - 1));
+	return p + n;
+}
+
+// print an integer, given by its sign and absolute value, with a format specification
+void fmt_int(Output& out, const fmt_spec_t& s, bool neg, t::uint64 x) {
+	char buf[2 * 256], *p = buf;
+	char d[66], *e;
+	switch(s.type) {
+	case 'x':	e = toHexChars(d, x); break;
+	case 'X':	e = toHexChars(d, x, true); break;
+	case 'b':	e = toPow2Chars(d, x, 1); break;
+	case 'o':	e = toPow2Chars(d, x, 3); break;
+	default:	e = toChars(d, x); break;
+	}
+	char sign = neg ? '-' : s.sign ? '+' : '\0';
+	int n = (e - d) + (sign ? 1 : 0), b = 0, a = 0, z = 0;
+	if(s.width > n) {
+		switch(s.align) {
+		case '<':	a = s.width - n; break;
+		case '^':	b = (s.width - n) / 2; a = s.width - n - b; break;
+		case '=':	z = s.width - n; break;
+		default:	b = s.width - n; break;
+		}
+	}
+	for(; b > 0; b--)
+		*p++ = s.fill;
+	if(sign)
+		*p++ = sign;
+	for(; z > 0; z--)
+		*p++ = s.fill;
+	memcpy(p, d, e - d);
+	p += e - d;
+	for(; a > 0; a--)
+		*p++ = s.fill;
+	OutStream& o = out.stream();
+	if(o.write(buf, p - buf) < 0)
+		throw IOException(o.lastErrorMessage());
+}
+
+// print a float with a format specification
+void fmt_float(Output& out, const fmt_spec_t& s, double x) {
+	int w = s.width;
+	if(s.align == '=' && signbit(x)) {
+		out.print('-');
+		x = -x;
+		if(w > 0)
+			w--;
+	}
+	FloatFormat f(x);
+	f.style(s.type == 'f' ? FloatFormat::DECIMAL : s.type == 'e' ? FloatFormat::SCIENTIFIC : FloatFormat::SHORTEST);
+	f.width(w, s.prec < 0 ? 0 : s.prec).pad(s.fill).align(s.align == '<' ? LEFT : s.align == '^' ? CENTER : RIGHT);
+	out.print(f);
+}
+
+}	// impl
+
+
 /**
  * Print a formatted long value.
  * @param fmt	Formatted value to display.
  */
 void Output::print(const IntFormat& fmt) {
 
-	// To horner
+	// convert the absolute value
 	t::uint64 uval;
 	if(fmt._sign && fmt._val < 0)
 		uval = -fmt._val;
@@ -352,13 +481,26 @@ void Output::print(const IntFormat& fmt) {
 		uval = fmt._val;
 	if(!fmt._sign && fmt._size != 8)
 		uval &= (1ULL << (fmt._size * 8)) - 1;
-	char buffer[33];
-	char *res = horner(buffer + 32, uval, fmt._base, fmt._upper ? 'A' : 'a');
+	char buffer[1 + 64];
+	char *res = buffer + 1, *end;
+	if(fmt._base == 10)
+		end = toChars(res, uval);
+	else if(fmt._base == 16)
+		end = toHexChars(res, uval, fmt._upper);
+	else {
+		end = buffer + sizeof(buffer);
+		res = horner(end, uval, fmt._base, fmt._upper ? 'A' : 'a');
+	}
 	if(fmt._sign && fmt._val < 0)
 		*(--res) = '-';
-        if (fmt._displaySign && fmt._val > 0)
-                *(--res) = '+';
-	int size = buffer + 32 - res;
+	else if(fmt._displaySign && fmt._val > 0)
+		*(--res) = '+';
+	int size = end - res;
+	if(!fmt._width) {
+		if(strm->write(res, size) < 0)
+			throw IOException(strm->lastErrorMessage());
+		return;
+	}
 
 	// Compute pads
 	int lpad = 0, rpad = 0;
@@ -397,12 +539,12 @@ void Output::print(const FloatFormat& fmt) {
 	// %e	[-]d.ddde+/-dd (precision 6)
 	// %f	[-]ddd.ddd (precision 6, if precision 0, no decimal, at least one integer)
 	// %g	f or e (e if e < -4 or e >= precision)
-	char buf[1/*-*/ + 1/*d*/ + 1/*.*/ + fmt._decw + 2/*e[+-]*/ + 3];
 	const char *b;
 	int s;
 	int prec = fmt._decw;
 	if(prec == 0)
 		prec = 6;
+	char buf[1/*-*/ + 1/*d*/ + 1/*.*/ + prec + 2/*e[+-]*/ + 3];
 
 	// simple special case
 	double x = fmt._val;
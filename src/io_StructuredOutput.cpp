@@ -48,6 +48,8 @@ namespace elm { namespace io {
  * 
  * This interface is currently implemented by:
  *	* elm::json::Saver
+ *	* elm::json::CBORSaver
+ *	* elm::json::MessagePackSaver
  *
  * @ingroup io
  */
@@ -19,10 +19,16 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <elm/io/numconv.h>
 #include <elm/json.h>
 #include <elm/string/utf8.h>
 #include <elm/sys/System.h>
 
+#if defined(__GNUC__) && defined(__SSE2__)
+#	define ELM_SAVER_SSE2
+#	include <emmintrin.h>
+#endif
+
 namespace elm { namespace json {
 
 /**
@@ -40,38 +46,107 @@ namespace elm { namespace json {
  * anded by endObject(). An array is made of several values (possibly of different types), is started
  * by beginArray() and ended by endArray().
  *
+ * The output is written directly in the buffer of an io::BufferedOutStream
+ * whose size may be given to the constructors (64 Kb by default): the output
+ * is only complete after a call to close(), or the destruction of the saver.
+ * The output to a StringBuffer is written directly in the string buffer
+ * and is complete at any time. By default, the output is compact,
+ * without spaces nor indentation; setReadable() enables the pretty-printing.
+ * The strings are escaped with a lookup table, the runs of characters not
+ * requiring escape being found 16 bytes at a time with SSE2 instructions when
+ * available and copied in bulk. The numbers are converted with io::toChars().
  */
 
+// minimal buffer size (enough for any number or escape sequence)
+static const int min_buffer_size = 64;
+
+// escape of ASCII characters: 0 if not required, 'u' for an \uXXXX escape,
+// else the character following the backslash
+static const char escapes[128] = {
+	'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+	'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+	0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+// find the first character requiring escape (or e)
+static inline const char *plain(const char *p, const char *e) {
+#	ifdef ELM_SAVER_SSE2
+		const __m128i space = _mm_set1_epi8(' '), quote = _mm_set1_epi8('"'), bs = _mm_set1_epi8('\\');
+		for(; e - p >= 16; p += 16) {
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+			// signed comparison: control and non-ASCII characters are below the space
+			__m128i m = _mm_or_si128(_mm_cmplt_epi8(b, space),
+				_mm_or_si128(_mm_cmpeq_epi8(b, quote), _mm_cmpeq_epi8(b, bs)));
+			int r = _mm_movemask_epi8(m);
+			if(r)
+				return p + __builtin_ctz(r);
+		}
+#	endif
+	while(p < e && t::uint8(*p) < 0x80 && escapes[t::uint8(*p)] == 0)
+		p++;
+	return p;
+}
+
+// write an \uXXXX escape
+static inline char *hex(char *q, utf8::char_t c) {
+	static const char digits[] = "0123456789abcdef";
+	q[0] = '\\';
+	q[1] = 'u';
+	q[2] = digits[(c >> 12) & 0xf];
+	q[3] = digits[(c >> 8) & 0xf];
+	q[4] = digits[(c >> 4) & 0xf];
+	q[5] = digits[c & 0xf];
+	return q + 6;
+}
+
 /**
+ * Build a saver writing to the given stream.
+ * @param out			Output stream.
+ * @param buffer_size	Size of the output buffer.
  */
-Saver::Saver(io::OutStream& out)
-: state(BEGIN), readable(false), indent("\t"), buf(0), str(0) {
-	buf = new io::BufferedOutStream(out);
-	_out.setStream(*buf);
+Saver::Saver(io::OutStream& out, int buffer_size)
+: state(BEGIN), readable(false), indent("\t"), buf(0), blk(0), str(0) {
+	buf = new io::BufferedOutStream(out, max(buffer_size, min_buffer_size));
 }
 
 /**
+ * Build a saver writing to the given string buffer. The output is written
+ * directly in the string buffer, without intermediate buffer: the string
+ * buffer is up to date after each call to the saver.
+ * @param sbuf			String buffer.
+ * @param buffer_size	Ignored.
  */
-Saver::Saver(StringBuffer& sbuf)
-: state(BEGIN), readable(false), indent("\t"), buf(0), str(0) {
-	_out.setStream(sbuf.stream());
+Saver::Saver(StringBuffer& sbuf, int buffer_size)
+: state(BEGIN), readable(false), indent("\t"), buf(0), blk(&sbuf.stream()), str(0) {
 }
 
 /**
+ * Build a saver writing to the given file.
+ * @param path			File path.
+ * @param buffer_size	Size of the output buffer.
  */
-Saver::Saver(sys::Path& path)
-: state(BEGIN), readable(false), indent("\t"), buf(0), str(0) {
+Saver::Saver(sys::Path& path, int buffer_size)
+: state(BEGIN), readable(false), indent("\t"), buf(0), blk(0), str(0) {
 	str = sys::System::createFile(path);
-	buf = new io::BufferedOutStream(*str);
-	_out.setStream(*buf);
+	buf = new io::BufferedOutStream(*str, max(buffer_size, min_buffer_size));
 }
 
 /**
+ * Close the output if not done: the output errors are then ignored
+ * (call close() to catch them).
  */
 Saver::~Saver(void) {
-	close();
-	if(buf)
-		delete buf;
+	try {
+		close();
+	}
+	catch(io::IOException& e) {
+	}
+	delete buf;
 	if(str)
 		delete str;
 }
@@ -104,9 +179,11 @@ void Saver::nextByValue() {
 
 /**
  * Close the JSON output.
+ * @throw io::IOException	If the output fails.
  */
 void Saver::close(void) {
-	_out.flush();
+	if(buf != nullptr && buf->flush() < 0)
+		failed();
 }
 
 /**
@@ -140,11 +217,11 @@ void Saver::close(void) {
  */
 void Saver::doIndent(bool close) {
 	if(!close && (state == IN_ARRAY || state == IN_OBJECT))
-		_out << ",";
+		emit(',');
 	if(readable && state != FIELD) {
-		_out << io::endl;
+		emit('\n');
 		for(int i = 0; i < stack.length(); i++)
-			_out << indent;
+			emit(indent.chars(), indent.length());
 	}
 }
 
@@ -188,7 +265,7 @@ void Saver::beginMap(void) {
 	ASSERTP(state != END, "json: ended output!");
 	ASSERTP(!isObject(state), "json: object creation only allowed in a field or an array");
 	doIndent();
-	_out << "{";
+	emit('{');
 	if(isArray(state))
 		stack.push(state);
 	state = OBJECT;
@@ -204,7 +281,7 @@ void Saver::endMap(void) {
 	else
 		state = next(stack.pop());
 	doIndent(true);
-	_out << "}";
+	emit('}');
 }
 
 /**
@@ -214,7 +291,7 @@ void Saver::beginList(void) {
 	ASSERTP(state != END, "json: ended output!");
 	ASSERTP(state == FIELD || isArray(state), "json: array only allowed in a field or in an array");
 	doIndent();
-	_out << "[";
+	emit('[');
 	if(state != FIELD)
 		stack.push(state);
 	state = ARRAY;
@@ -228,7 +305,7 @@ void Saver::endList(void) {
 	state_t new_state = next(stack.pop());
 	state = ARRAY;
 	doIndent(true);
-	_out << "]";
+	emit(']');
 	state = new_state;
 }
 
@@ -238,19 +315,18 @@ void Saver::endList(void) {
 void Saver::key(const string& id) {
 	ASSERTP(isObject(state), "json: field only allowed inside an object!");
 	doIndent();
-	_out << '"';
+	emit('"');
 	try {
-		for(utf8::Iter i(id); i(); i++)
-			escape(*i);
+		escape(id.chars(), id.length());
 	}
 	catch(utf8::Exception& e) {
 		ASSERTP(false, _ << "json: bad utf8 string: \"" << id << "\"");
 	}
-	_out << '"';
+	emit('"');
 	if(isReadable())
-		_out << ": ";
+		emit(": ", 2);
 	else
-		_out << ":";
+		emit(':');
 	stack.push(state);
 	state = FIELD;
 }
@@ -261,44 +337,100 @@ void Saver::key(const string& id) {
 void Saver::key(cstring id) {
 	ASSERTP(isObject(state), "json: field only allowed inside an object!");
 	doIndent();
-	_out << '"';
+	emit('"');
 	try {
-		for(utf8::Iter i(id); i(); i++)
-			escape(*i);
+		escape(id.chars(), id.length());
 	}
 	catch(utf8::Exception& e) {
 		ASSERTP(false, _ << "json: bad utf8 string: \"" << id << "\"");
 	}
-	_out << '"';
+	emit('"');
 	if(isReadable())
-		_out << ": ";
+		emit(": ", 2);
 	else
-		_out << ":";
+		emit(':');
 	stack.push(state);
 	state = FIELD;
 }
 
+/**
+ * Write a UTF-8 string, escaping the characters if required. The string
+ * is first validated in one pass (see utf8::validate()); then the runs of
+ * characters not requiring escape are looked for (16 bytes at a time with
+ * SSE2) and copied as is.
+ * @param p		String base.
+ * @param n		String length.
+ * @throw utf8::Exception	If the string is not valid UTF-8.
+ */
+void Saver::escape(const char *p, int n) {
+	if(!utf8::validate(p, n))
+		throw utf8::Exception("utf8: bad encoding");
+	const char *e = p + n;
+	while(p < e) {
+		const char *s = p;
+		p = plain(p, e);
+		if(p != s)
+			emit(s, p - s);
+		if(p < e) {
+			if(t::uint8(*p) < 0x80)
+				escape(utf8::char_t(*p++));
+			else
+				escape(utf8::decode(p));
+		}
+	}
+}
+
+
 /**
  * Escape the given character if required.
  * @param c		Character to escape.
- * @return		Empty string if escape if not useful, escaped string else.
  */
 void Saver::escape(utf8::char_t c) {
-	switch(c) {
-	case '"' :	_out << "\\\""; break;
-	case '\\':	_out << "\\\\"; break;
-	case '\b':	_out << "\\b";  break;
-	case '\f':	_out << "\\f";  break;
-	case '\n':	_out << "\\n";  break;
-	case '\r':	_out << "\\r";  break;
-	case '\t':	_out << "\\t";  break;
-	default:
-		if(c >= 32 && c < 128)
-			_out << char(c);
-		else
-			_out << "\\u" << io::fmt(c).hex().width(4).pad('0').right();
-		break;
+	char *q = reserve(12);
+	if(c < 0x80 && escapes[c] == 0)
+		*q++ = c;
+	else if(c < 0x80 && escapes[c] != 'u') {
+		q[0] = '\\';
+		q[1] = escapes[c];
+		q += 2;
+	}
+	else if(c < 0x10000)
+		q = hex(q, c);
+	else {
+		c -= 0x10000;
+		q = hex(hex(q, 0xd800 | (c >> 10)), 0xdc00 | (c & 0x3ff));
 	}
+	commit(q);
+}
+
+
+// write a string without escaping it
+void Saver::emit(const char *s, int n) {
+	if(n <= 16) {
+		char *q = reserve(n);
+		memcpy(q, s, n);
+		commit(q + n);
+	}
+	else if(blk != nullptr)
+		blk->write(s, n);
+	else if(buf->write(s, n) < 0)
+		failed();
+}
+
+
+// write a number
+template <class T>
+void Saver::number(T x) {
+	doIndent();
+	nextByValue();
+	char *q = reserve(io::float_chars_max);
+	commit(io::toChars(q, x));
+}
+
+
+// raise an exception for a failed write
+void Saver::failed(void) {
+	throw io::IOException(buf->lastErrorMessage());
 }
 
 /**
@@ -307,7 +439,7 @@ void Saver::escape(utf8::char_t c) {
 void Saver::put(void) {
 	ASSERTP(state == FIELD || isArray(state), "json: cannot put a value out of a field or an array!");
 	doIndent();
-	_out << "null";
+	emit("null", 4);
 	if(state == FIELD)
 		state = stack.pop();
 	state = next(state);
@@ -321,9 +453,9 @@ void Saver::write(bool val) {
 	ASSERTP(state == FIELD || isArray(state), "json: cannot put a value out of a field or an array!");
 	doIndent();
 	if(val)
-		_out << "true";
+		emit("true", 4);
 	else
-		_out << "false";
+		emit("false", 5);
 	if(state == FIELD)
 		state = stack.pop();
 	state = next(state);
@@ -337,9 +469,9 @@ void Saver::write(bool val) {
 void Saver::write(char c) {
 	ASSERTP(state == FIELD || isArray(state), "json: cannot put a value out of a field or an array!");
 	doIndent();
-	_out << '"';
+	emit('"');
 	escape(c);
-	_out << '"';
+	emit('"');
 	if(state == FIELD)
 		state = stack.pop();
 	state = next(state);
@@ -360,10 +492,9 @@ void Saver::write(const char *str) {
 void Saver::write(cstring str) {
 	ASSERTP(state == FIELD || isArray(state), "json: cannot put a value out of a field or an array!");
 	doIndent();
-	_out << '"';
-	for(utf8::Iter i(str); i(); i++)
-		escape(*i);
-	_out << '"';
+	emit('"');
+	escape(str.chars(), str.length());
+	emit('"');
 	if(state == FIELD)
 		state = stack.pop();
 	state = next(state);
@@ -376,52 +507,51 @@ void Saver::write(cstring str) {
 void Saver::write(const string& val) {
 	ASSERTP(state == FIELD || isArray(state), "json: cannot put a value out of a field or an array!");
 	doIndent();
-	_out << '"';
-	for(utf8::Iter i(val); i(); i++)
-		escape(*i);
-	_out << '"';
+	emit('"');
+	escape(val.chars(), val.length());
+	emit('"');
 	if(state == FIELD)
 		state = stack.pop();
 	state = next(state);
 }
 
 ///
-void Saver::write(signed char x) { doIndent(); nextByValue(); _out << x; }
+void Saver::write(signed char x) { number(t::int32(x)); }
 
 ///
-void Saver::write(unsigned char x) { doIndent(); nextByValue(); _out << x; }
+void Saver::write(unsigned char x) { number(t::uint32(x)); }
 
 ///
-void Saver::write(signed short x) { doIndent(); nextByValue(); _out << x; }
+void Saver::write(signed short x) { number(t::int32(x)); }
 
 ///
-void Saver::write(unsigned short x) { doIndent(); nextByValue(); _out << x; }
+void Saver::write(unsigned short x) { number(t::uint32(x)); }
 
 ///
-void Saver::write(signed int x) { doIndent(); nextByValue(); _out << x; }
+void Saver::write(signed int x) { number(t::int32(x)); }
 
 ///
-void Saver::write(unsigned int x) { doIndent(); nextByValue(); _out << x; }
+void Saver::write(unsigned int x) { number(t::uint32(x)); }
 
 ///
-void Saver::write(signed long x) { doIndent(); nextByValue(); _out << x; }
+void Saver::write(signed long x) { number(t::int64(x)); }
 
 ///
-void Saver::write(unsigned long x) { doIndent(); nextByValue(); _out << x; }
+void Saver::write(unsigned long x) { number(t::uint64(x)); }
 
 ///
-void Saver::write(signed long long x) { doIndent(); nextByValue(); _out << x; }
+void Saver::write(signed long long x) { number(t::int64(x)); }
 
 ///
-void Saver::write(unsigned long long x) { doIndent(); nextByValue(); _out << x; }
+void Saver::write(unsigned long long x) { number(t::uint64(x)); }
 
 ///
-void Saver::write(float x) { doIndent(); nextByValue(); _out << x; }
+void Saver::write(float x) { number(float(x)); }
 
 ///
-void Saver::write(double x) { doIndent(); nextByValue(); _out << x; }
+void Saver::write(double x) { number(double(x)); }
 
 ///
-void Saver::write(long double x) { doIndent(); nextByValue(); _out << x; }
+void Saver::write(long double x) { number(double(x)); }
 
 } }		// json
@@ -0,0 +1,458 @@
+/*
+ *	json::BinarySaver and json::BinaryParser classes implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2016, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/io/BlockInStream.h>
+#include <elm/io/BufferedInStream.h>
+#include <elm/json/Binary.h>
+#include <elm/string/StringBuffer.h>
+#include <elm/string/utf8.h>
+#include <elm/sys/System.h>
+
+namespace elm { namespace json {
+
+/**
+ * @class BinarySaver
+ * Common implementation of the savers of binary JSON formats (see
+ * @ref CBORSaver and @ref MessagePackSaver). It maps the @ref io::StructuredOutput
+ * interface on a few encoding functions and provides the output buffer of
+ * the encoded bytes, written to the stream when the format allows it (at the
+ * latest, when close() is called).
+ *
+ * As for @ref Saver, the strings and the keys must be encoded in UTF-8: else
+ * an utf8::Exception is raised.
+ *
+ * @ingroup json
+ */
+
+/**
+ * Build a saver writing to the given stream.
+ * @param out	Output stream.
+ */
+BinarySaver::BinarySaver(io::OutStream& out)
+:	buf(new char[flush_size]),
+	top(0),
+	cap(flush_size),
+	out(&out),
+	file(nullptr)
+{ }
+
+/**
+ * Build a saver writing to the given string buffer.
+ * @param sbuf	String buffer.
+ */
+BinarySaver::BinarySaver(StringBuffer& sbuf)
+:	buf(new char[flush_size]),
+	top(0),
+	cap(flush_size),
+	out(&sbuf.stream()),
+	file(nullptr)
+{ }
+
+/**
+ * Build a saver writing to the given file.
+ * @param path	File path.
+ */
+BinarySaver::BinarySaver(sys::Path& path)
+:	buf(new char[flush_size]),
+	top(0),
+	cap(flush_size),
+	out(nullptr),
+	file(sys::System::createFile(path))
+{
+	out = file;
+}
+
+/**
+ */
+BinarySaver::~BinarySaver(void) {
+	close();
+	delete [] buf;
+	if(file)
+		delete file;
+}
+
+
+/**
+ * Write the encoded bytes to the output stream.
+ * @throw io::IOException	If there is a stream error.
+ */
+void BinarySaver::close(void) {
+	flush();
+	if(out->flush() < 0)
+		throw io::IOException(out->lastErrorMessage());
+}
+
+/**
+ * @fn void BinarySaver::put(void);
+ * Write a null value.
+ */
+
+
+// write the buffer to the stream
+void BinarySaver::flush(void) {
+	for(t::size i = 0; i < top; ) {
+		int n = top - i < (1 << 30) ? int(top - i) : (1 << 30);
+		if(out->write(buf + i, n) < 0)
+			throw io::IOException(out->lastErrorMessage());
+		i += n;
+	}
+	top = 0;
+}
+
+
+// make room for n more bytes, flushing the buffer if possible
+void BinarySaver::grow(t::size n) {
+	if(top != 0 && flushable()) {
+		flush();
+		if(cap >= n)
+			return;
+	}
+	t::size c = cap * 2;
+	if(c < top + n)
+		c = top + n;
+	char *nbuf = new char[c];
+	memcpy(nbuf, buf, top);
+	delete [] buf;
+	buf = nbuf;
+	cap = c;
+}
+
+
+// check the UTF-8 encoding of a string
+void BinarySaver::check(const char *p, int n) {
+	if(!utf8::validate(p, n))
+		throw utf8::Exception("utf8: bad encoding");
+}
+
+
+///
+void BinarySaver::write(bool x) { writeBool(x); }
+
+/**
+ * Write a character as a string of one character.
+ * @param c		Character to write.
+ */
+void BinarySaver::write(char c) { check(&c, 1); writeString(&c, 1); }
+
+///
+void BinarySaver::write(signed char x) { writeInt(x); }
+
+///
+void BinarySaver::write(unsigned char x) { writeUInt(x); }
+
+///
+void BinarySaver::write(short x) { writeInt(x); }
+
+///
+void BinarySaver::write(unsigned short x) { writeUInt(x); }
+
+///
+void BinarySaver::write(int x) { writeInt(x); }
+
+///
+void BinarySaver::write(unsigned int x) { writeUInt(x); }
+
+///
+void BinarySaver::write(long x) { writeInt(x); }
+
+///
+void BinarySaver::write(unsigned long x) { writeUInt(x); }
+
+///
+void BinarySaver::write(long long int x) { writeInt(x); }
+
+///
+void BinarySaver::write(long long unsigned int x) { writeUInt(x); }
+
+///
+void BinarySaver::write(float x) { writeFloat(x); }
+
+///
+void BinarySaver::write(double x) { writeDouble(x); }
+
+///
+void BinarySaver::write(long double x) { writeDouble(double(x)); }
+
+///
+void BinarySaver::write(const char *s) { write(cstring(s)); }
+
+///
+void BinarySaver::write(cstring x) { check(x.chars(), x.length()); writeString(x.chars(), x.length()); }
+
+///
+void BinarySaver::write(const string& x) { check(x.chars(), x.length()); writeString(x.chars(), x.length()); }
+
+///
+void BinarySaver::key(cstring x) { check(x.chars(), x.length()); writeKey(x.chars(), x.length()); }
+
+///
+void BinarySaver::key(const string& x) { check(x.chars(), x.length()); writeKey(x.chars(), x.length()); }
+
+
+/**
+ * @class BinaryParser
+ * Common implementation of the parsers of binary JSON formats (see
+ * @ref CBORParser and @ref MessagePackParser). As the JSON @ref Parser,
+ * they call the functions of a @ref Maker for each found entity: a parser
+ * can be replaced by another one without changing the maker.
+ *
+ * As the JSON parser, the integers not fitting an int are passed to
+ * Maker::onValue(t::int64) and the unsigned integers beyond the t::int64
+ * range as double.
+ * The keys of the maps must be strings.
+ *
+ * The input is read through the window of the stream (see io::InStream::peek()):
+ * when parsed from a string, the strings passed to the maker are shared with
+ * the parsed string and not copied.
+ *
+ * @ingroup json
+ */
+
+/**
+ * Build a binary parser.
+ * @param maker		Maker to use.
+ */
+BinaryParser::BinaryParser(Maker& maker)
+:	m(maker),
+	in(nullptr),
+	b(nullptr),
+	p(nullptr),
+	e(nullptr),
+	off(0),
+	symbols(false)
+{ }
+
+/**
+ */
+BinaryParser::~BinaryParser(void) {
+}
+
+
+/**
+ * Parse the encoded bytes contained in a string.
+ * @param data	Encoded bytes.
+ * @throw json::Exception	If the encoding is not valid.
+ */
+void BinaryParser::parse(string data) {
+	src = data;
+	io::BlockInStream in(src.chars(), src.length());
+	doParsing(in);
+	src = "";
+}
+
+/**
+ * Parse from an input stream.
+ * @param in	Input stream to use.
+ * @throw json::Exception	If the encoding is not valid.
+ */
+void BinaryParser::parse(io::InStream& in) {
+	try {
+		const char *w;
+		if(in.peek(w) != io::InStream::UNBUFFERED)
+			doParsing(in);
+		else {
+			io::BufferedInStream buf(in, Parser::buffer_size);
+			doParsing(buf);
+		}
+	}
+	catch(io::IOException& e) {
+		throw json::Exception(e.message());
+	}
+}
+
+/**
+ * Parse from a file.
+ * @param path	File path.
+ * @throw json::Exception	If the encoding is not valid or if there is
+ *							a file error.
+ */
+void BinaryParser::parse(sys::Path path) {
+	try {
+		io::InStream *file = sys::System::readFile(path);
+		try {
+			parse(*file);
+			delete file;
+		}
+		catch(json::Exception& e) {
+			delete file;
+			throw;
+		}
+	}
+	catch(sys::SystemException& e) {
+		throw json::Exception(e.message());
+	}
+}
+
+/**
+ * @fn bool BinaryParser::interns(void) const;
+ * Test if the field names are interned (see @ref Parser::interns()).
+ * @return	True if the field names are interned.
+ */
+
+/**
+ * @fn void BinaryParser::setInterning(bool interning);
+ * Select the interning of the field names (see @ref Parser::setInterning()).
+ * @param interning	True to intern the field names.
+ */
+
+/**
+ * @fn void BinaryParser::parseValue(void);
+ * Parse an encoded value, calling the maker.
+ */
+
+
+// parse a whole value from the window of s
+void BinaryParser::doParsing(io::InStream& s) {
+	in = &s;
+	b = p = e = nullptr;
+	off = 0;
+	refill();
+	parseValue();
+	in->advance(p - b);
+	in = nullptr;
+}
+
+
+// get the next window of the input stream
+bool BinaryParser::refill(void) {
+	in->advance(e - b);
+	off += e - b;
+	int n = in->peek(b);
+	if(n == io::InStream::FAILED)
+		error(in->lastErrorMessage());
+	ASSERT(n != io::InStream::UNBUFFERED);
+	if(n <= 0) {
+		b = p = e;
+		return false;
+	}
+	p = b;
+	e = b + n;
+	return true;
+}
+
+
+// get a new window or raise an error
+void BinaryParser::more(void) {
+	if(!refill())
+		error("unexpected end of data");
+}
+
+
+// get n bytes (at most 8) crossing the end of the window
+const t::uint8 *BinaryParser::split(int n) {
+	ASSERT(n <= int(sizeof(scratch)));
+	for(int i = 0; i < n; ) {
+		if(p == e)
+			more();
+		int k = e - p < n - i ? int(e - p) : n - i;
+		memcpy(scratch + i, p, k);
+		p += k;
+		i += k;
+	}
+	return reinterpret_cast<const t::uint8 *>(scratch);
+}
+
+
+/**
+ * Get the next n bytes as a string.
+ * @param n		Byte count.
+ * @param utf8	True to check the UTF-8 encoding of the string.
+ * @return		Got string.
+ */
+string BinaryParser::text(t::uint64 n, bool utf8) {
+	string r;
+	if(n <= t::uint64(e - p)) {
+		if(src)
+			r = src.substring(p - src.chars(), int(n));
+		else
+			r = string(p, int(n));
+		p += n;
+	}
+	else {
+		if(n > (t::uint64(1) << 31) - 1)
+			error("string too long");
+		StringBuffer buf;
+		while(n != 0) {
+			if(p == e)
+				more();
+			int k = t::uint64(e - p) < n ? int(e - p) : int(n);
+			buf.stream().write(p, k);
+			p += k;
+			n -= k;
+		}
+		r = buf.toString();
+	}
+	if(utf8 && !utf8::validate(r.chars(), r.length()))
+		error("bad UTF-8 encoding in string");
+	return r;
+}
+
+
+/**
+ * Get a field name of n bytes and pass it to the maker.
+ * @param n		Byte count.
+ */
+void BinaryParser::field(t::uint64 n) {
+	string k = text(n);
+	if(symbols)
+		m.onFieldSymbol(k);
+	else
+		m.onField(k);
+}
+
+
+/**
+ * Pass a signed integer to the maker (as a t::int64 if it does not fit an int).
+ * @param x		Integer to pass.
+ */
+void BinaryParser::onInt(t::int64 x) {
+	if(x >= type_info<int>::min && x <= type_info<int>::max)
+		m.onValue(int(x));
+	else
+		m.onValue(x);
+}
+
+
+/**
+ * Pass an unsigned integer to the maker (as a t::int64 if it does not fit
+ * an int and as a double if it does not fit a t::int64).
+ * @param x		Integer to pass.
+ */
+void BinaryParser::onUInt(t::uint64 x) {
+	if(x <= t::uint64(type_info<int>::max))
+		m.onValue(int(x));
+	else if(x <= t::uint64(type_info<t::int64>::max))
+		m.onValue(t::int64(x));
+	else
+		m.onValue(double(x));
+}
+
+
+/**
+ * Raise an error at the current position.
+ * @param message	Error message.
+ * @throw json::Exception	Always.
+ */
+void BinaryParser::error(string message) {
+	throw json::Exception(_ << "offset " << (off + (p - b)) << ": " << message);
+}
+
+} }		// elm::json
@@ -0,0 +1,325 @@
+/*
+ *	json::CBORSaver and json::CBORParser classes implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2016, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <math.h>
+#include <elm/json/CBOR.h>
+#include <elm/string/StringBuffer.h>
+
+namespace elm { namespace json {
+
+// major types
+static const int UNSIGNED = 0, NEGATIVE = 1, BYTES = 2, TEXT = 3,
+	ARRAY = 4, MAP = 5, TAG = 6, SIMPLE = 7;
+
+// initial bytes of the simple values
+static const t::uint8
+	FALSE_ITEM = 0xf4, TRUE_ITEM = 0xf5, NULL_ITEM = 0xf6, UNDEFINED_ITEM = 0xf7,
+	HALF_ITEM = 0xf9, FLOAT_ITEM = 0xfa, DOUBLE_ITEM = 0xfb, BREAK_ITEM = 0xff;
+
+// additional information of the indefinite lengths
+static const int INDEFINITE = 31;
+
+/**
+ * @class CBORSaver
+ * Saver producing CBOR (Concise Binary Object Representation, RFC 8949)
+ * through the @ref io::StructuredOutput interface: it can replace a JSON
+ * @ref Saver without changing the code producing the output. The output is
+ * read back by a @ref CBORParser.
+ *
+ * The maps and the lists are encoded with an indefinite length so that
+ * the output is streamed without buffering the containers. The integers
+ * use the shortest encoding and the double values exactly representable
+ * as a float are encoded as floats.
+ *
+ * @ingroup json
+ */
+
+/**
+ */
+CBORSaver::~CBORSaver(void) {
+	close();
+}
+
+///
+void CBORSaver::put(void) { emit(NULL_ITEM); }
+
+///
+void CBORSaver::beginMap() { emit((MAP << 5) | INDEFINITE); }
+
+///
+void CBORSaver::endMap() { emit(BREAK_ITEM); }
+
+///
+void CBORSaver::beginList() { emit((ARRAY << 5) | INDEFINITE); }
+
+///
+void CBORSaver::endList() { emit(BREAK_ITEM); }
+
+///
+bool CBORSaver::flushable(void) { return true; }
+
+///
+void CBORSaver::writeBool(bool x) { emit(x ? TRUE_ITEM : FALSE_ITEM); }
+
+///
+void CBORSaver::writeInt(t::int64 x) {
+	if(x >= 0)
+		head(UNSIGNED, x);
+	else
+		head(NEGATIVE, ~t::uint64(x));
+}
+
+///
+void CBORSaver::writeUInt(t::uint64 x) { head(UNSIGNED, x); }
+
+///
+void CBORSaver::writeFloat(float x) {
+	t::uint32 b;
+	memcpy(&b, &x, sizeof(b));
+	char *q = reserve(5);
+	q[0] = FLOAT_ITEM;
+	store(q + 1, b, 4);
+}
+
+///
+void CBORSaver::writeDouble(double x) {
+	if(double(float(x)) == x)
+		writeFloat(float(x));
+	else {
+		t::uint64 b;
+		memcpy(&b, &x, sizeof(b));
+		char *q = reserve(9);
+		q[0] = DOUBLE_ITEM;
+		store(q + 1, b, 8);
+	}
+}
+
+///
+void CBORSaver::writeString(const char *s, int n) {
+	head(TEXT, n);
+	emit(s, n);
+}
+
+///
+void CBORSaver::writeKey(const char *s, int n) {
+	head(TEXT, n);
+	emit(s, n);
+}
+
+
+// write the initial byte and the argument of an item
+void CBORSaver::head(int major, t::uint64 x) {
+	t::uint8 m = major << 5;
+	if(x < 24)
+		emit(m | x);
+	else if(x < 0x100) {
+		char *q = reserve(2);
+		q[0] = m | 24;
+		q[1] = x;
+	}
+	else if(x < 0x10000) {
+		char *q = reserve(3);
+		q[0] = m | 25;
+		store(q + 1, x, 2);
+	}
+	else if(x < 0x100000000ULL) {
+		char *q = reserve(5);
+		q[0] = m | 26;
+		store(q + 1, x, 4);
+	}
+	else {
+		char *q = reserve(9);
+		q[0] = m | 27;
+		store(q + 1, x, 8);
+	}
+}
+
+
+/**
+ * @class CBORParser
+ * Parser of CBOR (RFC 8949) calling a @ref Maker for each found entity, as the
+ * JSON @ref Parser does. Definite and indefinite lengths are supported.
+ * The byte strings are passed as strings, the tags are ignored and the
+ * undefined value is passed as null. The other simple values raise an error.
+ *
+ * @ingroup json
+ */
+
+// get the argument of an item
+t::uint64 CBORParser::argument(int info) {
+	if(info < 24)
+		return info;
+	switch(info) {
+	case 24:	return get();
+	case 25:	return load(take(2), 2);
+	case 26:	return load(take(4), 4);
+	case 27:	return load(take(8), 8);
+	default:	error("bad argument"); return 0;
+	}
+}
+
+
+// test if the next byte is a break (and consume it)
+bool CBORParser::isBreak(void) {
+	if(get() == BREAK_ITEM)
+		return true;
+	else {
+		unget();
+		return false;
+	}
+}
+
+
+// get an indefinite-length string made of chunks
+string CBORParser::chunks(int major) {
+	StringBuffer buf;
+	while(!isBreak()) {
+		t::uint8 c = get();
+		if((c >> 5) != major || (c & 31) == INDEFINITE)
+			error("bad string chunk");
+		string s = text(argument(c & 31), major == TEXT);
+		buf << s;
+	}
+	return buf.toString();
+}
+
+
+///
+void CBORParser::parseValue(void) {
+	t::uint8 c = get();
+	int major = c >> 5, info = c & 31;
+
+	// simple values and floats
+	if(major == SIMPLE) {
+		switch(c) {
+		case FALSE_ITEM:		m.onValue(false); break;
+		case TRUE_ITEM:			m.onValue(true); break;
+		case NULL_ITEM:
+		case UNDEFINED_ITEM:	m.onNull(); break;
+		case HALF_ITEM: {
+				int h = load(take(2), 2);
+				int exp = (h >> 10) & 0x1f, mant = h & 0x3ff;
+				double x;
+				if(exp == 0)
+					x = ldexp(mant, -24);
+				else if(exp != 31)
+					x = ldexp(mant + 1024, exp - 25);
+				else
+					x = mant == 0 ? INFINITY : NAN;
+				m.onValue(h & 0x8000 ? -x : x);
+			}
+			break;
+		case FLOAT_ITEM: {
+				t::uint32 b = load(take(4), 4);
+				float x;
+				memcpy(&x, &b, sizeof(x));
+				m.onValue(double(x));
+			}
+			break;
+		case DOUBLE_ITEM: {
+				t::uint64 b = load(take(8), 8);
+				double x;
+				memcpy(&x, &b, sizeof(x));
+				m.onValue(x);
+			}
+			break;
+		case BREAK_ITEM:		error("unexpected break"); break;
+		default:				error("unsupported simple value"); break;
+		}
+		return;
+	}
+
+	// indefinite lengths
+	if(info == INDEFINITE) {
+		switch(major) {
+		case BYTES:
+		case TEXT:
+			m.onValue(chunks(major));
+			break;
+		case ARRAY:
+			m.beginArray();
+			while(!isBreak())
+				parseValue();
+			m.endArray();
+			break;
+		case MAP:
+			m.beginObject();
+			while(!isBreak()) {
+				t::uint8 k = get();
+				if((k >> 5) != TEXT)
+					error("expected field name here");
+				if((k & 31) != INDEFINITE)
+					field(argument(k & 31));
+				else if(interns())
+					m.onFieldSymbol(chunks(TEXT));
+				else
+					m.onField(chunks(TEXT));
+				parseValue();
+			}
+			m.endObject();
+			break;
+		default:
+			error("bad indefinite length");
+			break;
+		}
+		return;
+	}
+
+	// other items
+	t::uint64 x = argument(info);
+	switch(major) {
+	case UNSIGNED:
+		onUInt(x);
+		break;
+	case NEGATIVE:
+		if(x <= t::uint64(type_info<t::int64>::max))
+			onInt(-1 - t::int64(x));
+		else
+			m.onValue(-1. - double(x));
+		break;
+	case BYTES:
+	case TEXT:
+		m.onValue(text(x, major == TEXT));
+		break;
+	case ARRAY:
+		m.beginArray();
+		for(t::uint64 i = 0; i < x; i++)
+			parseValue();
+		m.endArray();
+		break;
+	case MAP:
+		m.beginObject();
+		for(t::uint64 i = 0; i < x; i++) {
+			t::uint8 k = get();
+			if((k >> 5) != TEXT || (k & 31) == INDEFINITE)
+				error("expected field name here");
+			field(argument(k & 31));
+			parseValue();
+		}
+		m.endObject();
+		break;
+	case TAG:
+		parseValue();
+		break;
+	}
+}
+
+} }		// elm::json
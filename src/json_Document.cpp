@@ -0,0 +1,735 @@
+/*
+ *	json::Document class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2016, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <string.h>
+#include <elm/data/Vector.h>
+#include <elm/hash.h>
+#include <elm/io/BlockInStream.h>
+#include <elm/io/BufferedInStream.h>
+#include <elm/json/Document.h>
+#include <elm/string/StringBuffer.h>
+#include <elm/sys/System.h>
+
+namespace elm { namespace json {
+
+/**
+ * @class Value
+ * A value of a JSON @ref Document: null, boolean, integer, float, string,
+ * array or object. Values are built by a document in its arena and remain
+ * valid until the document is cleared, re-parsed or deleted.
+ *
+ * The type of a value is got with type() or the is...() functions and its
+ * content with the as...() functions (that assert the type of the value).
+ * The items of an array, as the fields of an object, are accessed in O(1)
+ * by their index with operator[](int) and count(). The fields of an object
+ * are looked up by their name with find() or operator[](cstring): small
+ * objects are scanned while the bigger ones use a hash table built with
+ * the object. A missing field gives the @ref Value::null value, so that
+ * lookups can be chained:
+ *
+ * @code
+ * json::Document doc;
+ * doc.parse(text);
+ * for(int i = 0; i < doc.root()["events"].count(); i++)
+ *	cout << doc.root()["events"][i]["name"].asString() << io::endl;
+ * @endcode
+ *
+ * An integer value is produced for the numbers fitting a t::int64
+ * (see Maker::onValue(t::int64)): the other numbers are stored as floats.
+ *
+ * @ingroup json
+ */
+
+/**
+ * Null value, returned for missing fields.
+ */
+const Value Value::null;
+
+/**
+ * @fn Value::Value(void);
+ * Build a null value.
+ */
+
+/**
+ * @fn type_t Value::type(void) const;
+ * Get the type of the value.
+ * @return	Value type.
+ */
+
+/**
+ * @fn t::int64 Value::asInt(void) const;
+ * Get the value of an integer.
+ * @return	Integer value.
+ */
+
+/**
+ * @fn double Value::asFloat(void) const;
+ * Get the value of a number, integer or float.
+ * @return	Number value.
+ */
+
+/**
+ * @fn cstring Value::asString(void) const;
+ * Get the value of a string. The string is null-terminated but may contain
+ * null characters (coming from \\u0000 escapes): its actual length is given
+ * by length().
+ * @return	String value.
+ */
+
+/**
+ * @fn int Value::count(void) const;
+ * Get the number of items of an array or the number of fields of an object.
+ * @return	Item or field count.
+ */
+
+/**
+ * @fn const Value& Value::operator[](int i) const;
+ * Get an item of an array or the value of a field of an object by its index.
+ * @param i		Item or field index (in [0, count()[).
+ * @return		Item or field value.
+ */
+
+/**
+ * @fn cstring Value::key(int i) const;
+ * Get the name of a field of an object by its index.
+ * @param i		Field index (in [0, count()[).
+ * @return		Field name.
+ */
+
+/**
+ * Look for a field of an object. If the object has several fields with
+ * the same name, the first one is returned.
+ * @param key	Field name.
+ * @return		Field value or null if the field does not exist or if the
+ *				current value is not an object.
+ */
+const Value *Value::find(cstring key) const {
+	if(load()._type != OBJECT)
+		return nullptr;
+	t::uint32 l = key.length();
+	if(_size <= t::uint32(small_max)) {
+		for(t::uint32 i = 0; i < _size; i++) {
+			const member_t& m = _.members[i];
+			if(m.len == l && memcmp(m.key, key.chars(), l) == 0)
+				return &m.val;
+		}
+	}
+	else {
+		t::uint32 h = hash_string(key.chars(), l);
+		const t::uint32 *table = reinterpret_cast<const t::uint32 *>(_.members + _size);
+		t::uint32 mask = table[0];
+		for(t::uint32 i = h & mask; table[i + 1] != 0; i = (i + 1) & mask) {
+			const member_t& m = _.members[table[i + 1] - 1];
+			if(m.hash == h && m.len == l && memcmp(m.key, key.chars(), l) == 0)
+				return &m.val;
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * @fn bool Value::contains(cstring key) const;
+ * Test if an object contains a field.
+ * @param key	Field name.
+ * @return		True if the field exists, false else.
+ */
+
+/**
+ * @fn const Value& Value::operator[](cstring key) const;
+ * Get the value of a field of an object.
+ * @param key	Field name.
+ * @return		Field value or @ref Value::null if the field does not exist.
+ */
+
+
+// build the content of a lazy value
+void Value::materialize(void) const {
+	_.lazy->doc->load(*const_cast<Value *>(this));
+}
+
+
+// maker building the values of a document
+class Document::Builder: public Maker {
+public:
+	Builder(Document& doc): d(doc), key(nullptr), len(0) { }
+
+	void reset(void) {
+		stack.clear();
+		frames.clear();
+		key = nullptr;
+		result = Value();
+	}
+
+	void beginObject(void) override { open(); }
+	void endObject(void) override { close(true); }
+	void beginArray(void) override { open(); }
+	void endArray(void) override { close(false); }
+
+	void onField(string name) override {
+		key = d.copy(name.chars(), name.length());
+		len = name.length();
+	}
+
+	void onNull(void) override { add(Value()); }
+
+	void onValue(bool value) override {
+		Value v;
+		v._type = Value::BOOLEAN;
+		v._.b = value;
+		add(v);
+	}
+
+	void onValue(int value) override { onValue(t::int64(value)); }
+
+	void onValue(t::int64 value) override {
+		Value v;
+		v._type = Value::INTEGER;
+		v._.i = value;
+		add(v);
+	}
+
+	void onValue(double value) override {
+		Value v;
+		v._type = Value::FLOAT;
+		v._.f = value;
+		add(v);
+	}
+
+	void onValue(string value) override {
+		Value v;
+		v._type = Value::STRING;
+		v._size = value.length();
+		v._.s = d.copy(value.chars(), value.length());
+		add(v);
+	}
+
+	Value result;
+
+private:
+	typedef struct frame_t {
+		int start;
+		const char *key;
+		t::uint32 len;
+	} frame_t;
+
+	void open(void) {
+		frame_t f = { stack.length(), key, len };
+		frames.push(f);
+		key = nullptr;
+	}
+
+	void close(bool object) {
+		frame_t f = frames.pop();
+		int n = stack.length() - f.start;
+		Value v;
+		if(object)
+			d.makeObject(v, stack.asArray().buffer() + f.start, n);
+		else {
+			Value *items = static_cast<Value *>(d.allocate(n * sizeof(Value)));
+			for(int i = 0; i < n; i++)
+				items[i] = stack[f.start + i].val;
+			d.makeArray(v, items, n);
+		}
+		stack.shrink(f.start);
+		key = f.key;
+		len = f.len;
+		add(v);
+	}
+
+	void add(const Value& v) {
+		if(!frames)
+			result = v;
+		else {
+			Value::member_t& m = stack.addNew();
+			m.key = key;
+			m.len = len;
+			m.val = v;
+			key = nullptr;
+		}
+	}
+
+	Document& d;
+	Vector<Value::member_t> stack;
+	Vector<frame_t> frames;
+	const char *key;
+	t::uint32 len;
+};
+
+
+/**
+ * @class Document
+ * A JSON document parsed in memory as a tree of @ref Value. The values,
+ * their strings, the items of the arrays and the fields of the objects are
+ * all allocated in a single @ref StackAllocator owned by the document:
+ * building the tree costs no allocation per value and the whole tree is
+ * freed at once when the document is cleared, re-parsed or deleted.
+ *
+ * In lazy mode (see setLazy()), the arrays and the objects are only built
+ * when they are accessed: parsing does not scan the text and an array or an
+ * object is built from its text, one level at a time (its sub-arrays and
+ * sub-objects being only delimited), when its type or its content is first
+ * requested. This is useful to look at a small part of a big document. In this
+ * mode, the text is kept by the document (without copy for a string) and the
+ * syntax errors of a sub-tree are only reported, as a @ref json::Exception,
+ * when it is accessed.
+ * Building a lazy value modifies the document: a lazy document must not be
+ * accessed concurrently.
+ *
+ * @code
+ * json::Document doc;
+ * doc.setLazy(true);
+ * doc.parse(sys::Path("trace.json"));
+ * cout << doc.root()["version"].asInt() << io::endl;
+ * @endcode
+ *
+ * @ingroup json
+ */
+
+/**
+ * Build a document.
+ * @param chunk_size	Size of the chunks of the arena.
+ */
+Document::Document(t::size chunk_size)
+:	arena(chunk_size),
+	builder(new Builder(*this)),
+	parser(new Parser(*builder)),
+	_lazy(false)
+{ }
+
+
+/**
+ */
+Document::~Document(void) {
+	delete parser;
+	delete builder;
+}
+
+
+/**
+ * Parse a JSON text. The previous values of the document are freed.
+ * @param text	Text to parse.
+ * @throw json::Exception	If there is a syntax error.
+ */
+void Document::parse(string text) {
+	clear();
+	try {
+		src = text;
+		const char *p = src.chars(), *e = p + src.length();
+		while(p < e && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+			p++;
+		if(_lazy && p < e && (*p == '{' || *p == '['))
+			makeLazy(_root, p, e);
+		else {
+			src = "";
+			builder->reset();
+			parser->parse(text);
+			_root = builder->result;
+		}
+	}
+	catch(json::Exception& e) {
+		clear();
+		throw;
+	}
+}
+
+/**
+ * @fn void Document::parse(cstring text);
+ * Parse a JSON text.
+ * @param text	Text to parse.
+ * @throw json::Exception	If there is a syntax error.
+ */
+
+/**
+ * @fn void Document::parse(const char *text);
+ * Parse a JSON text.
+ * @param text	Text to parse.
+ * @throw json::Exception	If there is a syntax error.
+ */
+
+
+/**
+ * Parse a JSON text from a stream. In lazy mode, the whole stream is read
+ * before parsing.
+ * @param in	Stream to read from.
+ * @throw json::Exception	If there is a syntax or a stream error.
+ */
+void Document::parse(io::InStream& in) {
+	if(_lazy)
+		parse(read(in));
+	else {
+		clear();
+		try {
+			builder->reset();
+			parser->parse(in);
+			_root = builder->result;
+		}
+		catch(json::Exception& e) {
+			clear();
+			throw;
+		}
+	}
+}
+
+
+/**
+ * Parse a JSON file.
+ * @param path	Path of the file.
+ * @throw json::Exception	If there is a syntax or a file error.
+ */
+void Document::parse(sys::Path path) {
+	try {
+		io::InStream *file = sys::System::readFile(path);
+		try {
+			io::BufferedInStream bin(*file, Parser::buffer_size);
+			parse(bin);
+			delete file;
+		}
+		catch(json::Exception& e) {
+			delete file;
+			throw;
+		}
+	}
+	catch(sys::SystemException& e) {
+		throw json::Exception(e.message());
+	}
+}
+
+
+/**
+ * Free the values of the document: the root becomes null.
+ */
+void Document::clear(void) {
+	arena.clear();
+	src = "";
+	_root = Value();
+}
+
+/**
+ * @fn const Value& Document::root(void) const;
+ * Get the top-level value of the document.
+ * @return	Top-level value (null if nothing has been parsed).
+ */
+
+/**
+ * @fn bool Document::isLazy(void) const;
+ * Test if the document is in lazy mode.
+ * @return	True in lazy mode, false else.
+ */
+
+/**
+ * @fn void Document::setLazy(bool lazy);
+ * Select the lazy mode for the next parsing.
+ * @param lazy	True for lazy mode, false else.
+ */
+
+
+// read a whole stream
+string Document::read(io::InStream& in) {
+	StringBuffer buf;
+	io::BufferedInStream bin(in, Parser::buffer_size);
+	const char *w;
+	int n;
+	while((n = bin.peek(w)) > 0) {
+		buf.stream().write(w, n);
+		bin.advance(n);
+	}
+	if(n == io::InStream::FAILED)
+		throw json::Exception(in.lastErrorMessage());
+	return buf.toString();
+}
+
+
+// allocate a block in the arena (keeping the blocks aligned)
+void *Document::allocate(t::size size) {
+	return arena.allocate((size + 7) & ~t::size(7));
+}
+
+
+// copy a string in the arena (with a final null character)
+const char *Document::copy(const char *s, int n) {
+	char *r = static_cast<char *>(allocate(n + 1));
+	memcpy(r, s, n);
+	r[n] = '\0';
+	return r;
+}
+
+
+// make v an array of the given items (already in the arena)
+void Document::makeArray(Value& v, const Value *items, int n) {
+	v._type = Value::ARRAY;
+	v._size = n;
+	v._.items = items;
+}
+
+
+// make v an object with a copy of the given members (and a hash table
+// for the big objects, stored after the members: mask, then entries
+// giving the member index plus one; the small objects are scanned and
+// their member hashes are not computed)
+void Document::makeObject(Value& v, const Value::member_t *members, int n) {
+	t::size size = n * sizeof(Value::member_t);
+	t::uint32 cap = 0;
+	if(n > Value::small_max) {
+		cap = 16;
+		while(cap < t::uint32(n) * 2)
+			cap <<= 1;
+		size += (cap + 1) * sizeof(t::uint32);
+	}
+	Value::member_t *ms = static_cast<Value::member_t *>(allocate(size));
+	for(int i = 0; i < n; i++)
+		ms[i] = members[i];
+	if(cap != 0) {
+		t::uint32 *table = reinterpret_cast<t::uint32 *>(ms + n);
+		table[0] = cap - 1;
+		memset(table + 1, 0, cap * sizeof(t::uint32));
+		for(int i = 0; i < n; i++) {
+			ms[i].hash = hash_string(ms[i].key, ms[i].len);
+			t::uint32 j = ms[i].hash & (cap - 1);
+			while(table[j + 1] != 0)
+				j = (j + 1) & (cap - 1);
+			table[j + 1] = i + 1;
+		}
+	}
+	v._type = Value::OBJECT;
+	v._size = n;
+	v._.members = ms;
+}
+
+
+// characters that may follow a scalar
+static inline bool isSeparator(char c) {
+	switch(c) {
+	case ' ': case '\t': case '\n': case '\r':
+	case '{': case '}': case '[': case ']': case ':': case ',':
+	case '"': case '\'': case '/':
+		return true;
+	default:
+		return false;
+	}
+}
+
+// skip the blanks and the comments (null if a comment is not terminated)
+static const char *skipBlank(const char *p, const char *e) {
+	while(p < e) {
+		switch(*p) {
+		case ' ': case '\t': case '\n': case '\r':
+			p++;
+			break;
+		case '/':
+			if(p + 1 < e && p[1] == '/') {
+				p = static_cast<const char *>(memchr(p, '\n', e - p));
+				if(p == nullptr)
+					return e;
+			}
+			else if(p + 1 < e && p[1] == '*') {
+				for(p += 2; p + 1 < e && !(p[0] == '*' && p[1] == '/'); p++);
+				if(p + 1 >= e)
+					return nullptr;
+				p += 2;
+			}
+			else
+				return p;
+			break;
+		default:
+			return p;
+		}
+	}
+	return p;
+}
+
+// skip a string (null if it is not terminated)
+static const char *skipString(const char *p, const char *e) {
+	char q = *p++;
+	while(p < e) {
+		if(*p == q)
+			return p + 1;
+		else if(*p == '\\')
+			p += 2;
+		else
+			p++;
+	}
+	return nullptr;
+}
+
+// skip a value, only checking the balance of the brackets
+// (null if the value is not terminated)
+static const char *skipValue(const char *p, const char *e) {
+	if(*p == '"' || *p == '\'')
+		return skipString(p, e);
+	else if(*p != '{' && *p != '[') {
+		while(p < e && !isSeparator(*p))
+			p++;
+		return p;
+	}
+	static const struct special_t {
+		special_t(void) {
+			memset(is, 0, sizeof(is));
+			for(const char *p = "{}[]\"'/"; *p; p++)
+				is[t::uint8(*p)] = true;
+		}
+		bool is[256];
+	} special;
+	int depth = 0;
+	while(p < e) {
+		while(!special.is[t::uint8(*p)])
+			if(++p == e)
+				return nullptr;
+		switch(*p) {
+		case '{': case '[':
+			depth++;
+			p++;
+			break;
+		case '}': case ']':
+			p++;
+			if(--depth == 0)
+				return p;
+			break;
+		case '"': case '\'':
+			p = skipString(p, e);
+			if(p == nullptr)
+				return nullptr;
+			break;
+		case '/':
+			if(p + 1 < e && (p[1] == '/' || p[1] == '*')) {
+				p = skipBlank(p, e);
+				if(p == nullptr)
+					return nullptr;
+			}
+			else
+				p++;
+			break;
+		default:
+			p++;
+			break;
+		}
+	}
+	return nullptr;
+}
+
+
+// make v a lazy value for the array or object in [p, e[ (its brackets are
+// only checked when it is built)
+void Document::makeLazy(Value& v, const char *p, const char *e) {
+	if(t::size(e - p) >= (t::size(1) << 32))
+		error(p, "value too big for lazy mode");
+	Value::lazy_t *l = static_cast<Value::lazy_t *>(allocate(sizeof(Value::lazy_t)));
+	l->text = p;
+	l->doc = this;
+	v._type = Value::LAZY;
+	v._size = e - p;
+	v._.lazy = l;
+}
+
+
+// build one level of the lazy value v
+void Document::load(Value& v) {
+	const char *p = v._.lazy->text, *e = p + v._size;
+	bool object = *p == '{';
+	char close = object ? '}' : ']';
+	Vector<Value::member_t> members;
+	p++;
+	while(true) {
+		p = skipBlank(p, e);
+		if(p == nullptr || p >= e)
+			error(v._.lazy->text, object ? "unterminated object" : "unterminated array");
+		if(*p == close)
+			break;
+		Value::member_t& m = members.addNew();
+		m.key = nullptr;
+		m.len = m.hash = 0;
+
+		// field name
+		if(object) {
+			const char *q = skipValue(p, e);
+			const Value& k = parseScalar(p, q ? q : e);
+			if(k._type != Value::STRING)
+				error(p, "expected field name here");
+			m.key = k._.s;
+			m.len = k._size;
+			p = skipBlank(q, e);
+			if(p == nullptr || p >= e || *p != ':')
+				error(q, "':' expected here");
+			p = skipBlank(p + 1, e);
+			if(p == nullptr || p >= e)
+				error(v._.lazy->text, "unterminated object");
+		}
+
+		// value
+		if(*p == '{' || *p == '[') {
+			const char *q = skipValue(p, e);
+			if(q == nullptr)
+				error(p, *p == '{' ? "unterminated object" : "unterminated array");
+			makeLazy(m.val, p, q);
+			p = q;
+		}
+		else {
+			const char *q = skipValue(p, e);
+			if(q == nullptr)
+				q = e;
+			else if(q == p)
+				error(p, "unexpected symbol");
+			m.val = parseScalar(p, q);
+			p = q;
+		}
+
+		// separator
+		p = skipBlank(p, e);
+		if(p != nullptr && p < e && *p == ',')
+			p++;
+		else if(p == nullptr || p >= e || *p != close)
+			error(p ? p : e, object ? "',' or '}' expected here" : "unexpected symbol");
+	}
+
+	if(object)
+		makeObject(v, members.asArray().buffer(), members.length());
+	else {
+		Value *items = static_cast<Value *>(allocate(members.length() * sizeof(Value)));
+		for(int i = 0; i < members.length(); i++)
+			items[i] = members[i].val;
+		makeArray(v, items, members.length());
+	}
+}
+
+
+// parse the scalar value in [p, e[
+const Value& Document::parseScalar(const char *p, const char *e) {
+	builder->reset();
+	io::BlockInStream in(p, e - p);
+	parser->parse(in);
+	if(in.mark() != e - p)
+		error(p + in.mark(), _ << "bad character '" << p[in.mark()] << "'");
+	return builder->result;
+}
+
+
+// raise an error at position p of the lazy text
+void Document::error(const char *p, string message) {
+	int line = 1;
+	const char *l = src.chars();
+	for(const char *q = src.chars(); q < p; q++)
+		if(*q == '\n') {
+			line++;
+			l = q + 1;
+		}
+	throw json::Exception(_ << line << ':' << (p - l + 1) << ": " << message);
+}
+
+}	}	// elm::json
@@ -0,0 +1,331 @@
+/*
+ *	json::Indexer class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2016, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <string.h>
+#include <elm/json/Indexer.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#	define ELM_JSON_X86
+#	include <immintrin.h>
+#endif
+
+namespace elm { namespace json {
+
+namespace {
+
+// character classes of a 64-byte block (one bit per byte)
+typedef struct masks_t {
+	t::uint64 bs;		// backslashes
+	t::uint64 quote;	// double quotes
+	t::uint64 op;		// structural characters: { } [ ] : ,
+	t::uint64 ws;		// blanks
+	t::uint64 ext;		// starts of extensions: single quotes and comments
+} masks_t;
+
+// state of the indexing
+typedef struct scan_t {
+	const char *b, *p, *e;
+	t::uint64 prev_escaped, prev_in_string, prev_scalar;
+	t::uint32 *idx;
+	int n, cap;
+	bool stop;
+} scan_t;
+
+typedef void (*classify_t)(const char *p, masks_t& m);
+typedef void (*scanner_t)(scan_t& s);
+
+inline void classify_scalar(const char *p, masks_t& m) {
+	m.bs = m.quote = m.op = m.ws = m.ext = 0;
+	for(int i = 0; i < 64; i++) {
+		t::uint64 bit = t::uint64(1) << i;
+		switch(p[i]) {
+		case '\\':	m.bs |= bit; break;
+		case '"':	m.quote |= bit; break;
+		case '{': case '}': case '[': case ']': case ':': case ',':
+					m.op |= bit; break;
+		case ' ': case '\t': case '\n': case '\r':
+					m.ws |= bit; break;
+		case '\'': case '/':
+					m.ext |= bit; break;
+		}
+	}
+}
+
+// bit i of the result is the XOR of bits 0 to i of x
+inline t::uint64 prefix_xor(t::uint64 x) {
+	x ^= x << 1;
+	x ^= x << 2;
+	x ^= x << 4;
+	x ^= x << 8;
+	x ^= x << 16;
+	x ^= x << 32;
+	return x;
+}
+
+// store the offsets of the bits of s (writing up to 16 entries after the last one)
+__attribute__((always_inline)) inline void flatten(t::uint32 *q, int& n, t::uint32 base, t::uint64 s) {
+	int c = __builtin_popcountll(s);
+	q += n;
+	n += c;
+	for(int i = 0; i < 8; i++) {
+		q[i] = base + (s ? __builtin_ctzll(s) : 0);
+		s &= s - 1;
+	}
+	if(c > 8) {
+		for(int i = 8; i < 16; i++) {
+			q[i] = base + (s ? __builtin_ctzll(s) : 0);
+			s &= s - 1;
+		}
+		for(int i = 16; s; i++) {
+			q[i] = base + __builtin_ctzll(s);
+			s &= s - 1;
+		}
+	}
+}
+
+// index the blocks while there is room for a block of offsets
+template <classify_t C>
+__attribute__((always_inline)) inline void scan_blocks(scan_t& s) {
+	const t::uint64 even = 0x5555555555555555ULL;
+	while(s.p < s.e && s.n <= s.cap - 64) {
+
+		// classify the characters
+		masks_t m;
+		if(s.e - s.p >= 64)
+			C(s.p, m);
+		else {
+			char tail[64];
+			memset(tail, ' ', sizeof(tail));
+			memcpy(tail, s.p, s.e - s.p);
+			C(tail, m);
+		}
+
+		// find the escaped characters (odd position in a backslash sequence)
+		t::uint64 bs = m.bs & ~s.prev_escaped;
+		t::uint64 follows = (bs << 1) | s.prev_escaped;
+		t::uint64 odd_starts = bs & ~even & ~follows;
+		t::uint64 even_seqs;
+		t::uint64 escaped_next = __builtin_add_overflow(odd_starts, bs, &even_seqs);
+		t::uint64 escaped = (even ^ (even_seqs << 1)) & follows;
+
+		// find the string contents (from opening quote to before closing quote)
+		t::uint64 quote = m.quote & ~escaped;
+		t::uint64 in_string = prefix_xor(quote) ^ s.prev_in_string;
+		if(m.ext & ~in_string) {
+			s.stop = true;
+			break;
+		}
+		s.prev_escaped = escaped_next;
+		s.prev_in_string = t::uint64(t::int64(in_string) >> 63);
+
+		// find the starts of the other values
+		t::uint64 scalar = ~(m.op | m.ws | quote | in_string);
+		t::uint64 starts = scalar & ~((scalar << 1) | s.prev_scalar);
+		s.prev_scalar = scalar >> 63;
+
+		// record the offsets
+		t::uint64 r = (m.op & ~in_string) | quote | starts;
+		if(s.e - s.p < 64)
+			r &= (t::uint64(1) << (s.e - s.p)) - 1;
+		flatten(s.idx, s.n, s.p - s.b, r);
+		s.p += 64;
+	}
+}
+
+void scan_scalar(scan_t& s) {
+	scan_blocks<classify_scalar>(s);
+}
+
+#ifdef ELM_JSON_X86
+
+__attribute__((target("sse2")))
+inline t::uint64 eq_sse2(__m128i v, char c) {
+	return t::uint16(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(c))));
+}
+
+__attribute__((target("sse2")))
+inline void classify_sse2(const char *p, masks_t& m) {
+	m.bs = m.quote = m.op = m.ws = m.ext = 0;
+	for(int i = 0; i < 64; i += 16) {
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+		__m128i l = _mm_or_si128(v, _mm_set1_epi8(0x20));	// [ and ] to { and }
+		m.bs |= eq_sse2(v, '\\') << i;
+		m.quote |= eq_sse2(v, '"') << i;
+		m.op |= (eq_sse2(l, '{') | eq_sse2(l, '}') | eq_sse2(v, ':') | eq_sse2(v, ',')) << i;
+		m.ws |= (eq_sse2(v, ' ') | eq_sse2(v, '\t') | eq_sse2(v, '\n') | eq_sse2(v, '\r')) << i;
+		m.ext |= (eq_sse2(v, '\'') | eq_sse2(v, '/')) << i;
+	}
+}
+
+__attribute__((target("sse2,popcnt")))
+void scan_sse2(scan_t& s) {
+	scan_blocks<classify_sse2>(s);
+}
+
+__attribute__((target("avx2")))
+inline t::uint64 eq_avx2(__m256i v, char c) {
+	return t::uint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(c))));
+}
+
+__attribute__((target("avx2")))
+inline void classify_avx2(const char *p, masks_t& m) {
+	m.bs = m.quote = m.op = m.ws = m.ext = 0;
+	for(int i = 0; i < 64; i += 32) {
+		__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+		__m256i l = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+		m.bs |= eq_avx2(v, '\\') << i;
+		m.quote |= eq_avx2(v, '"') << i;
+		m.op |= (eq_avx2(l, '{') | eq_avx2(l, '}') | eq_avx2(v, ':') | eq_avx2(v, ',')) << i;
+		m.ws |= (eq_avx2(v, ' ') | eq_avx2(v, '\t') | eq_avx2(v, '\n') | eq_avx2(v, '\r')) << i;
+		m.ext |= (eq_avx2(v, '\'') | eq_avx2(v, '/')) << i;
+	}
+}
+
+__attribute__((target("avx2,popcnt,bmi")))
+void scan_avx2(scan_t& s) {
+	scan_blocks<classify_avx2>(s);
+}
+
+#endif
+
+scanner_t select_scanner(void) {
+#	ifdef ELM_JSON_X86
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt") && __builtin_cpu_supports("bmi"))
+			return scan_avx2;
+		if(__builtin_cpu_supports("sse2") && __builtin_cpu_supports("popcnt"))
+			return scan_sse2;
+#	endif
+	return scan_scalar;
+}
+
+inline scanner_t scanner(void) {
+	static const scanner_t c = select_scanner();
+	return c;
+}
+
+}	// anonymous
+
+
+/**
+ * @class Indexer
+ * First stage of the structural JSON parser (see Parser::STRUCTURAL):
+ * the indexer finds the offsets of the structural characters of a JSON text
+ * ('{', '}', '[', ']', ':', ','), of the quotes delimiting the strings
+ * (both opening and closing) and of the first characters of the other values
+ * (numbers and literals). The text is processed by blocks of 64 bytes whose
+ * characters are classified with SIMD instructions when available
+ * (SSE2 or AVX2, selected at run time): the escapes and the string contents
+ * are then found with a few bit operations per block, without branch per
+ * character (G. Langdale, D. Lemire, "Parsing Gigabytes of JSON per Second",
+ * VLDB Journal, 2019).
+ *
+ * The offsets are produced by batches of at most Indexer::capacity
+ * entries to bound the memory footprint whatever the text size.
+ *
+ * The indexing stops (see stopped()) at the block containing a single quote
+ * or a slash out of a string: these extensions to JSON (single-quoted strings
+ * and comments) have to be processed by the classic parser.
+ *
+ * @ingroup json
+ */
+
+/**
+ * @var int Indexer::capacity;
+ * Maximum number of offsets in a batch.
+ */
+
+/**
+ * Test if the indexer uses SIMD instructions on this host. If not,
+ * the classic parser is generally faster.
+ * @return	True if SIMD instructions are used.
+ */
+bool Indexer::accelerated(void) {
+	return scanner() != scan_scalar;
+}
+
+
+/**
+ * Build an indexer on an empty text.
+ */
+Indexer::Indexer(void) {
+	reset("", 0);
+}
+
+
+/**
+ * Start the indexing of a new text.
+ * @param text		Text to index (must stay alive while indexing).
+ * @param length	Text length (less than 4 GiB).
+ */
+void Indexer::reset(const char *text, t::size length) {
+	b = p = text;
+	e = text + length;
+	prev_escaped = 0;
+	prev_in_string = 0;
+	prev_scalar = 0;
+	n = 0;
+	stop = false;
+}
+
+
+/**
+ * Compute the next batch of offsets, available between begin() and end().
+ * @return	True if the batch is not empty, false at the end of the text or if
+ *			the indexing is stopped.
+ */
+bool Indexer::next(void) {
+	scan_t s = {
+		b, p, e,
+		prev_escaped, prev_in_string, prev_scalar,
+		idx, 0, capacity,
+		stop
+	};
+	scanner()(s);
+	p = s.p;
+	prev_escaped = s.prev_escaped;
+	prev_in_string = s.prev_in_string;
+	prev_scalar = s.prev_scalar;
+	n = s.n;
+	stop = s.stop;
+	return n > 0;
+}
+
+/**
+ * @fn const t::uint32 *Indexer::begin(void) const;
+ * Get the first offset of the current batch.
+ * @return	Offset pointer.
+ */
+
+/**
+ * @fn const t::uint32 *Indexer::end(void) const;
+ * Get the end of the current batch.
+ * @return	Offset pointer.
+ */
+
+/**
+ * @fn bool Indexer::stopped(void) const;
+ * Test if the indexing has been stopped because of a JSON extension
+ * (single-quoted string or comment).
+ * @return	True if the indexing is stopped.
+ */
+
+} }	// elm::json
@@ -0,0 +1,331 @@
+/*
+ *	json::MessagePackSaver and json::MessagePackParser classes implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2016, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/json/MessagePack.h>
+
+namespace elm { namespace json {
+
+// formats (first byte)
+static const t::uint8
+	FIXMAP = 0x80, FIXARRAY = 0x90, FIXSTR = 0xa0,
+	NIL = 0xc0, FALSE_ITEM = 0xc2, TRUE_ITEM = 0xc3,
+	BIN8 = 0xc4, BIN16 = 0xc5, BIN32 = 0xc6,
+	FLOAT32 = 0xca, FLOAT64 = 0xcb,
+	UINT8 = 0xcc, UINT16 = 0xcd, UINT32 = 0xce, UINT64 = 0xcf,
+	INT8 = 0xd0, INT16 = 0xd1, INT32 = 0xd2, INT64 = 0xd3,
+	STR8 = 0xd9, STR16 = 0xda, STR32 = 0xdb,
+	ARRAY16 = 0xdc, ARRAY32 = 0xdd, MAP16 = 0xde, MAP32 = 0xdf;
+
+// size of the header reserved for a container
+static const int header_max = 5;
+
+/**
+ * @class MessagePackSaver
+ * Saver producing MessagePack (https://msgpack.org) through the
+ * @ref io::StructuredOutput interface: it can replace a JSON @ref Saver
+ * without changing the code producing the output. The output is read back
+ * by a @ref MessagePackParser.
+ *
+ * MessagePack requires the item count at the start of maps and arrays:
+ * the encoding of a top-level value is kept in memory until its end,
+ * the header of each map or array being fixed when it is closed. The
+ * integers and the strings use the shortest encoding and the double values
+ * exactly representable as a float are encoded as floats.
+ *
+ * @ingroup json
+ */
+
+/**
+ */
+MessagePackSaver::~MessagePackSaver(void) {
+	close();
+}
+
+///
+void MessagePackSaver::put(void) { item(); emit(NIL); }
+
+///
+void MessagePackSaver::beginMap() { begin(true); }
+
+///
+void MessagePackSaver::endMap() { end(true); }
+
+///
+void MessagePackSaver::beginList() { begin(false); }
+
+///
+void MessagePackSaver::endList() { end(false); }
+
+///
+bool MessagePackSaver::flushable(void) { return !stack; }
+
+///
+void MessagePackSaver::writeBool(bool x) { item(); emit(x ? TRUE_ITEM : FALSE_ITEM); }
+
+///
+void MessagePackSaver::writeInt(t::int64 x) {
+	if(x >= 0)
+		writeUInt(x);
+	else {
+		item();
+		if(x >= -32)
+			emit(t::uint8(x));
+		else if(x >= -128) {
+			char *q = reserve(2);
+			q[0] = INT8;
+			q[1] = x;
+		}
+		else if(x >= -32768) {
+			char *q = reserve(3);
+			q[0] = INT16;
+			store(q + 1, x, 2);
+		}
+		else if(x >= type_info<t::int32>::min) {
+			char *q = reserve(5);
+			q[0] = INT32;
+			store(q + 1, x, 4);
+		}
+		else {
+			char *q = reserve(9);
+			q[0] = INT64;
+			store(q + 1, x, 8);
+		}
+	}
+}
+
+///
+void MessagePackSaver::writeUInt(t::uint64 x) {
+	item();
+	if(x < 0x80)
+		emit(x);
+	else if(x < 0x100) {
+		char *q = reserve(2);
+		q[0] = UINT8;
+		q[1] = x;
+	}
+	else if(x < 0x10000) {
+		char *q = reserve(3);
+		q[0] = UINT16;
+		store(q + 1, x, 2);
+	}
+	else if(x < 0x100000000ULL) {
+		char *q = reserve(5);
+		q[0] = UINT32;
+		store(q + 1, x, 4);
+	}
+	else {
+		char *q = reserve(9);
+		q[0] = UINT64;
+		store(q + 1, x, 8);
+	}
+}
+
+///
+void MessagePackSaver::writeFloat(float x) {
+	item();
+	t::uint32 b;
+	memcpy(&b, &x, sizeof(b));
+	char *q = reserve(5);
+	q[0] = FLOAT32;
+	store(q + 1, b, 4);
+}
+
+///
+void MessagePackSaver::writeDouble(double x) {
+	if(double(float(x)) == x)
+		writeFloat(float(x));
+	else {
+		item();
+		t::uint64 b;
+		memcpy(&b, &x, sizeof(b));
+		char *q = reserve(9);
+		q[0] = FLOAT64;
+		store(q + 1, b, 8);
+	}
+}
+
+///
+void MessagePackSaver::writeString(const char *s, int n) {
+	item();
+	str(s, n);
+}
+
+///
+void MessagePackSaver::writeKey(const char *s, int n) {
+	ASSERTP(stack && stack.top().map, "msgpack: key only allowed inside a map");
+	stack.top().count++;
+	str(s, n);
+}
+
+
+// write a string
+void MessagePackSaver::str(const char *s, int n) {
+	if(n < 32)
+		emit(FIXSTR | n);
+	else if(n < 0x100) {
+		char *q = reserve(2);
+		q[0] = STR8;
+		q[1] = n;
+	}
+	else if(n < 0x10000) {
+		char *q = reserve(3);
+		q[0] = STR16;
+		store(q + 1, n, 2);
+	}
+	else {
+		char *q = reserve(5);
+		q[0] = STR32;
+		store(q + 1, n, 4);
+	}
+	emit(s, n);
+}
+
+
+// open a map or an array, reserving its header
+void MessagePackSaver::begin(bool map) {
+	item();
+	frame_t f = { top, 0, map };
+	stack.push(f);
+	reserve(header_max);
+}
+
+
+// close a map or an array, writing its header
+void MessagePackSaver::end(bool map) {
+	ASSERTP(stack && stack.top().map == map, "msgpack: unbalanced map or array");
+	frame_t f = stack.pop();
+	char *q = buf + f.off;
+	int h;
+	if(f.count < 16) {
+		h = 1;
+		q[0] = (map ? FIXMAP : FIXARRAY) | f.count;
+	}
+	else if(f.count < 0x10000) {
+		h = 3;
+		q[0] = map ? MAP16 : ARRAY16;
+		store(q + 1, f.count, 2);
+	}
+	else {
+		h = 5;
+		q[0] = map ? MAP32 : ARRAY32;
+		store(q + 1, f.count, 4);
+	}
+	if(h != header_max) {
+		memmove(q + h, q + header_max, top - f.off - header_max);
+		top -= header_max - h;
+	}
+}
+
+
+/**
+ * @class MessagePackParser
+ * Parser of MessagePack calling a @ref Maker for each found entity, as the
+ * JSON @ref Parser does. The binary values are passed as strings and the
+ * extension types raise an error.
+ *
+ * @ingroup json
+ */
+
+///
+void MessagePackParser::parseValue(void) {
+	t::uint8 c = get();
+	if(c < 0x80)
+		m.onValue(int(c));
+	else if(c < FIXARRAY)
+		parseMap(c & 0xf);
+	else if(c < FIXSTR)
+		parseArray(c & 0xf);
+	else if(c < NIL)
+		m.onValue(text(c & 0x1f));
+	else if(c >= 0xe0)
+		m.onValue(int(t::int8(c)));
+	else
+		switch(c) {
+		case NIL:		m.onNull(); break;
+		case FALSE_ITEM:	m.onValue(false); break;
+		case TRUE_ITEM:	m.onValue(true); break;
+		case BIN8:		m.onValue(text(get(), false)); break;
+		case BIN16:		m.onValue(text(load(take(2), 2), false)); break;
+		case BIN32:		m.onValue(text(load(take(4), 4), false)); break;
+		case FLOAT32: {
+				t::uint32 b = load(take(4), 4);
+				float x;
+				memcpy(&x, &b, sizeof(x));
+				m.onValue(double(x));
+			}
+			break;
+		case FLOAT64: {
+				t::uint64 b = load(take(8), 8);
+				double x;
+				memcpy(&x, &b, sizeof(x));
+				m.onValue(x);
+			}
+			break;
+		case UINT8:		onUInt(get()); break;
+		case UINT16:	onUInt(load(take(2), 2)); break;
+		case UINT32:	onUInt(load(take(4), 4)); break;
+		case UINT64:	onUInt(load(take(8), 8)); break;
+		case INT8:		onInt(t::int8(get())); break;
+		case INT16:		onInt(t::int16(load(take(2), 2))); break;
+		case INT32:		onInt(t::int32(load(take(4), 4))); break;
+		case INT64:		onInt(t::int64(load(take(8), 8))); break;
+		case STR8:		m.onValue(text(get())); break;
+		case STR16:		m.onValue(text(load(take(2), 2))); break;
+		case STR32:		m.onValue(text(load(take(4), 4))); break;
+		case ARRAY16:	parseArray(load(take(2), 2)); break;
+		case ARRAY32:	parseArray(load(take(4), 4)); break;
+		case MAP16:		parseMap(load(take(2), 2)); break;
+		case MAP32:		parseMap(load(take(4), 4)); break;
+		default:		error("unsupported format"); break;
+		}
+}
+
+
+// parse the n items of an array
+void MessagePackParser::parseArray(t::uint32 n) {
+	m.beginArray();
+	for(t::uint32 i = 0; i < n; i++)
+		parseValue();
+	m.endArray();
+}
+
+
+// parse the n pairs of a map
+void MessagePackParser::parseMap(t::uint32 n) {
+	m.beginObject();
+	for(t::uint32 i = 0; i < n; i++) {
+		t::uint8 c = get();
+		if(FIXSTR <= c && c < NIL)
+			field(c & 0x1f);
+		else if(c == STR8)
+			field(get());
+		else if(c == STR16)
+			field(load(take(2), 2));
+		else if(c == STR32)
+			field(load(take(4), 4));
+		else
+			error("expected field name here");
+		parseValue();
+	}
+	m.endObject();
+}
+
+} }		// elm::json
@@ -19,9 +19,13 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <string.h>
+#include <elm/io/BlockInStream.h>
 #include <elm/io/BufferedInStream.h>
+#include <elm/io/numconv.h>
+#include <elm/json/Indexer.h>
 #include <elm/json/Parser.h>
-#include <elm/string/utf16.h>
+#include <elm/string/utf8.h>
 #include <elm/sys/System.h>
 
 namespace elm { namespace json {
@@ -86,6 +90,16 @@ void Maker::onField(string name) {
 	throw json::Exception("unexpected field");
 }
 
+/**
+ * Called instead of onField() when the parser interns the field names
+ * (see Parser::setInterning()): the field names that are met again
+ * are then compared by pointer. As a default, call onField().
+ * @param name	Field name.
+ */
+void Maker::onFieldSymbol(Symbol name) {
+	onField(name.toString());
+}
+
 /**
  * Called when a "null" is found in JSON file.
  * As a default, raise an exception.
@@ -114,6 +128,15 @@ void Maker::onValue(int value) {
 	throw json::Exception("unexpected integer value");
 }
 
+/**
+ * Called when an integer value that does not fit in an int is found.
+ * As a default, call onValue(double) (the value may lose precision).
+ * @param value	Integer value.
+ */
+void Maker::onValue(t::int64 value) {
+	onValue(double(value));
+}
+
 /**
  * Called when float value if found.
  * As a default, raise an error.
@@ -146,15 +169,119 @@ void Maker::onValue(string value) {
  * * "//" and "/ *" ... "* /" are parsed and ignored (and doesn't cause error).
  * * hexadecimal and binary integer prefixed by "0[xX]" or "0[bB]".
  *
+ * The parser scans the text directly in memory: in the parsed string or in
+ * the window of the input stream (see io::InStream::peek()). Streams that do
+ * not provide a window are read byte per byte, so that they are left just
+ * after the parsed value, or, if read-ahead is enabled (see setReadAhead()),
+ * through a @ref io::BufferedInStream of Parser::buffer_size bytes.
+ * When the text is a string, the string values and
+ * the field names without escape are passed to the maker as sub-strings
+ * sharing the buffer of the text.
+ *
+ * Integers that does not fit in an int are passed to Maker::onValue(t::int64)
+ * and the bigger integers as doubles.
+ *
+ * Two parsing engines are available (see setEngine()):
+ * * Parser::CLASSIC scans the text character per character,
+ * * Parser::STRUCTURAL first finds the structural characters of the text with
+ *   SIMD instructions (see @ref Indexer) and then jumps from one to another.
+ *   It only applies to texts in memory and is faster on big texts with long
+ *   strings.
+ *   The extensions to JSON (single-quoted strings and comments) are still
+ *   supported: the classic engine takes over from the first extension.
+ *
  * @ingroup json
  */
 
+/**
+ * @var int Parser::buffer_size;
+ * Size of the buffer used to read the streams that does not provide a window.
+ */
+
 /**
  * Build a new parser.
  * @param maker		Maker to use.
  */
-Parser::Parser(Maker& maker): m(maker), line(0), col(0), prev('\0') {
+Parser::Parser(Maker& maker)
+:	m(maker),
+	in(nullptr),
+	b(nullptr),
+	p(nullptr),
+	e(nullptr),
+	off(0),
+	line_off(0),
+	line(0),
+	ival(0),
+	fval(0),
+	symbols(false),
+	eng(AUTO),
+	ahead(false),
+	ix(nullptr),
+	ip(nullptr),
+	ie(nullptr),
+	lp(nullptr),
+	indexed(false)
+{ }
 
+/**
+ */
+Parser::~Parser(void) {
+	delete ix;
+}
+
+/**
+ * @fn bool Parser::interns(void) const;
+ * Test if the field names are interned.
+ * @return	True if field names are interned.
+ */
+
+/**
+ * @fn void Parser::setInterning(bool interning);
+ * When interning is set, the field names are passed as symbols of
+ * the global symbol table to Maker::onFieldSymbol().
+ * @param interning		True to intern the field names.
+ */
+
+/**
+ * @fn bool Parser::readsAhead(void) const;
+ * Test if read-ahead is enabled for the streams without window.
+ * @return	True if read-ahead is enabled.
+ */
+
+/**
+ * @fn void Parser::setReadAhead(bool read_ahead);
+ * When read-ahead is enabled, the streams that do not provide a window
+ * are read by blocks of Parser::buffer_size bytes, which is much faster
+ * than byte per byte. The drawback is that the bytes read after the parsed
+ * value are lost: this must only be enabled if the stream contains nothing
+ * else (it is disabled by default).
+ * @param read_ahead	True to enable read-ahead.
+ */
+
+/**
+ * @fn engine_t Parser::engine(void) const;
+ * Get the parsing engine.
+ * @return	Parsing engine.
+ */
+
+/**
+ * @fn void Parser::setEngine(engine_t engine);
+ * Select the parsing engine:
+ * * Parser::AUTO (default) lets the parser choose: it currently uses the
+ *   classic engine, as the structural engine is not yet faster on the texts
+ *   made mostly of numbers,
+ * * Parser::CLASSIC always uses the classic engine,
+ * * Parser::STRUCTURAL uses the structural engine for the strings and for the
+ *   files (that are then fully loaded in memory).
+ * @param engine	Selected engine.
+ */
+
+/**
+ * Test if the structural engine has to be used.
+ * @return	True for the structural engine.
+ */
+bool Parser::useStructural(void) const {
+	return eng == STRUCTURAL;
 }
 
 /**
@@ -162,18 +289,28 @@ Parser::Parser(Maker& maker): m(maker), line(0), col(0), prev('\0') {
  * @param s		String to parser.
  */
 void Parser::parse(string s) {
-	io::BlockInStream in(s);
-	doParsing(in);
+	src = s;
+	io::BlockInStream in(src.chars(), src.length());
+	doParsing(in, useStructural());
+	src = "";
 }
 
 /**
- * Parse from an input stream.
+ * Parse from an input stream. If the stream provides a window, or if
+ * read-ahead is disabled, the stream is left just after the parsed value
+ * (after a top-level number, the following character is also consumed) and
+ * another value can be parsed from it.
  * @param in	Input stream to use.
  */
 void Parser::parse(io::InStream& in) {
 	try {
-		io::BufferedInStream buf(in);
-		doParsing(buf);
+		const char *w;
+		if(in.peek(w) != io::InStream::UNBUFFERED)
+			doParsing(in);
+		else {
+			io::BufferedInStream buf(in, ahead ? buffer_size : 1);
+			doParsing(buf);
+		}
 	}
 	catch(io::IOException& e) {
 		throw json::Exception(e.message());
@@ -188,7 +325,23 @@ void Parser::parse(sys::Path path) {
 	try {
 		io::InStream *file = sys::System::readFile(path);
 		try {
-			parse(*file);
+			if(eng != STRUCTURAL) {
+				io::BufferedInStream bin(*file, buffer_size);
+				parse(bin);
+			}
+			else {
+				StringBuffer buf;
+				io::BufferedInStream bin(*file, buffer_size);
+				const char *w;
+				int n;
+				while((n = bin.peek(w)) > 0) {
+					buf.stream().write(w, n);
+					bin.advance(n);
+				}
+				if(n == io::InStream::FAILED)
+					throw json::Exception(file->lastErrorMessage());
+				parse(buf.toString());
+			}
 			delete file;
 		}
 		catch(json::Exception& e) {
@@ -203,56 +356,112 @@ void Parser::parse(sys::Path path) {
 
 
 /**
- * Raise an error with the given message at the given position.
+ * Raise an error with the given message at the current position.
  * @param message	Error message.
  */
 void Parser::error(string message) {
-	throw json::Exception(_ << line << ':' << col << ": " << message);
+	if(indexed)
+		syncLine();
+	throw json::Exception(_ << line << ':' << (off + (p - b) - line_off) << ": " << message);
+}
+
+
+/**
+ * Consume the current window of the stream and get the next one.
+ * @return	True if there are more characters, false at end of stream.
+ */
+bool Parser::refill(void) {
+	in->advance(e - b);
+	off += e - b;
+	int n = in->peek(b);
+	if(n == io::InStream::FAILED)
+		error(in->lastErrorMessage());
+	ASSERT(n != io::InStream::UNBUFFERED);
+	if(n <= 0) {
+		b = p = e;
+		return false;
+	}
+	p = b;
+	e = b + n;
+	return true;
 }
 
 
 /**
  * Perform the parsing of the input.
+ * @param s				Stream to read from (must support windows).
+ * @param structural	True to use the structural engine (the window must
+ *						contain the whole text).
  */
-void Parser::doParsing(io::InStream& in) {
+void Parser::doParsing(io::InStream& s, bool structural) {
+	in = &s;
+	b = p = e = nullptr;
+	off = 0;
 	line = 1;
-	col = 0;
-	prev = '\0';
-	parseValue(in, next(in));
+	line_off = 0;
+	refill();
+	indexed = structural && t::size(e - b) < (t::size(1) << 32);
+	if(indexed) {
+		if(ix == nullptr)
+			ix = new Indexer();
+		ix->reset(b, e - b);
+		ip = ie = nullptr;
+		lp = b;
+	}
+	parseValue(next());
+	in->advance(p - b);
+	in = nullptr;
+	indexed = false;
+}
+
+
+/**
+ * Count the lines up to the current position (the structural engine does
+ * not count the lines while parsing).
+ */
+void Parser::syncLine(void) {
+	for(; lp < p; lp++)
+		if(*lp == '\n') {
+			line++;
+			line_off = off + (lp + 1 - b);
+		}
 }
 
 
 /**
  * Parse a simple value, an array or an object.
- * @param in	Input stream.
  * @param t		Last token.
  */
-void Parser::parseValue(io::InStream& in, token_t t) {
-		switch(t) {
-		case LBRACE:	m.beginObject(); parseObject(in); return;
-		case LBRACK:	m.beginArray(); parseArray(in); return;
-		case NULL_TOKEN:	m.onNull(); return;
-		case TRUE:		{ m.onValue(true); return; }
-		case FALSE:		{ m.onValue(false); return; }
-		case INT:		{ int i; text >> i; m.onValue(i); return; }
-		case FLOAT:		{ double d; text >> d; m.onValue(d); return; }
-		case STRING:	{ m.onValue(text); return; }
-		default:		error("unexpected symbol");
-		}
+void Parser::parseValue(token_t t) {
+	switch(t) {
+	case LBRACE:	m.beginObject(); parseObject(); m.endObject(); return;
+	case LBRACK:	m.beginArray(); parseArray(); m.endArray(); return;
+	case NULL_TOKEN:	m.onNull(); return;
+	case TRUE:		m.onValue(true); return;
+	case FALSE:		m.onValue(false); return;
+	case INT:
+		if(ival >= type_info<int>::min && ival <= type_info<int>::max)
+			m.onValue(int(ival));
+		else
+			m.onValue(ival);
+		return;
+	case FLOAT:		m.onValue(fval); return;
+	case STRING:	m.onValue(text); return;
+	default:		error("unexpected symbol");
+	}
 }
 
 
 /**
  * Parse an array (initial token has already been parsed).
- * @param in	Input stream.
  */
-void Parser::parseArray(io::InStream& in) {
-	token_t t = next(in);
+void Parser::parseArray(void) {
+	token_t t = next();
 	while(t != RBRACK) {
-		parseValue(in, t);
-		t = next(in);
+		parseValue(t);
+		t = next();
 		if(t == COMMA)
-			t = next(in);
+			t = next();
 		else if(t != RBRACK)
 			error("unexpected symbol");
 	}
@@ -261,181 +470,337 @@ void Parser::parseArray(io::InStream& in) {
 
 /**
  * Parse an object (considering initial token has been parsed).
- * @param in	Input stream.
  */
-void Parser::parseObject(io::InStream& in) {
-	token_t t = next(in);
+void Parser::parseObject(void) {
+	token_t t = next();
 	while(t != RBRACE) {
 		if(t != STRING)
 			error("expected field name here");
-		m.onField(text);
-		t = next(in);
+		if(symbols)
+			m.onFieldSymbol(text);
+		else
+			m.onField(text);
+		t = next();
 		if(t != COLON)
 			error("':' expected here");
-		parseValue(in, next(in));
-		t = next(in);
+		parseValue(next());
+		t = next();
 		if(t == COMMA)
-			t = next(in);
+			t = next();
 		else if(t != RBRACE)
 			error("',' or '}' expected here");
 	}
 }
 
 
-/**
- * Push back an unused character.
- * @param c	Character to push back.
- */
-void Parser::pushBack(char c) {
-	ASSERT(!prev);
-	prev = c;
-}
-
+// characters of a number
 static inline bool isNumber(char c) {
 	return ('0' <= c && c <= '9')
+		|| ('a' <= c && c <= 'z')
+		|| ('A' <= c && c <= 'Z')
 		|| c == '.'
-		|| c == 'e'
-		|| c == 'E';
+		|| c == '+'
+		|| c == '-';
+}
+
+// characters that may follow a value
+static inline bool isSeparator(char c) {
+	switch(c) {
+	case ' ': case '\t': case '\n': case '\r':
+	case '{': case '}': case '[': case ']': case ':': case ',':
+	case '"': case '\'': case '/':
+		return true;
+	default:
+		return false;
+	}
 }
 
 /**
  * Get next token.
- * @param in	Input stream.
- * @return		Found token.
+ * @return		Found token (NONE at end of text).
  */
-Parser::token_t Parser::next(io::InStream& in) {
+Parser::token_t Parser::next(void) {
+	if(indexed)
+		return nextIndexed();
 	while(true) {
-		char c = nextChar(in);
+
+		// skip blanks
+		while(p < e) {
+			char c = *p;
+			if(c == ' ' || c == '\t' || c == '\r')
+				p++;
+			else if(c == '\n') {
+				p++;
+				newLine();
+			}
+			else
+				break;
+		}
+		if(p >= e) {
+			if(!refill())
+				return NONE;
+			continue;
+		}
+
+		// select the token
+		char c = *p++;
 		switch(c) {
 		case '{':	return LBRACE;
 		case '}':	return RBRACE;
 		case '[':	return LBRACK;
 		case ']':	return RBRACK;
-		case '\'':	parseString(in, '\''); return STRING;
-		case '\"':	parseString(in, '"'); return STRING;
+		case '\'':	parseString('\''); return STRING;
+		case '\"':	parseString('"'); return STRING;
 		case ':':	return COLON;
 		case ',':	return COMMA;
-		case '\n':
-		case '\t':
-		case '\r':
-		case ' ':	break;
-		case '+':
-		case '-':	return parseNumber(in, c);
-		case 'n':	parseLitt(in, "null"); return NULL_TOKEN;
-		case 't':	parseLitt(in, "true"); return TRUE;
-		case 'f':	parseLitt(in, "false"); return FALSE;
-		case '/':	parseComment(in); break;
-		case '0':	return parseBasedNumber(in);
-
+		case 'n':	parseLitt("null"); return checkEnd(NULL_TOKEN);
+		case 't':	parseLitt("true"); return checkEnd(TRUE);
+		case 'f':	parseLitt("false"); return checkEnd(FALSE);
+		case '/':	parseComment(); break;
 		default:
-			if(isNumber(c))
-				return parseNumber(in, c);
-			else
+			if(('0' <= c && c <= '9') || c == '+' || c == '-' || c == '.')
+				return checkEnd(parseNumber());
+			else {
+				p--;
 				error(_ << "bad character '" << c << "' (code = " << int(c) << ")");
+			}
 		}
 	}
 }
 
+
 /**
- * Get the next character.
- * @param in	Input stream.
+ * Get the next batch of offsets of the structural engine. If there is no more
+ * offset, the classic engine takes over.
+ * @return	True if there are more offsets.
  */
-char Parser::nextChar(io::InStream& in) {
-	if(prev != '\0') {
-		char r = prev;
-		prev = '\0';
-		return r;
+bool Parser::moreIndexes(void) {
+	if(ix->next()) {
+		ip = ix->begin();
+		ie = ix->end();
+		return true;
 	}
-	else {
-		int c = in.read();
-		if(c == io::InStream::FAILED)
-			error(in.lastErrorMessage());
-		else if(c == io::InStream::ENDED)
-			return '\0';
-		else if(c == '\n') {
-			line++;
-			col = 0;
+	syncLine();
+	indexed = false;
+	return false;
+}
+
+
+/**
+ * Get next token with the structural engine.
+ * @return		Found token (NONE at end of text).
+ */
+Parser::token_t Parser::nextIndexed(void) {
+	if(ip == ie && !moreIndexes())
+		return next();
+	p = b + *ip++;
+	token_t t;
+	char c = *p++;
+	switch(c) {
+	case '{':	return LBRACE;
+	case '}':	return RBRACE;
+	case '[':	return LBRACK;
+	case ']':	return RBRACK;
+	case ':':	return COLON;
+	case ',':	return COMMA;
+
+	case '"': {
+			const char *s = p;
+			if(ip == ie && !moreIndexes()) {
+				parseString('"');
+				return STRING;
+			}
+			p = b + *ip++;
+			int l = p - s;
+			if(memchr(s, '\\', l) != nullptr) {
+				p = s;
+				parseString('"');
+			}
+			else {
+				if(!utf8::validate(s, l))
+					error("bad UTF-8 encoding in string");
+				if(src)
+					text = src.substring(s - src.chars(), l);
+				else
+					text = String(s, l);
+				p++;
+			}
+			return STRING;
+		}
+
+	case 'n':	parseLitt("null"); t = NULL_TOKEN; break;
+	case 't':	parseLitt("true"); t = TRUE; break;
+	case 'f':	parseLitt("false"); t = FALSE; break;
+
+	default:
+		if(('0' <= c && c <= '9') || c == '+' || c == '-' || c == '.')
+			t = parseNumber();
+		else {
+			p--;
+			error(_ << "bad character '" << c << "' (code = " << int(c) << ")");
 		}
-		return c;
 	}
+
+	return checkEnd(t);
 }
 
 
 /**
- * Parse a number.
- * @param in	Input stream.
- * @param c		First character to parse.
- * @param base	Base for an integer parse.
- * @return		Matching token.
+ * Check that a number or a literal ends with a separator (the scalar values
+ * are not structural and both engines have to reject the same texts).
+ * @param t		Token of the scalar.
+ * @return		t.
  */
-Parser::token_t Parser::parseNumber(io::InStream& in, char c, int base)  {
-	static string dec_base = "0123456789+-.eE";
-	static string hex_base = "0123456789abcdefABCEDEF";
-	static string bin_base = "01";
-	static string float_chars = ".eE";
+Parser::token_t Parser::checkEnd(token_t t) {
+	if(p < e && !isSeparator(*p))
+		error(_ << "bad character '" << *p << "' (code = " << int(*p) << ")");
+	return t;
+}
+
 
-	// select base
+/**
+ * Parse a number whose first character has just been read.
+ * @return		Matching token.
+ */
+Parser::token_t Parser::parseNumber(void)  {
+	const char *s = p - 1;
+	while(p < e && isNumber(*p))
+		p++;
+	if(p < e)
+		return convertNumber(s, p);
+
+	// number crossing the end of the window
 	StringBuffer buf;
-	token_t t = INT;
-	string chars;
-	if(base == 10)
-		chars = dec_base;
-	else if(base == 2) {
-		chars = bin_base;
-		buf << "0b";
+	buf.stream().write(s, p - s);
+	while(refill()) {
+		s = p;
+		while(p < e && isNumber(*p))
+			p++;
+		buf.stream().write(s, p - s);
+		if(p < e)
+			break;
 	}
-	else {
-		chars = hex_base;
-		buf << "0x";
+	text = buf.toString();
+	return convertNumber(text.chars(), text.chars() + text.length());
+}
+
+
+/**
+ * Convert the number in [s, e[ to ival (INT) or fval (FLOAT).
+ * @param s		Start of the number.
+ * @param e		End of the number.
+ * @return		Matching token.
+ */
+Parser::token_t Parser::convertNumber(const char *s, const char *e) {
+	const char *q = s;
+	if(*q == '+' || *q == '-')
+		q++;
+	bool based = e - q > 1 && q[0] == '0'
+		&& (q[1] == 'x' || q[1] == 'X' || q[1] == 'b' || q[1] == 'B');
+	if(based || (!memchr(q, '.', e - q) && !memchr(q, 'e', e - q) && !memchr(q, 'E', e - q))) {
+		if(io::fromChars(s, e, ival, 0) == e)
+			return INT;
+		if(based)
+			error("bad number");
 	}
+	if(io::fromChars(s, e, fval) != e)
+		error("bad number");
+	return FLOAT;
+}
 
-	// scan the number
-	while(chars.indexOf(c) >= 0) {
-		col++;
-		if(float_chars.indexOf(c) >= 0)
-			t = FLOAT;
-		buf << c;
-		c = nextChar(in);
+
+/**
+ * Parse the 4 hexadecimal digits of a \\u escape.
+ * @return		Read UTF-16 unit.
+ */
+t::uint16 Parser::parseHex4(void) {
+	int wc = 0;
+	for(int i = 0; i < 4; i++) {
+		int c = get();
+		int d = c < 0 ? -1 : Char(c).asHex();
+		if(d < 0)
+			error("hex digit expected here");
+		wc = (wc << 4) | d;
 	}
-	pushBack(c);
-	text = buf.toString();
-	return t;
+	return wc;
 }
 
 
 /**
- * Parse a string with support of escapes.
- * @param in	Input stream.
+ * Parse a string with support of escapes. The resulting string is checked
+ * to be valid UTF-8 in one pass (see utf8::validate()). If the string has
+ * no escape and is in the window, it is taken as is.
  * @param q		First quote.
  */
-void Parser::parseString(io::InStream& in, char q) {
-	static string escapes = "\"\'\\/bfnrt";
+void Parser::parseString(char q) {
+	const char *s = p;
+	while(p < e && *p != q && *p != '\\')
+		p++;
+	if(p >= e || *p != q) {
+		parseEscapedString(s, q);
+		return;
+	}
+	int l = p - s;
+	if(!utf8::validate(s, l))
+		error("bad UTF-8 encoding in string");
+	if(src && s >= src.chars() && s < src.chars() + src.length())
+		text = src.substring(s - src.chars(), l);
+	else
+		text = String(s, l);
+	p++;
+}
+
+
+/**
+ * Parse a string containing escapes or crossing the end of the window.
+ * @param s		Start of the string in the window (up to p, the characters
+ *				are neither escapes nor the closing quote).
+ * @param q		Closing quote.
+ */
+void Parser::parseEscapedString(const char *s, char q) {
+	static cstring escapes = "\"\'\\/bfnrt", escaped = "\"\'\\/\b\f\n\r\t";
 	StringBuffer buf;
-	char c = nextChar(in);
-	while(c != q) {
-		if(c != '\\')
-			buf << c;
+	while(true) {
+		buf.stream().write(s, p - s);
+		if(p >= e) {
+			if(!refill())
+				error("unterminated string");
+		}
+		else if(*p == q) {
+			p++;
+			break;
+		}
 		else {
-			c = nextChar(in);
-			if(escapes.indexOf(c) >= 0)
-				text << c;
+			p++;
+			int c = get();
+			int i = c > 0 ? escapes.indexOf(c) : -1;
+			if(i >= 0)
+				buf << escaped[i];
 			else if(c != 'u')
 				error("bad escape in string");
 			else {
-				int wc = 0;
-				for(int i = 0; i < 4; i++) {
-					c = nextChar(in);
-					int d = Char(c).asHex();
-					if(d < 0)
-						error("hex digit expected here");
-					wc = (wc << 4) | d;
-					utf16::Char(wc).toUTF8(buf);
+				t::uint16 w[2] = { parseHex4(), 0 };
+				int n = 1;
+				if(w[0] >= 0xd800 && w[0] < 0xdc00) {
+					if(get() != '\\' || get() != 'u')
+						error("low surrogate expected here");
+					w[1] = parseHex4();
+					n = 2;
 				}
+				char u[6];
+				t::size l = utf8::fromUtf16(w, n, u);
+				if(l == utf8::bad)
+					error("bad UTF-16 surrogate in string");
+				buf.stream().write(u, l);
 			}
 		}
-		c = nextChar(in);
+		s = p;
+		while(p < e && *p != q && *p != '\\')
+			p++;
 	}
 	text = buf.toString();
+	if(!utf8::validate(text))
+		error("bad UTF-8 encoding in string");
 }
 
 
@@ -443,51 +808,39 @@ void Parser::parseString(io::InStream& in, char q) {
  * Parse a literal string.
  * @param litt	Literal string to parse (first character is ignored).
  */
-void Parser::parseLitt(io::InStream& in, cstring litt) {
+void Parser::parseLitt(cstring litt) {
 	for(int i = 1; i < litt.length(); i++)
-		if(nextChar(in) != litt[i])
+		if(get() != litt[i])
 			error("unknown identifier");
 }
 
 
 /**
  * Parse a comment.
- * @param in	Input stream.
  */
-void Parser::parseComment(io::InStream& in) {
-	char c = nextChar(in);
-	if(c == '/')
-		while(c != '\n')
-			c = nextChar(in);
+void Parser::parseComment(void) {
+	int c = get();
+	if(c == '/') {
+		while(c >= 0 && c != '\n')
+			c = get();
+		if(c == '\n')
+			newLine();
+	}
 	else if(c == '*') {
+		int pc = 0;
 		while(true) {
-			while(nextChar(in) != '*');
-			if(nextChar(in) == '/')
+			c = get();
+			if(c < 0)
+				error("unterminated comment");
+			if(c == '\n')
+				newLine();
+			else if(pc == '*' && c == '/')
 				break;
+			pc = c;
 		}
 	}
 	else
 		error("bad character");
 }
 
-
-/**
- * Parser a based number.
- * @param in	Input stream.
- */
-Parser::token_t Parser::parseBasedNumber(io::InStream& in) {
-	char c = nextChar(in);
-	if(c == 'x' || c == 'X')
-		return parseNumber(in, nextChar(in), 16);
-	else if(c == 'b' || c == 'B')
-		return parseNumber(in, nextChar(in), 2);
-	else if(isNumber(c))
-		return parseNumber(in, c);
-	else {
-		pushBack(c);
-		text = "0";
-		return INT;
-	}
-}
-
 } }	// elm::json
@@ -0,0 +1,371 @@
+/*
+ *	Rope class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/assert.h>
+#include <elm/io/IOException.h>
+#include <elm/string/Rope.h>
+
+namespace elm {
+
+/**
+ * @class Rope
+ * A rope is a string made of a balanced tree of @ref String fragments.
+ * Unlike String::concat(), concatenating two ropes does not copy the
+ * characters and costs O(log n), as extracting a sub-rope or accessing
+ * a character by its index. This makes ropes well suited to build big texts,
+ * as reports or serializations, from many fragments.
+ *
+ * A rope is immutable and its nodes are shared (and reference-counted) by the
+ * ropes built from it: ropes are as cheap to copy as strings. The characters
+ * are only gathered in a single @ref String when toString() is called;
+ * a rope can also be written to an output without being flattened.
+ *
+ * @code
+ * Rope r;
+ * for(auto f: fragments)
+ *	r += f;
+ * r.write(io::out);
+ * @endcode
+ *
+ * Short fragments (up to Rope::leaf_max characters in total) are merged
+ * when concatenated to avoid a tree node per character.
+ *
+ * @ingroup string
+ */
+
+/**
+ * @var int Rope::leaf_max;
+ * Maximum length of a fragment obtained by merging two concatenated
+ * fragments.
+ */
+
+
+// build an internal node
+Rope::node_t::node_t(node_t *l, node_t *r)
+:	use(1),
+	len(l->len + r->len),
+	height((l->height > r->height ? l->height : r->height) + 1),
+	left(l),
+	right(r)
+{ }
+
+
+/**
+ * Build a rope from a string.
+ * @param s		Initial string.
+ */
+Rope::Rope(const String& s): n(s ? new node_t(s) : nullptr) {
+}
+
+
+/**
+ * @fn Rope::Rope(void);
+ * Build an empty rope.
+ */
+
+/**
+ * @fn Rope::Rope(cstring s);
+ * Build a rope from a C string.
+ * @param s		Initial string.
+ */
+
+/**
+ * @fn int Rope::length(void) const;
+ * Get the length of the rope.
+ * @return	Rope length.
+ */
+
+/**
+ * @fn bool Rope::isEmpty(void) const;
+ * Test if the rope is empty.
+ * @return	True if the rope is empty, false else.
+ */
+
+
+// release a node
+void Rope::unlock(const node_t *p) {
+	if(p && RefCount<t::intptr>::decr(p->use)) {
+		unlock(p->left);
+		unlock(p->right);
+		delete p;
+	}
+}
+
+
+// build a node from l and r (taking their references)
+Rope::node_t *Rope::make(node_t *l, node_t *r) {
+	return new node_t(l, r);
+}
+
+
+// build a node from l and r whose heights differ by at most 2
+// (taking their references), rotating it to keep it balanced
+Rope::node_t *Rope::balance(node_t *l, node_t *r) {
+	int hl = height(l), hr = height(r);
+	if(hl > hr + 1) {
+		node_t *a = l->left, *b = l->right;
+		lock(a);
+		lock(b);
+		unlock(l);
+		if(height(a) >= height(b))
+			return make(a, make(b, r));
+		node_t *bl = b->left, *br = b->right;
+		lock(bl);
+		lock(br);
+		unlock(b);
+		return make(make(a, bl), make(br, r));
+	}
+	else if(hr > hl + 1) {
+		node_t *a = r->left, *b = r->right;
+		lock(a);
+		lock(b);
+		unlock(r);
+		if(height(b) >= height(a))
+			return make(make(l, a), b);
+		node_t *al = a->left, *ar = a->right;
+		lock(al);
+		lock(ar);
+		unlock(a);
+		return make(make(l, al), make(ar, b));
+	}
+	else
+		return make(l, r);
+}
+
+
+// concatenate l and r (taking their references), the cost is proportional
+// to the difference of heights of l and r
+Rope::node_t *Rope::join(node_t *l, node_t *r) {
+	if(!l)
+		return r;
+	if(!r)
+		return l;
+
+	// merge short leaves
+	if(isLeaf(l) && isLeaf(r) && l->len + r->len <= leaf_max) {
+		node_t *p = new node_t(l->str.concat(r->str));
+		unlock(l);
+		unlock(r);
+		return p;
+	}
+
+	// join at the level of the smallest tree
+	int hl = height(l), hr = height(r);
+	if(hl > hr + 1) {
+		node_t *a = l->left, *b = l->right;
+		lock(a);
+		lock(b);
+		unlock(l);
+		return balance(a, join(b, r));
+	}
+	else if(hr > hl + 1) {
+		node_t *a = r->left, *b = r->right;
+		lock(a);
+		lock(b);
+		unlock(r);
+		return balance(join(l, a), b);
+	}
+	else
+		return make(l, r);
+}
+
+
+/**
+ * Concatenate the current rope with the given one. The characters
+ * of the ropes are not copied.
+ * @param r		Rope to append.
+ * @return		Concatenated rope.
+ */
+Rope Rope::concat(const Rope& r) const {
+	lock(n);
+	lock(r.n);
+	return Rope(join(n, r.n));
+}
+
+/**
+ * @fn Rope Rope::operator+(const Rope& r) const;
+ * Same as concat(). Also available with a String, a CString
+ * or a C string.
+ */
+
+/**
+ * @fn Rope& Rope::operator+=(const Rope& r);
+ * Append the given rope to the current one. Also available with a String,
+ * a CString or a C string.
+ * @param r		Rope to append.
+ * @return		Current rope.
+ */
+
+
+/**
+ * Get a character by its index.
+ * @param i		Character index (in [0, length()[).
+ * @return		Found character.
+ */
+char Rope::charAt(int i) const {
+	ASSERTP(0 <= i && i < length(), "index out of bounds");
+	const node_t *p = n;
+	while(!isLeaf(p)) {
+		if(i < p->left->len)
+			p = p->left;
+		else {
+			i -= p->left->len;
+			p = p->right;
+		}
+	}
+	return p->str[i];
+}
+
+/**
+ * @fn char Rope::operator[](int i) const;
+ * Same as charAt().
+ */
+
+
+// build the node for the range [off, off + len[ of p (p is not released)
+Rope::node_t *Rope::sub(node_t *p, int off, int len) {
+	if(len <= 0)
+		return nullptr;
+	if(off == 0 && len == p->len) {
+		lock(p);
+		return p;
+	}
+	if(isLeaf(p))
+		return new node_t(p->str.substring(off, len));
+	int ll = p->left->len;
+	if(off + len <= ll)
+		return sub(p->left, off, len);
+	else if(off >= ll)
+		return sub(p->right, off - ll, len);
+	else
+		return join(sub(p->left, off, ll - off), sub(p->right, 0, off + len - ll));
+}
+
+
+/**
+ * Extract a sub-rope. Only the fragments at the bounds of the sub-rope
+ * are shortened (sharing the buffer of the original fragment).
+ * @param off	Offset of the sub-rope.
+ * @param len	Length of the sub-rope.
+ * @return		Sub-rope.
+ */
+Rope Rope::substring(int off, int len) const {
+	ASSERTP(0 <= off && 0 <= len && off + len <= length(), "sub-rope out of bounds");
+	return Rope(sub(n, off, len));
+}
+
+/**
+ * @fn Rope Rope::substring(int off) const;
+ * Extract the end of a rope.
+ * @param off	Offset of the sub-rope.
+ * @return		Sub-rope.
+ */
+
+
+// copy the characters of p in buf
+void Rope::flatten(const node_t *p, char *buf) {
+	while(!isLeaf(p)) {
+		flatten(p->left, buf);
+		buf += p->left->len;
+		p = p->right;
+	}
+	memcpy(buf, p->str.chars(), p->len);
+}
+
+
+/**
+ * Gather the characters of the rope in a string. This costs a copy of the
+ * characters (except for a rope made of a single fragment).
+ * @return	Flattened string.
+ */
+String Rope::toString(void) const {
+	if(!n)
+		return String();
+	if(isLeaf(n))
+		return n->str;
+	String::buffer_t *b = (String::buffer_t *)new char[String::zero_off + n->len + 1];
+	flatten(n, b->buf);
+	b->buf[n->len] = '\0';
+	return String(b, n->len);
+}
+
+/**
+ * Write the rope, fragment by fragment, to the given stream, without
+ * flattening it.
+ * @param out	Stream to write to.
+ * @throw io::IOException	If there is a stream error.
+ */
+void Rope::write(io::OutStream& out) const {
+	for(Iter i(*this); i(); i++)
+		if(out.write((*i).chars(), (*i).length()) < 0)
+			throw io::IOException(out.lastErrorMessage());
+}
+
+
+/**
+ * Print the rope, fragment by fragment, to the given output, without
+ * flattening it.
+ * @param out	Output to print to.
+ * @throw io::IOException	If there is a stream error.
+ */
+void Rope::print(io::Output& out) const {
+	for(Iter i(*this); i(); i++)
+		out.print(*i);
+}
+
+
+/**
+ * @class Rope::Iter
+ * Iterator on the fragments of a rope, from the first to the last one.
+ */
+
+// go down to the leftmost leaf of p
+void Rope::Iter::down(const node_t *p) {
+	if(!p)
+		return;
+	while(!isLeaf(p)) {
+		ASSERT(sp < max_height);
+		s[sp++] = p->right;
+		p = p->left;
+	}
+	cur = p;
+}
+
+/**
+ * Go to the next fragment.
+ */
+void Rope::Iter::next(void) {
+	if(sp == 0)
+		cur = nullptr;
+	else
+		down(s[--sp]);
+}
+
+/**
+ * @fn io::Output& operator<<(io::Output& out, const Rope& r);
+ * Print a rope without flattening it.
+ * @param out	Output to print to.
+ * @param r		Printed rope.
+ * @return		Output.
+ * @ingroup string
+ */
+
+}	// elm
@@ -74,7 +74,9 @@
   * @li litteral C++ string to any string.
   * 
   * Finally, there some methods to perform tests or retrieval of strings:
-  * @li indexOf() and lastIndexOf() to retrieve a single character,
+  * @li indexOf() and lastIndexOf() to retrieve a single character, a
+  * sub-string or any character of a @ref chars::Set (these searches use
+  * the vectorized primitives of @ref search),
   * @li startsWith() and endsWith() to test prefixes and suffixes.
   * 
   * And some methods to build strings:
@@ -119,6 +121,7 @@
   * @li @ref Char -- character operations.
   * @li @ref Formatter -- formatter for string supporting "%" escapes.
   * @li @ref StringSplit -- splitter for strings.
+  * @li @ref Rope -- balanced tree of fragments for big incremental texts.
   * @li @ref utf8::Iter
   * @li @ref utf16::Char
   */
@@ -129,39 +132,115 @@
  * An immutable implementation of the string data type. Refer to
  * @ref StringBuffer for long concatenation string building.
  * @ingroup string
- * @warning This string class is bound to strings of less than 65535 characters.
+ *
+ * Strings of up to 11 characters (7 on 32-bit hosts) are
+ * stored inside the String object itself and never allocate. Longer strings
+ * share a reference-counted buffer: copies and substrings that are not
+ * small only reference this buffer, without copying the characters.
+ * A string may be up to 2^31-1 characters long.
+ *
+ * As a consequence, the pointer returned by chars(), toCString() or
+ * asSysString() is only valid as long as the String object it is obtained
+ * from is alive and not assigned: for a small string, it points inside
+ * this object and not inside a buffer shared with the copies. A class that
+ * keeps such a pointer must also keep the String it comes from.
+ *
+ * By default, the use count of the buffer is not atomic: a string (or its
+ * copies) cannot be shared between threads. When ELM is configured with
+ * ELM_ATOMIC_REF (cmake -DELM_ATOMIC_REF=ON), the use count is handled with
+ * atomic operations (see @ref RefCount) and the copies of a string may be used
+ * and released concurrently, a String object itself being not thread-safe.
  */
 
- /* Empty buffer */
- String::buffer_t String::empty_buf = { 1, { 0 } };
- 
- /**
-  * Make a string by copying the given character array.
-  * @param str	Character array address.
-  * @param _len	Character array length.
-  */
- void String::copy(const char *str, int _len) {
- 	
- 	// empty string?
- 	if(!_len) {
- 		buf = (char *)&empty_buf;
- 		off = zero_off;
- 		len = 0;
- 		lock();
- 	}
- 	
- 	// Create the buffer
- 	else {
-		buf = new char[sizeof(buffer_t) + _len]; 
-		buffer_t *desc = (buffer_t *)buf;
+/**
+ * Make a string by copying the given character array.
+ * @param str	Character array address.
+ * @param _len	Character array length.
+ */
+void String::copy(const char *str, int _len) {
+
+	// small string?
+	if(_len <= local_max) {
+		u.loc.len = _len;
+		memcpy(u.loc.buf, str, _len);
+		u.loc.buf[_len] = '\0';
+	}
+
+	// Create the buffer
+	else {
+		buffer_t *desc = (buffer_t *)new char[zero_off + _len + 1];
 		desc->use = 1;
 		memcpy(desc->buf, str, _len);
 		desc->buf[_len] = '\0';
-		off = zero_off;
-		len = _len; 
- 	}
+		u.ref.buf = (char *)desc;
+		u.ref.off = zero_off;
+		u.ref.len = _len;
+	}
 }
 
+
+/**
+ * Copy a string in a block obtained from an allocator. The block must be
+ * zero_off + _len + sizeof(t::intptr) bytes long (the extra bytes allow to align
+ * the buffer). The buffer use count is marked with arena_use so that it
+ * never reaches 0: the buffer is never released by the string.
+ * @param str	String to copy.
+ * @param _len	String length.
+ * @param block	Block to copy to.
+ */
+void String::copy(const char *str, int _len, void *block) {
+	t::intptr a = (t::intptr(block) + sizeof(t::intptr) - 1) & ~t::intptr(sizeof(t::intptr) - 1);
+	buffer_t *desc = (buffer_t *)a;
+	desc->use = arena_use + 1;
+	memcpy(desc->buf, str, _len);
+	desc->buf[_len] = '\0';
+	u.ref.buf = (char *)desc;
+	u.ref.off = zero_off;
+	u.ref.len = _len;
+}
+
+
+/**
+ * Build a sub-string of the given string. If the sub-string is small enough,
+ * it is copied locally; else it shares the buffer of the given string.
+ * @param str	Parent string.
+ * @param off	Offset of the sub-string in the parent.
+ * @param len	Length of the sub-string.
+ */
+String::String(const String& str, int off, int len) {
+	if(len <= local_max)
+		copy(str.chars() + off, len);
+	else {
+		u.ref.buf = str.u.ref.buf;
+		u.ref.off = str.u.ref.off + off;
+		u.ref.len = len;
+		lock();
+	}
+}
+
+
+/**
+ * Build a string taking the ownership of the given buffer. The buffer must
+ * have been allocated with "new char[]", must have room for the buffer_t
+ * header and must be null-terminated. If the string is small, it is copied
+ * locally and the buffer is released.
+ * @param buffer	Buffer to use.
+ * @param length	Length of the string in the buffer.
+ */
+String::String(buffer_t *buffer, int length) {
+	if(length <= local_max) {
+		copy(buffer->buf, length);
+		delete [] (char *)buffer;
+	}
+	else {
+		buffer->use = 1;
+		u.ref.buf = (char *)buffer;
+		u.ref.off = zero_off;
+		u.ref.len = length;
+	}
+}
+
+
 /**
  * Build a string with a single character.
  * @param chr	Character containing the string.
@@ -169,8 +248,7 @@
  * @return		Built string.
  */
 String String::make(char chr) {
-	char buf[2] = { chr, '\0' };
-	return String(buf);
+	return String(&chr, 1);
 }
 
 /**
@@ -193,12 +271,19 @@ String String::make(String str, int n) {
  * @param l2	Second character array length.
  */
 String String::concat(const char *s1, int l1, const char *s2, int l2) {
-	buffer_t *sbuf = (buffer_t *)new char[sizeof(String::buffer_t) + l1 + l2];
-	sbuf->use = 0;
+	if(l1 + l2 <= local_max) {
+		String r;
+		r.u.loc.len = l1 + l2;
+		memcpy(r.u.loc.buf, s1, l1);
+		memcpy(r.u.loc.buf + l1, s2, l2);
+		r.u.loc.buf[l1 + l2] = '\0';
+		return r;
+	}
+	buffer_t *sbuf = (buffer_t *)new char[zero_off + l1 + l2 + 1];
 	memcpy(sbuf->buf, s1, l1);
 	memcpy(sbuf->buf + l1, s2, l2);
 	sbuf->buf[l1 + l2] = '\0';
-	return String((char *)sbuf, zero_off, l1 + l2);
+	return String(sbuf, l1 + l2);
 }
 
 
@@ -208,22 +293,21 @@ String String::concat(const char *s1, int l1, const char *s2, int l2) {
  * is simply added. Else a new buffer is created.
  */
 void String::toc(void) const {
-	
+
 	// Only one owner
-	buffer_t *sbuf = (buffer_t *)buf;
-	if(sbuf->use <= 1)
-		sbuf->buf[len] = '\0';
-	
+	if((RefCount<t::intptr>::get(buffer()->use) & ~arena_use) <= 1)
+		((char *)u.ref.buf)[u.ref.off + u.ref.len] = '\0';
+
 	// Build a new buffer
 	else {
-		char *nbuf = new char[sizeof(buffer_t) + len]; 
-		buffer_t *nsbuf = (buffer_t *)nbuf;
+		int len = u.ref.len;
+		buffer_t *nsbuf = (buffer_t *)new char[zero_off + len + 1];
 		nsbuf->use = 1;
 		memcpy(nsbuf->buf, chars(), len);
-		unlock();
 		nsbuf->buf[len] = '\0';
-		off = zero_off;
-		buf = nbuf;
+		unlock();
+		u.ref.off = zero_off;
+		u.ref.buf = (char *)nsbuf;
 	}
 }
 
@@ -242,6 +326,22 @@ void String::toc(void) const {
  */
 
 
+/**
+ * @fn String::String(const char *str, int _len, A& alloc)
+ * Build a string from a character array whose buffer is allocated with the
+ * given allocator, typically a @ref StackAllocator used as an arena for the
+ * temporary strings of a parse or format pass. The string never releases
+ * its buffer: the memory is reclaimed by the allocator (for example with
+ * StackAllocator::release()) and the string, and its copies, must no more be
+ * used afterwards. Small strings are stored inside the String object and
+ * do not use the allocator.
+ * @param str	Character array base.
+ * @param _len	Character array length.
+ * @param alloc	Allocator of the buffer (must provide a function allocate(size)).
+ * @param A		Type of the allocator.
+ */
+
+
 /**
  * @fn String::String(const char *str);
  * Build an ELM string from a C string.
@@ -298,6 +398,9 @@ void String::toc(void) const {
  * @fn const char *String::chars(void) const;
  * Get access to internal representation of the string. Use it with caution and
  * recall that the got buffer may be shared by many different strings.
+ * The pointer is only valid while the current String object is alive and not
+ * assigned, even if other copies of the string exist (small strings
+ * are stored inside the String object).
  * @return	Raw access to character buffer.
  */
 
@@ -338,7 +441,8 @@ void String::toc(void) const {
  * Convert the current string to a CString object.
  * @return	Matching CString object.
  * @warning The returned CString contains a pointer to a buffer owned by the
- * current string. This buffer is only valid while the current is living.
+ * current string. This buffer is only valid while the current String object
+ * is living and not assigned (see chars()).
  */
 
 
@@ -422,6 +526,16 @@ void String::toc(void) const {
  */
 
 
+/**
+ * @fn int String::indexOf(const chars::Set& set, int pos) const;
+ * Get the index of the first character of the string, from the given
+ * position, that belongs to the given set.
+ * @param set	Set of characters to look for.
+ * @param pos	Position to start to look for.
+ * @return		Index of the found character or -1.
+ */
+
+
 /**
  * @fn int String::lastIndexOf(char chr) const;
  * Get the last index of a character in the string.
@@ -495,18 +609,10 @@ void String::toc(void) const {
  * @param string	String to look for.
  * @param pos		Start position.
  */
-int String::indexOf(const String& string, int pos) {
+int String::indexOf(const String& string, int pos) const {
 	ASSERTP(string, "cannot look for an empty string");
-	while(pos >= 0) {
-		pos = indexOf(string[0], pos);
-		if(pos >= 0) {
-			if(substring(pos, string.length()) == string) 
-				return pos;
-			else
-				pos++;
-		}
-	}
-	return -1;
+	const char *p = chars::find(chars() + pos, length() - pos, string.chars(), string.length());
+	return p ? p - chars() : -1;
 }
 
 
@@ -515,14 +621,13 @@ int String::indexOf(const String& string, int pos) {
  * @param string	String to look for.
  * @param pos		Position to start to look before.
  */
-int String::lastIndexOf(const String& string, int pos) {
+int String::lastIndexOf(const String& string, int pos) const {
 	ASSERTP(string, "cannot look for an empty string");
-	while(pos >= 0) {
-		pos = lastIndexOf(string[0], pos);
-		if(pos >= 0 && substring(pos, string.length()) == string)
-				return pos;
-	}
-	return -1;
+	int n = pos - 1 + string.length();
+	if(n > length())
+		n = length();
+	const char *p = chars::findLast(chars(), n, string.chars(), string.length());
+	return p ? p - chars() : -1;
 }
 
 
@@ -619,8 +724,10 @@ string String::replace(string pat, string sub) {
 /**
  * @class StringSplit
  * This is an helper class to split a string in sub-parts
- * using a separator (character or string). At each iteration,
- * the next separated part is provided.
+ * using a separator (character, string or any character of a
+ * @ref chars::Set). At each iteration, the next separated part is provided.
+ * Only a splitter built from a set allocates a copy of this set: splitting
+ * on a character or a string costs no more than looking for it.
  *
  * Notice that the split of an empty string iterates exactly
  * once and its unique value is the empty string.
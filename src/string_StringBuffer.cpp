@@ -43,12 +43,48 @@ namespace elm {
 
 	
 /**
- * @fn String StringBuffer::toString(void);
  * Convert the buffer to a string. The string buffer must no more be used after this call.
+ * Long strings take the ownership of the buffer memory; small strings are
+ * copied inside the String and the buffer memory is kept.
  * @return String contained in the buffer.
  */
+String StringBuffer::toString() {
+	int len = length();
+	if(len <= String::local_max) {
+		String r(_stream.block() + String::zero_off, len);
+		_stream.setSize(String::zero_off);
+		return r;
+	}
+	_stream.write('\0');
+	return String((String::buffer_t *)_stream.detach(), len);
+}
 	
 	
+/**
+ * @fn String StringBuffer::toString(A& alloc);
+ * Copy the buffer content to a string allocated with the given allocator
+ * (see String::String(const char *, int, A&)) and empty the buffer.
+ * Unlike toString(), the buffer keeps its memory and may be used again:
+ * a single string buffer and an arena, like @ref StackAllocator, allow to build
+ * many temporary strings without any call to the system allocator.
+ *
+ * @code
+ * StackAllocator arena;
+ * StackAllocator::mark_t m = arena.mark();
+ * StringBuffer buf;
+ * for(auto x: items) {
+ *	buf << x.name << ':' << x.value;
+ *	String s = buf.toString(arena);
+ *	...
+ * }
+ * arena.release(m);
+ * @endcode
+ * @param alloc	Allocator of the string buffer.
+ * @param A		Type of the allocator.
+ * @return		Built string.
+ */
+
+
 /**
  * @fn int StringBuffer::length(void) const;
  * Get the length of the string stored in the buffer.
@@ -62,6 +98,14 @@ namespace elm {
  */
 
 
+/**
+ * @fn void StringBuffer::reserve(int length);
+ * Ensure that the buffer can store a string of the given length
+ * without re-allocation.
+ * @param length	Reserved string length.
+ */
+
+
 /**
  * @fn io::OutStream& StringBuffer::stream(void);
  * Get the an output stream to write to the string buffer.
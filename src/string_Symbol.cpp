@@ -0,0 +1,243 @@
+/*
+ *	Symbol class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2015, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/string/Symbol.h>
+
+namespace elm {
+
+/**
+ * @class Symbol
+ * A symbol is an interned string: all symbols made of the same characters,
+ * and obtained from the same SymbolTable, share the same unique entry.
+ * Therefore, comparing two symbols for equality or hashing a symbol
+ * only involves the entry pointer, instead of the characters as for String.
+ * A symbol is as cheap to copy as a pointer.
+ *
+ * The symbols built from a String, a CString or a C string use the global
+ * symbol table (SymbolTable::global()). Interning a string costs a hash
+ * computation and a look-up: symbols pay off when the same names are compared
+ * or used as keys many times, as identifiers, XML tag names or JSON field names.
+ *
+ * @code
+ * Symbol id("main"), name = Symbol(string("ma") + "in");
+ * ASSERT(id == name);		// pointer comparison
+ * HashMap<Symbol, int> map;	// pointer hashing
+ * @endcode
+ *
+ * The order of symbols (compare(), <, <=, etc) is the order of their strings.
+ * @ingroup string
+ */
+
+
+/**
+ * @fn Symbol::Symbol(void);
+ * Build the empty symbol. It is equal to the symbol of the empty string
+ * whatever the symbol table.
+ */
+
+/**
+ * @fn Symbol::Symbol(const String& s);
+ * Build a symbol from the global symbol table.
+ * @param s		Symbol string.
+ */
+
+/**
+ * @fn Symbol::Symbol(cstring s);
+ * Build a symbol from the global symbol table.
+ * @param s		Symbol string.
+ */
+
+/**
+ * @fn Symbol::Symbol(const char *s);
+ * Build a symbol from the global symbol table.
+ * @param s		Symbol string.
+ */
+
+/**
+ * @fn const String& Symbol::toString(void) const;
+ * Get the string of the symbol (this String is shared and copying it
+ * does not involve any allocation). The buffer of the string belongs
+ * to the symbol table and is never released by its copies: they may be
+ * made and dropped concurrently by several threads.
+ * @return	Symbol string.
+ */
+
+/**
+ * @fn t::hash Symbol::hash(void) const;
+ * Get the hash of the symbol, computed from the entry pointer.
+ * @return	Symbol hash.
+ */
+
+/**
+ * @fn int Symbol::compare(const Symbol& s) const;
+ * Compare the strings of symbols.
+ * @param s		Symbol to compare with.
+ * @return		0 for equality, <0 if the current symbol is less than s, >0 else.
+ */
+
+/**
+ * Build a symbol entry. The characters of the string are stored in a block
+ * owned by the entry, with an arena use count: they are released
+ * with the entry and, as the copies of the string never release them,
+ * their non-atomic use count may be modified concurrently.
+ * @param chars		Symbol characters.
+ * @param length	Symbol length.
+ * @param h			Symbol hash.
+ */
+Symbol::entry_t::entry_t(const char *chars, int length, t::hash h): str(chars, length, block), hash(h) {
+}
+
+const Symbol::entry_t Symbol::null_entry("", 0, 0);
+
+
+/**
+ * @class SymbolTable
+ * A symbol table stores the unique entries of the symbols. Besides
+ * the global symbol table, local tables may be built: the symbols
+ * of different tables must not be compared and the symbols of a local table
+ * must not be used after the table is deleted. The symbol tables may
+ * be used concurrently by several threads.
+ * @ingroup string
+ */
+
+
+/**
+ * Build a symbol table.
+ * @param size	Initial size of the table (power of 2).
+ */
+SymbolTable::SymbolTable(int _size): size(1), cnt(0) {
+	while(size < _size)
+		size <<= 1;
+	tab = new Symbol::entry_t *[size];
+	for(int i = 0; i < size; i++)
+		tab[i] = nullptr;
+}
+
+
+/**
+ */
+SymbolTable::~SymbolTable(void) {
+	for(int i = 0; i < size; i++)
+		if(tab[i] != nullptr)
+			delete tab[i];
+	delete [] tab;
+}
+
+
+/**
+ * Get the global symbol table. This table is never deleted so that
+ * symbols may be used during static destruction.
+ * @return	Global symbol table.
+ */
+SymbolTable& SymbolTable::global(void) {
+	static SymbolTable *table = new SymbolTable(4096);
+	return *table;
+}
+
+
+/**
+ * Get the symbol for the given characters, creating it if needed.
+ * @param chars		Symbol characters.
+ * @param length	Number of characters.
+ * @return			Symbol.
+ */
+Symbol SymbolTable::intern(const char *chars, int length) {
+	if(length == 0)
+		return Symbol();
+	t::hash h = hash_string(chars, length);
+	sys::LockGuard<sys::SpinLock> guard(lock);
+	int i = find(chars, length, h);
+	if(tab[i] == nullptr) {
+		tab[i] = new Symbol::entry_t(chars, length, h);
+		cnt++;
+		Symbol s(tab[i]);
+		if(cnt * 4 > size * 3)
+			grow();
+		return s;
+	}
+	return Symbol(tab[i]);
+}
+
+
+/**
+ * Look for an existing symbol without creating it.
+ * @param chars		Symbol characters.
+ * @param length	Number of characters.
+ * @return			Found symbol or none if the symbol does not exist
+ * 					(the empty string is always found).
+ */
+Option<Symbol> SymbolTable::lookup(const char *chars, int length) {
+	if(length == 0)
+		return Symbol();
+	t::hash h = hash_string(chars, length);
+	sys::LockGuard<sys::SpinLock> guard(lock);
+	int i = find(chars, length, h);
+	if(tab[i] == nullptr)
+		return none;
+	return Symbol(tab[i]);
+}
+
+
+/**
+ * @fn int SymbolTable::count(void) const;
+ * Get the number of symbols in the table.
+ * @return	Symbol count.
+ */
+
+
+/**
+ * Find the slot of the given string (linear probing).
+ * @return	Index of the slot containing the string or of the empty slot
+ * 			where the string has to be inserted.
+ */
+int SymbolTable::find(const char *chars, int length, t::hash h) const {
+	int i = int(h & (size - 1));
+	while(tab[i] != nullptr) {
+		const Symbol::entry_t *e = tab[i];
+		if(e->hash == h && e->str.length() == length && memcmp(e->str.chars(), chars, length) == 0)
+			break;
+		i = (i + 1) & (size - 1);
+	}
+	return i;
+}
+
+
+/**
+ * Double the size of the table.
+ */
+void SymbolTable::grow(void) {
+	Symbol::entry_t **otab = tab;
+	int osize = size;
+	size *= 2;
+	tab = new Symbol::entry_t *[size];
+	for(int i = 0; i < size; i++)
+		tab[i] = nullptr;
+	for(int i = 0; i < osize; i++)
+		if(otab[i] != nullptr) {
+			int j = int(otab[i]->hash & (size - 1));
+			while(tab[j] != nullptr)
+				j = (j + 1) & (size - 1);
+			tab[j] = otab[i];
+		}
+	delete [] otab;
+}
+
+}	// elm
@@ -0,0 +1,282 @@
+/*
+ *	character search primitives implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/string/search.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#	define ELM_SEARCH_X86
+#	include <immintrin.h>
+#endif
+
+namespace elm { namespace chars {
+
+/**
+ * @defgroup search Character Search
+ *
+ * This module provides the primitives used by @ref String, @ref CString and
+ * @ref StringSplit to look for characters in a character array:
+ * @li chars::find() and chars::findLast() for a single character,
+ * @li chars::find() and chars::findLast() for a sub-string,
+ * @li chars::Set::find() for any character of a set.
+ *
+ * The single character and the forward sub-string searches rely on the
+ * C library (memchr(), memrchr() and memmem() with the GNU C library) that
+ * already selects at run-time a vectorized implementation for the host.
+ * The set search uses SSE2 or AVX2 instructions on x86 hosts supporting them
+ * (selected at the first call) and falls back to a scalar bit table else.
+ *
+ * All functions return a pointer to the found character or a null pointer.
+ *
+ * @ingroup string
+ */
+
+
+/**
+ * @fn const char *find(const char *p, int n, char c);
+ * Look for the first occurrence of a character.
+ * @param p		Base of the character array.
+ * @param n		Length of the character array.
+ * @param c		Looked character.
+ * @return		Pointer to the found character or null.
+ * @ingroup search
+ */
+
+
+/**
+ * Look for the last occurrence of a character.
+ * @param p		Base of the character array.
+ * @param n		Length of the character array.
+ * @param c		Looked character.
+ * @return		Pointer to the found character or null.
+ * @ingroup search
+ */
+const char *findLast(const char *p, int n, char c) {
+	if(n <= 0)
+		return nullptr;
+#	ifdef __GLIBC__
+		return static_cast<const char *>(memrchr(p, c, n));
+#	else
+		for(const char *q = p + n - 1; q >= p; q--)
+			if(*q == c)
+				return q;
+		return nullptr;
+#	endif
+}
+
+
+/**
+ * Look for the first occurrence of a sub-string.
+ * @param p		Base of the character array.
+ * @param n		Length of the character array.
+ * @param s		Base of the looked sub-string.
+ * @param m		Length of the looked sub-string (not null).
+ * @return		Pointer to the found sub-string or null.
+ * @ingroup search
+ */
+const char *find(const char *p, int n, const char *s, int m) {
+	if(m > n)
+		return nullptr;
+	if(m == 1)
+		return find(p, n, *s);
+#	ifdef __GLIBC__
+		return static_cast<const char *>(memmem(p, n, s, m));
+#	else
+		for(const char *q = p, *e = p + n - m + 1; q < e; q++) {
+			q = find(q, e - q, *s);
+			if(q == nullptr)
+				return nullptr;
+			if(!memcmp(q, s, m))
+				return q;
+		}
+		return nullptr;
+#	endif
+}
+
+
+/**
+ * Look for the last occurrence of a sub-string.
+ * @param p		Base of the character array.
+ * @param n		Length of the character array.
+ * @param s		Base of the looked sub-string.
+ * @param m		Length of the looked sub-string (not null).
+ * @return		Pointer to the found sub-string or null.
+ * @ingroup search
+ */
+const char *findLast(const char *p, int n, const char *s, int m) {
+	for(int l = n - m + 1; l > 0; ) {
+		const char *q = findLast(p, l, *s);
+		if(q == nullptr)
+			return nullptr;
+		if(!memcmp(q, s, m))
+			return q;
+		l = q - p;
+	}
+	return nullptr;
+}
+
+
+// scalar set search
+static const char *find_scalar(const char *cs, int k, const char *p, int n) {
+	for(const char *e = p + n; p < e; p++)
+		for(int j = 0; j < k; j++)
+			if(*p == cs[j])
+				return p;
+	return nullptr;
+}
+
+#ifdef ELM_SEARCH_X86
+
+// SSE2 set search
+__attribute__((target("sse2")))
+static const char *find_sse2(const char *cs, int k, const char *p, int n) {
+	__m128i v[Set::simd_max];
+	for(int j = 0; j < k; j++)
+		v[j] = _mm_set1_epi8(cs[j]);
+	int i = 0;
+	for(; i + 16 <= n; i += 16) {
+		__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+		__m128i m = _mm_cmpeq_epi8(b, v[0]);
+		for(int j = 1; j < k; j++)
+			m = _mm_or_si128(m, _mm_cmpeq_epi8(b, v[j]));
+		int r = _mm_movemask_epi8(m);
+		if(r)
+			return p + i + __builtin_ctz(r);
+	}
+	return find_scalar(cs, k, p + i, n - i);
+}
+
+// AVX2 set search
+__attribute__((target("avx2")))
+static const char *find_avx2(const char *cs, int k, const char *p, int n) {
+	__m256i v[Set::simd_max];
+	for(int j = 0; j < k; j++)
+		v[j] = _mm256_set1_epi8(cs[j]);
+	int i = 0;
+	for(; i + 32 <= n; i += 32) {
+		__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+		__m256i m = _mm256_cmpeq_epi8(b, v[0]);
+		for(int j = 1; j < k; j++)
+			m = _mm256_or_si256(m, _mm256_cmpeq_epi8(b, v[j]));
+		unsigned r = _mm256_movemask_epi8(m);
+		if(r)
+			return p + i + __builtin_ctz(r);
+	}
+	return find_sse2(cs, k, p + i, n - i);
+}
+
+#endif
+
+// select the set search of the host
+typedef const char *(*set_find_t)(const char *cs, int k, const char *p, int n);
+static set_find_t select_find(void) {
+#	ifdef ELM_SEARCH_X86
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("avx2"))
+			return find_avx2;
+		if(__builtin_cpu_supports("sse2"))
+			return find_sse2;
+#	endif
+	return find_scalar;
+}
+
+
+/**
+ * @class Set
+ * Set of characters that may be looked for in a character array in one pass.
+ * Sets of up to Set::simd_max characters are looked for with vector
+ * instructions when the host supports them; bigger sets use a bit table.
+ * @ingroup search
+ */
+
+/**
+ * Build an empty set.
+ */
+Set::Set(void): cnt(0) {
+	memset(bits, 0, sizeof(bits));
+}
+
+/**
+ * Build a set from the characters of a C string.
+ * @param s		Characters of the set.
+ */
+Set::Set(const char *s): Set() {
+	for(; *s; s++)
+		add(*s);
+}
+
+/**
+ * Build a set from a character array.
+ * @param s		Characters of the set.
+ * @param n		Number of characters.
+ */
+Set::Set(const char *s, int n): Set() {
+	for(int i = 0; i < n; i++)
+		add(s[i]);
+}
+
+/**
+ * Add a character to the set.
+ * @param c		Added character.
+ */
+void Set::add(char c) {
+	if(contains(c))
+		return;
+	t::uint8 i = c;
+	bits[i >> 5] |= t::uint32(1) << (i & 31);
+	if(cnt < simd_max)
+		cs[cnt] = c;
+	cnt++;
+}
+
+/**
+ * @fn bool Set::contains(char c) const;
+ * Test if a character is in the set.
+ * @param c		Tested character.
+ * @return		True if c is in the set, false else.
+ */
+
+/**
+ * @fn int Set::count(void) const;
+ * Get the number of characters in the set.
+ * @return	Number of characters.
+ */
+
+/**
+ * Look for the first character of the array belonging to the set.
+ * @param p		Base of the character array.
+ * @param n		Length of the character array.
+ * @return		Pointer to the found character or null.
+ */
+const char *Set::find(const char *p, int n) const {
+	static const set_find_t set_find = select_find();
+	if(cnt == 0 || n <= 0)
+		return nullptr;
+	if(cnt == 1)
+		return chars::find(p, n, cs[0]);
+	if(cnt <= simd_max)
+		return set_find(cs, cnt, p, n);
+	for(const char *e = p + n; p < e; p++)
+		if(contains(*p))
+			return p;
+	return nullptr;
+}
+
+} }	// elm::chars
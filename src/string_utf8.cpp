@@ -21,11 +21,18 @@
 
 #include <elm/string/utf8.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#	define ELM_UTF8_X86
+#	include <immintrin.h>
+#endif
+
 namespace elm { namespace utf8 {
 
 /**
  * @class Iter
  * Traverse an UTF-8 string Unicode character based on UTF-8 unicode characters.
+ * The iterator does not copy the traversed characters: the string it is built
+ * from must stay alive and unchanged during the traversal.
  *
  * @ingroup string
  */
@@ -78,4 +85,267 @@ void Iter::parse(void) {
 	}
 }
 
+
+/**
+ * @var t::size bad;
+ * Value returned by the transcoding functions when the input is not
+ * correctly encoded.
+ * @ingroup string
+ */
+
+
+// count the ASCII characters at the start of a buffer
+static t::size ascii_scalar(const char *p, t::size n) {
+	t::size i = 0;
+	for(; i + 8 <= n; i += 8) {
+		t::uint64 w;
+		memcpy(&w, p + i, 8);
+		if(w & 0x8080808080808080ULL)
+			break;
+	}
+	while(i < n && !(p[i] & 0x80))
+		i++;
+	return i;
+}
+
+// count the code points (non-continuation bytes) of a buffer
+static t::size count_scalar(const char *p, t::size n) {
+	t::size c = 0;
+	for(t::size i = 0; i < n; i++)
+		c += (p[i] & 0xc0) != 0x80;
+	return c;
+}
+
+#ifdef ELM_UTF8_X86
+
+__attribute__((target("sse2")))
+static t::size ascii_sse2(const char *p, t::size n) {
+	t::size i = 0;
+	for(; i + 16 <= n; i += 16) {
+		int m = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i)));
+		if(m)
+			return i + __builtin_ctz(m);
+	}
+	return i + ascii_scalar(p + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static t::size ascii_avx2(const char *p, t::size n) {
+	t::size i = 0;
+	for(; i + 32 <= n; i += 32) {
+		unsigned m = _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i)));
+		if(m)
+			return i + __builtin_ctz(m);
+	}
+	return i + ascii_sse2(p + i, n - i);
+}
+
+__attribute__((target("sse2,popcnt")))
+static t::size count_sse2(const char *p, t::size n) {
+	const __m128i lim = _mm_set1_epi8(-65);
+	t::size c = 0, i = 0;
+	for(; i + 16 <= n; i += 16) {
+		__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+		c += __builtin_popcount(_mm_movemask_epi8(_mm_cmpgt_epi8(b, lim)));
+	}
+	return c + count_scalar(p + i, n - i);
+}
+
+__attribute__((target("avx2,popcnt")))
+static t::size count_avx2(const char *p, t::size n) {
+	const __m256i lim = _mm256_set1_epi8(-65);
+	t::size c = 0, i = 0;
+	for(; i + 32 <= n; i += 32) {
+		__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+		c += __builtin_popcount(unsigned(_mm256_movemask_epi8(_mm256_cmpgt_epi8(b, lim))));
+	}
+	return c + count_sse2(p + i, n - i);
+}
+
+#endif
+
+// implementations selected for the host
+typedef t::size (*scan_t)(const char *p, t::size n);
+typedef struct impl_t {
+	scan_t ascii, count;
+} impl_t;
+
+static impl_t select_impl(void) {
+#	ifdef ELM_UTF8_X86
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+			return { ascii_avx2, count_avx2 };
+		if(__builtin_cpu_supports("sse2") && __builtin_cpu_supports("popcnt"))
+			return { ascii_sse2, count_sse2 };
+#	endif
+	return { ascii_scalar, count_scalar };
+}
+
+static const impl_t& impl(void) {
+	static const impl_t i = select_impl();
+	return i;
+}
+
+
+// decode a non-ASCII sequence, rejecting overlong forms, surrogates
+// and code points above 0x10FFFF, return its length or 0
+static int decode_strict(const t::uint8 *p, const t::uint8 *e, char_t& c) {
+	t::uint8 b = p[0];
+	int l;
+	if(b < 0xc2)
+		return 0;
+	else if(b < 0xe0)
+		{ l = 2; c = b & 0x1f; }
+	else if(b < 0xf0)
+		{ l = 3; c = b & 0x0f; }
+	else if(b < 0xf5)
+		{ l = 4; c = b & 0x07; }
+	else
+		return 0;
+	if(e - p < l)
+		return 0;
+	for(int i = 1; i < l; i++) {
+		if((p[i] & 0xc0) != 0x80)
+			return 0;
+		c = (c << 6) | (p[i] & 0x3f);
+	}
+	if((l == 3 && (c < 0x800 || (c >= 0xd800 && c < 0xe000)))
+	|| (l == 4 && (c < 0x10000 || c > 0x10ffff)))
+		return 0;
+	return l;
+}
+
+
+/**
+ * Test if a buffer is correctly UTF-8 encoded: overlong sequences,
+ * UTF-16 surrogates and code points above 0x10FFFF are rejected.
+ * ASCII runs are skipped with vector instructions (SSE2 or AVX2, selected
+ * at the first call) when the host supports them.
+ * @param buf	Buffer to test.
+ * @param len	Buffer length in bytes.
+ * @return		True if the buffer is valid UTF-8, false else.
+ * @ingroup string
+ */
+bool validate(const char *buf, t::size len) {
+	scan_t ascii = impl().ascii;
+	const t::uint8 *p = reinterpret_cast<const t::uint8 *>(buf), *e = p + len;
+	while(true) {
+		p += ascii(reinterpret_cast<const char *>(p), e - p);
+		if(p == e)
+			return true;
+		char_t c;
+		int l = decode_strict(p, e, c);
+		if(!l)
+			return false;
+		p += l;
+	}
+}
+
+
+/**
+ * Count the code points of a UTF-8 buffer (that is assumed to be valid).
+ * @param buf	Buffer to count in.
+ * @param len	Buffer length in bytes.
+ * @return		Number of code points.
+ * @ingroup string
+ */
+t::size count(const char *buf, t::size len) {
+	return impl().count(buf, len);
+}
+
+
+/**
+ * Convert a UTF-8 buffer to UTF-16. The output buffer must be able to store
+ * len 16-bit units.
+ * @param buf	Buffer to convert.
+ * @param len	Buffer length in bytes.
+ * @param out	Output buffer.
+ * @return		Number of 16-bit units written in out or utf8::bad if the
+ *				buffer is not valid UTF-8.
+ * @ingroup string
+ */
+t::size toUtf16(const char *buf, t::size len, t::uint16 *out) {
+	scan_t ascii = impl().ascii;
+	const t::uint8 *p = reinterpret_cast<const t::uint8 *>(buf), *e = p + len;
+	t::uint16 *q = out;
+	while(true) {
+		t::size n = ascii(reinterpret_cast<const char *>(p), e - p);
+		for(t::size i = 0; i < n; i++)
+			q[i] = p[i];
+		p += n;
+		q += n;
+		if(p == e)
+			return q - out;
+		char_t c;
+		int l = decode_strict(p, e, c);
+		if(!l)
+			return bad;
+		p += l;
+		if(c < 0x10000)
+			*q++ = c;
+		else {
+			c -= 0x10000;
+			*q++ = 0xd800 | (c >> 10);
+			*q++ = 0xdc00 | (c & 0x3ff);
+		}
+	}
+}
+
+
+/**
+ * Convert a UTF-16 buffer to UTF-8. The output buffer must be able
+ * to store 3 * len bytes.
+ * @param buf	Buffer to convert.
+ * @param len	Buffer length in 16-bit units.
+ * @param out	Output buffer.
+ * @return		Number of bytes written in out or utf8::bad if the buffer
+ *				contains an unpaired surrogate.
+ * @ingroup string
+ */
+t::size fromUtf16(const t::uint16 *buf, t::size len, char *out) {
+	const t::uint16 *p = buf, *e = buf + len;
+	char *q = out;
+	while(p < e) {
+
+		// ASCII run
+		const t::uint16 *s = p;
+		while(p < e && *p < 0x80)
+			p++;
+		for(t::size i = 0; i < t::size(p - s); i++)
+			q[i] = s[i];
+		q += p - s;
+		if(p == e)
+			break;
+
+		// other character
+		char_t c = *p++;
+		if(c >= 0xd800 && c < 0xe000) {
+			if(c >= 0xdc00 || p == e || *p < 0xdc00 || *p >= 0xe000)
+				return bad;
+			c = 0x10000 + ((c - 0xd800) << 10) + (*p++ - 0xdc00);
+		}
+		q += encode(c, q);
+	}
+	return q - out;
+}
+
+
+/**
+ * @fn int encode(char_t c, char *out);
+ * Encode a code point in UTF-8.
+ * @param c		Code point to encode.
+ * @param out	Buffer to write to (at least 4 bytes).
+ * @return		Number of written bytes.
+ * @ingroup string
+ */
+
+
+/**
+ * @fn char_t decode(const char *& p);
+ * Decode a code point from a valid UTF-8 buffer (see validate()).
+ * @param p		Pointer to the code point, moved after it.
+ * @return		Decoded code point.
+ * @ingroup string
+ */
+
 } }		// elm::utf8
@@ -0,0 +1,285 @@
+/*
+ *	Future and Promise classes implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <exception>
+#include <elm/sys/Future.h>
+
+namespace elm { namespace sys {
+
+/**
+ * @class Future
+ * A future represents a value of type T that will be available later:
+ * it is obtained from a Promise that provides the value, possibly in another thread.
+ * Futures are cheap to copy: the copies share the same value.
+ *
+ * The value can be waited for and obtained with get(); or a continuation can be
+ * attached with onReady() or then(). A continuation is called as soon as the value
+ * is available, by the thread calling Promise::set() or Promise::fail(), or immediately
+ * by the current thread if the value is already available.
+ *
+ * @code
+ * Promise<int> p;
+ * Future<string> f = p.future().then([](int x) { return string(_ << x); });
+ * ...
+ * p.set(111);		// in another thread
+ * ...
+ * cout << f.get() << io::endl;
+ * @endcode
+ *
+ * Future<void> (obtained from a Promise<void>) only signals the end of
+ * a computation: its get() returns nothing and the functions passed to its
+ * then() take no argument. Conversely, a function returning void passed
+ * to then() gives a Future<void>.
+ *
+ * @param T	Type of the value.
+ * @see Promise, whenAll(), whenAny()
+ * @ingroup system
+ */
+
+/**
+ * @fn Future::Future(void);
+ * Build a future that is never ready (it must be assigned a future
+ * obtained from a promise).
+ */
+
+/**
+ * @fn bool Future::isReady(void) const;
+ * Test if the value, or a failure, is available.
+ * @return	True if the future is ready.
+ */
+
+/**
+ * @fn bool Future::isFailed(void) const;
+ * Test if the future is ready and has failed.
+ * @return	True if the future failed.
+ */
+
+/**
+ * @fn void Future::wait(void) const;
+ * Wait until the future is ready.
+ */
+
+/**
+ * @fn const string& Future::error(void) const;
+ * Wait for the future and get its error message.
+ * @return	Error message (empty if the future succeeded).
+ */
+
+/**
+ * @fn const T& Future::get(void) const;
+ * Wait for the future and get its value.
+ * @return	Future value.
+ * @throw FutureException	If the future failed.
+ */
+
+/**
+ * @fn void Future::onReady(F f) const;
+ * Call f(future) when the future is ready (successfully or not).
+ * @param f	Function to call.
+ */
+
+/**
+ * @fn Future<R> Future::then(F f) const;
+ * Build a future whose value is the result of f applied to the value
+ * of the current future. If the current future fails, the built future
+ * fails with the same message. If f throws an exception, the built future
+ * fails with the message of elm::Exception, the result of what() for
+ * std::exception, or "unknown exception" for any other type.
+ * @param f	Function called as f(value) and returning a value of type R.
+ * @return	Future of the result of f.
+ */
+
+
+/**
+ * @class Promise
+ * A promise is the provider side of a Future: set() gives the value to
+ * the futures obtained by future() and fail() makes them fail.
+ * Only one call to set() or fail() is allowed and a promise
+ * must be fulfilled: the futures and their continuations
+ * are not released else.
+ * @param T	Type of the value.
+ * @ingroup system
+ */
+
+/**
+ * @fn Future<T> Promise::future(void) const;
+ * Get a future on the promised value.
+ * @return	Future.
+ */
+
+/**
+ * @fn void Promise::set(const T& v) const;
+ * Set the value of the promise and call the continuations.
+ * @param v	Promised value.
+ */
+
+/**
+ * @fn void Promise::fail(const string& message) const;
+ * Make the promise fail and call the continuations.
+ * @param message	Error message.
+ */
+
+
+/**
+ * @class FutureException
+ * Exception thrown when the value of a failed Future is required.
+ * @ingroup system
+ */
+
+
+/**
+ * @fn Future<Vector<T> > whenAll(const Vector<Future<T> >& fs);
+ * Build a future that is ready when all given futures are ready.
+ * Its value is the vector of values of the futures, in the same order.
+ * It fails if one of the futures fails.
+ * @param fs	Futures to wait for.
+ * @return		Future on the vector of values.
+ * @ingroup system
+ */
+
+/**
+ * @fn Future<void> whenAll(const Vector<Future<void> >& fs);
+ * Build a future that is ready when all given void futures are ready.
+ * It fails if one of the futures fails.
+ * @param fs	Futures to wait for.
+ * @return		Void future.
+ * @ingroup system
+ */
+
+/**
+ * @fn Future<int> whenAny(const Vector<Future<T> >& fs);
+ * Build a future that is ready as soon as one of the given futures is ready.
+ * @param fs	Futures to wait for (at least one).
+ * @return		Future on the index of the first ready future.
+ * @ingroup system
+ */
+
+
+namespace impl {
+
+/**
+ * Get the message of the exception being handled (to call in a catch block).
+ * @return	Exception message.
+ */
+string currentError(void) {
+	try {
+		throw;
+	}
+	catch(elm::Exception& e) {
+		return e.message();
+	}
+	catch(std::exception& e) {
+		return e.what();
+	}
+	catch(...) {
+		return "unknown exception";
+	}
+}
+
+
+/**
+ */
+AbstractFutureState::AbstractFutureState(void): cnt(0), ready(false), failed(false) {
+}
+
+
+/**
+ */
+AbstractFutureState::~AbstractFutureState(void) {
+}
+
+
+/**
+ * Wait for the state to be ready.
+ */
+void AbstractFutureState::wait(void) const {
+	if(isReady())
+		return;
+	std::unique_lock<std::mutex> lock(mutex);
+	cond.wait(lock, [this]() { return isReady(); });
+}
+
+
+/**
+ * Call the given function when the state is ready.
+ * @param f	Function to call.
+ */
+void AbstractFutureState::onReady(const std::function<void(void)>& f) {
+	mutex.lock();
+	if(!isReady()) {
+		conts.add(f);
+		mutex.unlock();
+	}
+	else {
+		mutex.unlock();
+		f();
+	}
+}
+
+
+/**
+ * Make the state fail.
+ * @param message	Error message.
+ */
+void AbstractFutureState::fail(const string& message) {
+	if(fulfill()) {
+		failed = true;
+		err = message;
+		complete();
+	}
+}
+
+
+/**
+ * Start the fulfillment of the state: on success, the state is locked and
+ * the result can be written before calling complete(). If the state is
+ * already fulfilled, nothing is locked and false is returned (this is an
+ * error reported by an assertion in debug mode).
+ * @return	True if the state can be fulfilled, false else.
+ */
+bool AbstractFutureState::fulfill(void) {
+	mutex.lock();
+	if(isReady()) {
+		mutex.unlock();
+		ASSERTP(false, "promise already fulfilled");
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * Mark the state as ready, unlock it and call the continuations.
+ * Must be called after a successful fulfill().
+ */
+void AbstractFutureState::complete(void) {
+	ready.store(true, std::memory_order_release);
+	Vector<std::function<void(void)> > fs;
+	elm::swap(fs, conts);
+	mutex.unlock();
+	cond.notify_all();
+	for(const auto& f: fs)
+		f();
+}
+
+}	// impl
+
+} }	// elm::sys
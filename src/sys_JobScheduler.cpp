@@ -20,15 +20,405 @@
  */
 
 #include <elm/assert.h>
+#include <elm/data/Vector.h>
 #include <elm/sys/JobScheduler.h>
+#include <elm/sys/System.h>
+#include <exception>
 
 namespace elm { namespace sys {
 
+/**
+ * Work-stealing deque of jobs (Chase & Lev, "Dynamic circular work-stealing
+ * deque", SPAA'05, with the memory orders of Lê et al., PPoPP'13).
+ * Only the owner worker pushes and pops at the bottom, the other workers
+ * steal from the top. Replaced arrays are kept until the deque is deleted
+ * as a thief may still read them.
+ */
+class JobDeque {
+
+	class Array {
+	public:
+		Array(t::int64 s, Array *p): size(s), buf(new std::atomic<Job *>[s]), prev(p) { }
+		~Array(void) { delete [] buf; }
+		inline Job *get(t::int64 i) const { return buf[i & (size - 1)].load(std::memory_order_relaxed); }
+		inline void put(t::int64 i, Job *job) { buf[i & (size - 1)].store(job, std::memory_order_relaxed); }
+		t::int64 size;
+		std::atomic<Job *> *buf;
+		Array *prev;
+	};
+
+public:
+	JobDeque(void): top(0), bottom(0), array(new Array(64, nullptr)) { }
+
+	~JobDeque(void) {
+		for(Array *a = array.load(), *p; a != nullptr; a = p) {
+			p = a->prev;
+			delete a;
+		}
+	}
+
+	void push(Job *job) {
+		t::int64 b = bottom.load(std::memory_order_relaxed);
+		t::int64 t = top.load(std::memory_order_acquire);
+		Array *a = array.load(std::memory_order_relaxed);
+		if(b - t > a->size - 1) {
+			Array *na = new Array(a->size * 2, a);
+			for(t::int64 i = t; i < b; i++)
+				na->put(i, a->get(i));
+			array.store(na, std::memory_order_release);
+			a = na;
+		}
+		a->put(b, job);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+
+	Job *pop(void) {
+		t::int64 b = bottom.load(std::memory_order_relaxed) - 1;
+		Array *a = array.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		t::int64 t = top.load(std::memory_order_relaxed);
+		Job *job = nullptr;
+		if(t <= b) {
+			job = a->get(b);
+			if(t == b) {
+				if(!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					job = nullptr;
+				bottom.store(b + 1, std::memory_order_relaxed);
+			}
+		}
+		else
+			bottom.store(b + 1, std::memory_order_relaxed);
+		return job;
+	}
+
+	Job *steal(void) {
+		t::int64 t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		t::int64 b = bottom.load(std::memory_order_acquire);
+		if(t >= b)
+			return nullptr;
+		Array *a = array.load(std::memory_order_acquire);
+		Job *job = a->get(t);
+		if(!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+		return job;
+	}
+
+private:
+	std::atomic<t::int64> top, bottom;
+	std::atomic<Array *> array;
+};
+
+
+/**
+ * A worker of the job scheduler: it runs in its own thread and executes
+ * the jobs of its deque or the ones stolen from the other workers.
+ * Finished top-level jobs are harvested by batch.
+ */
+class JobWorker: public Runnable {
+	friend class Job;
+public:
+	static const int spins = 64;
+
+	JobWorker(JobScheduler& scheduler, int index)
+		: sched(scheduler), seed(2654435761U * t::uint32(index + 1)) { }
+
+	inline void push(Job *job) { deque.push(job); }
+
+	/**
+	 * Find a job to execute: first in the own deque of the worker,
+	 * then stolen from a randomly-chosen other worker.
+	 */
+	Job *find(void) {
+		Job *job = deque.pop();
+		if(job != nullptr || sched.cnt == 1)
+			return job;
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		for(int i = 0, v = seed % sched.cnt; i < sched.cnt; i++, v = (v + 1) % sched.cnt)
+			if(sched.workers[v] != this) {
+				job = sched.workers[v]->deque.steal();
+				if(job != nullptr)
+					return job;
+			}
+		return nullptr;
+	}
+
+	/**
+	 * Execute the job, wait for its children and record its end.
+	 * An exception raised by the job is recorded as the error of the
+	 * scheduler and stops the fetch of new jobs.
+	 * @param job	Job to execute.
+	 */
+	void exec(Job *job) {
+		job->_worker = this;
+		try {
+			job->run();
+		}
+		catch(elm::Exception& e) {
+			fail(e.message(), true);
+		}
+		catch(std::exception& e) {
+			fail(e.what(), true);
+		}
+		catch(...) {
+			fail("unknown exception", true);
+		}
+		job->sync();
+		Job *parent = job->_parent;
+		bool wake = false;
+		if(parent != nullptr)
+			wake = parent->_pending.fetch_sub(1, std::memory_order_release) == 1;
+		else
+			done.add(job);
+		if(--sched.active == 0 || wake)
+			sched.wake(true);
+	}
+
+	/**
+	 * Harvest the ended jobs and, if required, fetch a new batch of jobs
+	 * from the producer, holding the producer lock only once.
+	 * @param fetch		True to fetch new jobs.
+	 */
+	void transfer(bool fetch) {
+		sched.mutex->lock();
+		for(auto job: done)
+			try {
+				sched.prod->harvest(job);
+			}
+			catch(elm::Exception& e) {
+				fail(e.message());
+			}
+			catch(std::exception& e) {
+				fail(e.what());
+			}
+			catch(...) {
+				fail("unknown exception");
+			}
+		done.clear();
+		if(fetch && !sched.exhausted && sched.state == JobScheduler::RUN) {
+			bool end = false;
+			try {
+				for(int i = 0; i < sched.batch; i++) {
+					Job *job = sched.prod->next();
+					if(job == nullptr) {
+						end = true;
+						break;
+					}
+					job->_parent = nullptr;
+					fetched.add(job);
+				}
+			}
+			catch(elm::Exception& e) {
+				fail(e.message());
+			}
+			catch(std::exception& e) {
+				fail(e.what());
+			}
+			catch(...) {
+				fail("unknown exception");
+			}
+			// active first: a worker seeing exhausted must see these jobs
+			sched.active += fetched.length();
+			if(end)
+				sched.exhausted = true;
+		}
+		sched.mutex->unlock();
+
+		// pushed in reverse order to be popped in the producer order
+		for(int i = fetched.length() - 1; i >= 0; i--)
+			deque.push(fetched[i]);
+		if(fetched.length() > 1)
+			sched.wake(true);
+		fetched.clear();
+	}
+
+	/**
+	 * Thread of the worker: executes its part of each round of
+	 * JobScheduler::start() until the scheduler is released.
+	 */
+	virtual void run(void) {
+		t::uint32 r = 0;
+		while(sched.waitRound(r)) {
+			work();
+			sched.endRound();
+		}
+	}
+
+	/**
+	 * Execute the jobs until the producer is exhausted or the scheduler is
+	 * stopped. In the latter case, no more job is fetched but the jobs already
+	 * fetched are executed and harvested. An idle worker spins a bit
+	 * and then sleeps until a job is pushed or the number of active jobs drops.
+	 */
+	void work(void) {
+		for(int idle = 0; true; ) {
+			t::uint32 e = sched.epoch.load();
+			Job *job = find();
+			if(job != nullptr) {
+				idle = 0;
+				exec(job);
+				if(done.length() >= sched.batch)
+					transfer(false);
+			}
+			else if(!sched.exhausted && sched.state == JobScheduler::RUN)
+				transfer(true);
+			else if(sched.active == 0)
+				break;
+			else if(done)
+				transfer(false);
+			else if(idle < spins) {
+				idle++;
+				Thread::yield();
+			}
+			else {
+				idle = 0;
+				sched.park(e);
+			}
+		}
+		if(done)
+			transfer(false);
+	}
+
+private:
+
+	/**
+	 * Record an error: the scheduler enters the EXN state, no more job
+	 * is fetched and the jobs already fetched are drained. Only the first
+	 * error is kept.
+	 * @param msg	Error message.
+	 * @param lock	True if the producer lock has to be taken.
+	 */
+	void fail(const string& msg, bool lock = false) {
+		if(lock)
+			sched.mutex->lock();
+		if(sched.state != JobScheduler::EXN) {
+			sched.err = msg;
+			sched.state = JobScheduler::EXN;
+		}
+		if(lock)
+			sched.mutex->unlock();
+		sched.wake(true);
+	}
+
+	JobScheduler& sched;
+	t::uint32 seed;
+	JobDeque deque;
+	Vector<Job *> done, fetched;
+};
+
+
 /**
  * @class Job;
  * A job is a small task (inheriting from sys::Runnable) that aims to be executed
  * by the sys::JobSheduler class.
+ *
+ * While it runs, a job can spawn child jobs with spawn() and wait for their end
+ * with sync() (fork/join): the children may be executed by any thread of the scheduler
+ * and the waiting thread executes other jobs meanwhile. A job implicitly waits
+ * for all its children at the end of its run() method. The children remain owned
+ * by their parent and are not passed to JobProducer::harvest().
+ *
+ * A job can also post() independent jobs: they are executed after
+ * the current job by the same thread or by a thread stealing them,
+ * and they are passed to JobProducer::harvest() like the jobs
+ * of the producer. This allows a job to hand over work without growing
+ * the stack of its thread.
+ */
+
+
+/**
+ */
+Job::Job(void): _worker(nullptr), _parent(nullptr), _pending(0) {
+}
+
+
+/**
+ * Copy constructor: only the job data are copied, not the scheduling state.
+ * @param job	Copied job.
+ */
+Job::Job(const Job& job): Runnable(job), _worker(nullptr), _parent(nullptr), _pending(0) {
+}
+
+
+/**
+ * Assignment: only the job data are copied, not the scheduling state.
+ * @param job	Copied job.
+ * @return		This job.
+ */
+Job& Job::operator=(const Job& job) {
+	Runnable::operator=(job);
+	return *this;
+}
+
+
+/**
+ * Post an independent job: it is pushed on the queue of the thread running
+ * the current job and is then processed as a job obtained from the producer
+ * (in particular, it is passed to JobProducer::harvest()). The current job
+ * does not wait for it. Must only be called by a job run by a job scheduler.
+ * @param job	Posted job.
+ */
+void Job::post(Job *job) {
+	ASSERTP(_worker != nullptr, "Job::post() called outside a job scheduler");
+	job->_parent = nullptr;
+	_worker->sched.active++;
+	_worker->push(job);
+	_worker->sched.wake(false);
+}
+
+
+/**
+ * Spawn a child job that may run in parallel with the current job.
+ * The child must not be deleted before sync() returns. If the current job
+ * is not run by a job scheduler, the child is executed immediately.
+ * @param job	Spawned job.
+ */
+void Job::spawn(Job *job) {
+	if(_worker == nullptr) {
+		job->_parent = nullptr;
+		job->run();
+		job->sync();
+	}
+	else {
+		job->_parent = this;
+		_pending++;
+		_worker->sched.active++;
+		_worker->push(job);
+		_worker->sched.wake(false);
+	}
+}
+
+
+/**
+ * Wait for the end of the children spawned by the job.
+ * Meanwhile, the current thread executes other pending jobs.
  */
+void Job::sync(void) {
+	if(_pending.load(std::memory_order_acquire) == 0)
+		return;
+	for(int idle = 0; true; ) {
+		t::uint32 e = _worker->sched.epoch.load();
+		if(_pending.load(std::memory_order_acquire) == 0)
+			break;
+		Job *job = _worker->find();
+		if(job != nullptr) {
+			idle = 0;
+			_worker->exec(job);
+		}
+		else if(idle < JobWorker::spins) {
+			idle++;
+			Thread::yield();
+		}
+		else {
+			idle = 0;
+			_worker->sched.park(e);
+		}
+	}
+}
 
 
 /**
@@ -50,7 +440,9 @@ namespace elm { namespace sys {
 /**
  * @fn void JobProducer::harvest(Job *job);
  * Called in a mutual exclusive way by the thread that performed the job
- * to let the used process the result of the job.
+ * to let the used process the result of the job. The ended jobs are harvested
+ * by batch (see JobScheduler::setBatchSize()) so that the harvest may happen
+ * some time after the end of the job.
  */
 
 
@@ -71,6 +463,21 @@ namespace elm { namespace sys {
  * by the scheduler.
  *
  * To get the list of jobs, an object extending JobProducer must be provided.
+ *
+ * Each thread owns a deque of jobs: it executes the jobs of its deque
+ * and, when it is empty, steals jobs from the other threads (work stealing).
+ * The producer is only accessed, under a lock, to obtain a batch of jobs
+ * and to harvest a batch of ended jobs at once: the lock is not taken
+ * for each job.
+ *
+ * A thread without job to execute yields the processor a few times
+ * and then sleeps until a new job is pushed or a job ends: the threads
+ * do not burn the processor while a long job is running.
+ *
+ * The threads are created by the first call to start() and sleep between
+ * the calls to start(): they are only joined when the scheduler is deleted
+ * or its thread count is changed. Hence, a scheduler kept alive runs
+ * many small batches of jobs without creating threads each time.
  */
 
 
@@ -83,8 +490,9 @@ void JobScheduler::init(void) {
 	mutex = Mutex::make();
 
 	// determine the number of cores
-	// TODO
-	cnt = 4;
+	cnt = System::coreCount();
+	if(cnt < 1)
+		cnt = 1;
 }
 
 
@@ -92,7 +500,10 @@ void JobScheduler::init(void) {
  * Constructor without producer.
  * @throw SystemException	Lack of OS resources.
  */
-JobScheduler::JobScheduler(void): prod(0), mutex(0), cnt(0), thds(0), state(WAIT) {
+JobScheduler::JobScheduler(void)
+:	prod(0), mutex(0), cnt(0), batch(16), workers(0), thds(0), active(0), exhausted(false), state(WAIT),
+	epoch(0), sleepers(0), round(0), running(0), quit(false)
+{
 	init();
 }
 
@@ -102,7 +513,10 @@ JobScheduler::JobScheduler(void): prod(0), mutex(0), cnt(0), thds(0), state(WAIT
  * @param producer	Producer to use.
  * @throw SystemException	Lack of OS resources.
  */
-JobScheduler::JobScheduler(JobProducer& producer): prod(&producer), mutex(0), cnt(0), thds(0), state(WAIT) {
+JobScheduler::JobScheduler(JobProducer& producer)
+:	prod(&producer), mutex(0), cnt(0), batch(16), workers(0), thds(0), active(0), exhausted(false), state(WAIT),
+	epoch(0), sleepers(0), round(0), running(0), quit(false)
+{
 	init();
 }
 
@@ -110,12 +524,9 @@ JobScheduler::JobScheduler(JobProducer& producer): prod(&producer), mutex(0), cn
 /**
  */
 JobScheduler::~JobScheduler(void) {
+	release();
 	if(mutex)
 		delete mutex;
-	if(thds)
-		for(int i = 0; i < cnt - 1; i++)
-			if(thds[i])
-				delete thds[i];
 }
 
 /**
@@ -137,47 +548,97 @@ void JobScheduler::setProducer(JobProducer& producer) {
 
 /**
  * @fn inline int JobScheduler::threadCount(void) const;
- * Get the number of used threads.
+ * Get the number of used threads. As a default, it is the number of cores
+ * of the host.
  */
 
 
 /**
  * Set the number of threads.
- * @param count		Number of threads.
+ * @param count		Number of threads (at least 1).
  */
 void JobScheduler::setThreadCount(int count) {
 	ASSERTP(state == WAIT, "forbidden operation when scheduler is running");
-	cnt = count;
+	if(count < 1)
+		count = 1;
+	if(count != cnt) {
+		release();
+		cnt = count;
+	}
+}
+
+
+/**
+ * @fn int JobScheduler::batchSize(void) const;
+ * Get the maximum number of jobs obtained from the producer, or harvested,
+ * each time the producer lock is taken (default to 16).
+ * @return	Batch size.
+ */
+
+
+/**
+ * @fn int JobScheduler::idleCount(void) const;
+ * Get the number of workers currently sleeping for lack of jobs
+ * during a call to start().
+ * @return	Number of sleeping workers.
+ */
+
+
+/**
+ * Set the maximum number of jobs obtained from the producer, or harvested,
+ * each time the producer lock is taken.
+ * @param size	Batch size (at least 1).
+ */
+void JobScheduler::setBatchSize(int size) {
+	ASSERTP(state == WAIT, "forbidden operation when scheduler is running");
+	batch = size < 1 ? 1 : size;
 }
 
 
 /**
  * Start to process the jobs. This function will only when all jobs
  * has been processed or a call to stop() has been performed.
+ *
+ * If a job, JobProducer::next() or JobProducer::harvest() raises an
+ * exception, no more job is fetched, the jobs already fetched are executed
+ * and harvested and the scheduler is ready for a new start when
+ * the error is thrown back to the caller.
+ * @throw MessageException	With the message of the first raised exception.
  */
 void JobScheduler::start(void) {
-
-	// allocate threads
-	thds = new Thread *[cnt - 1];
-	for(int i = 0; i < cnt - 1; i++)
-		thds[i] = 0;
-	for(int i = 0; i < cnt - 1; i++)
-		thds[i] = Thread::make(*this);
+	ASSERTP(prod, "no producer");
+
+	// allocate workers and threads at the first start
+	if(workers == nullptr) {
+		workers = new JobWorker *[cnt];
+		for(int i = 0; i < cnt; i++)
+			workers[i] = new JobWorker(*this, i);
+		thds = new Thread *[cnt - 1];
+		quit = false;
+		for(int i = 0; i < cnt - 1; i++) {
+			thds[i] = Thread::make(*workers[i + 1]);
+			thds[i]->start();
+		}
+	}
 
 	// process the jobs
+	active = 0;
+	exhausted = false;
 	state = RUN;
-	for(int i = 0; i < cnt - 1; i++)
-		thds[i]->start();
-	run();
-
-	// wait all threads
-	for(int i = 0; i < cnt - 1; i++)
-		thds[i]->join();
+	{
+		std::lock_guard<std::mutex> g(idle);
+		running = cnt - 1;
+		round++;
+		rounds.notify_all();
+	}
+	workers[0]->work();
 
-	// clean threads
-	for(int i = 0; i < cnt - 1; i++)
-		delete thds[i];
-	thds = 0;
+	// wait the other threads
+	{
+		std::unique_lock<std::mutex> g(idle);
+		while(running != 0)
+			finished.wait(g);
+	}
 
 	// process output state
 	if(state == EXN) {
@@ -189,41 +650,92 @@ void JobScheduler::start(void) {
 
 
 /**
- * Stop the job processing.
+ * Stop the job processing: no more job is obtained from the producer
+ * but the jobs already obtained (at most a batch per thread) are
+ * executed and harvested before start() returns.
  */
 void JobScheduler::stop(void) {
 	state = STOP;
+	wake(true);
 }
 
 
 /**
- * Thread work.
+ * Wait for a new round of jobs (a call to start()).
+ * @param r		Last performed round, updated with the new one.
+ * @return		True to perform the new round, false if the scheduler is released.
  */
-void JobScheduler::run(void) {
-	mutex->lock();
-	while(state == RUN) {
+bool JobScheduler::waitRound(t::uint32& r) {
+	std::unique_lock<std::mutex> g(idle);
+	while(round == r && !quit)
+		rounds.wait(g);
+	r = round;
+	return !quit;
+}
 
-		// get a new job
-		Job *job = prod->next();
-		if(!job)
-			break;
-		mutex->unlock();
 
-		// perform it
-		job->run();
+/**
+ * Record the end of a round by a thread.
+ */
+void JobScheduler::endRound(void) {
+	std::lock_guard<std::mutex> g(idle);
+	if(--running == 0)
+		finished.notify_all();
+}
 
-		// harvest the result
-		mutex->lock();
-		try {
-			prod->harvest(job);
-		}
-		catch(elm::Exception& e) {
-			err = e.message();
-			state = EXN;
-			break;
-		}
+
+/**
+ * Join the threads and delete the workers.
+ */
+void JobScheduler::release(void) {
+	if(workers == nullptr)
+		return;
+	{
+		std::lock_guard<std::mutex> g(idle);
+		quit = true;
+		rounds.notify_all();
+	}
+	for(int i = 0; i < cnt - 1; i++) {
+		thds[i]->join();
+		delete thds[i];
+	}
+	delete [] thds;
+	thds = nullptr;
+	for(int i = 0; i < cnt; i++)
+		delete workers[i];
+	delete [] workers;
+	workers = nullptr;
+}
+
+
+/**
+ * Put the current thread to sleep until an event occurs after the given
+ * epoch (read before looking for a job, so that no event is missed).
+ * @param e		Epoch of the last look for a job.
+ */
+void JobScheduler::park(t::uint32 e) {
+	std::unique_lock<std::mutex> g(idle);
+	sleepers++;
+	while(epoch.load() == e)
+		wakeup.wait(g);
+	sleepers--;
+}
+
+
+/**
+ * Record an event (job pushed or ended, state change) and wake up
+ * the sleeping threads.
+ * @param all	True to wake up all threads, false for only one.
+ */
+void JobScheduler::wake(bool all) {
+	epoch++;
+	if(sleepers.load() > 0) {
+		std::lock_guard<std::mutex> g(idle);
+		if(all)
+			wakeup.notify_all();
+		else
+			wakeup.notify_one();
 	}
-	mutex->unlock();
 }
 
 } }	// elm::sys
@@ -0,0 +1,208 @@
+/*
+ *	lock classes documentation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/sys/Lock.h>
+
+namespace elm { namespace sys {
+
+/**
+ * @class SpinLock
+ * Lock based on an atomic flag: locking and unlocking without contention
+ * only costs an atomic operation and is inlined (no virtual call, no allocation
+ * unlike Mutex). When the lock is busy, the locking thread spins a bit and then
+ * gives up the processor until the lock is released: it fits well to short
+ * critical sections. A spin lock is not recursive.
+ *
+ * It provides the same lock(), unlock() and tryLock() functions as Mutex
+ * and can be used with LockGuard and Condition.
+ * @ingroup system
+ */
+
+/**
+ * @fn bool SpinLock::tryLock(void);
+ * Try to lock without waiting.
+ * @return	True if the lock has been acquired, false else.
+ */
+
+/**
+ * @fn void SpinLock::lock(void);
+ * Lock, waiting if needed.
+ */
+
+/**
+ * @fn void SpinLock::unlock(void);
+ * Unlock.
+ */
+
+
+/**
+ * @class ReadWriteLock
+ * Lock allowing either several readers or only one writer. As SpinLock,
+ * it is based on atomic operations, is fully inlined and yields the processor
+ * when it has to wait. A waiting writer prevents new readers to enter, so that
+ * writers are not starved: as a consequence, the read lock must not be
+ * acquired recursively.
+ *
+ * lock(), unlock() and tryLock() are synonyms of lockWrite(), unlockWrite() and
+ * tryLockWrite() to use the lock with LockGuard while ReadGuard acquires
+ * the read lock.
+ * @ingroup system
+ */
+
+/**
+ * @fn bool ReadWriteLock::tryLockRead(void);
+ * Try to lock for reading without waiting.
+ * @return	True if the lock has been acquired.
+ */
+
+/**
+ * @fn void ReadWriteLock::lockRead(void);
+ * Lock for reading, waiting if needed.
+ */
+
+/**
+ * @fn void ReadWriteLock::unlockRead(void);
+ * Unlock after reading.
+ */
+
+/**
+ * @fn bool ReadWriteLock::tryLockWrite(void);
+ * Try to lock for writing without waiting.
+ * @return	True if the lock has been acquired.
+ */
+
+/**
+ * @fn void ReadWriteLock::lockWrite(void);
+ * Lock for writing, waiting if needed.
+ */
+
+/**
+ * @fn void ReadWriteLock::unlockWrite(void);
+ * Unlock after writing.
+ */
+
+
+/**
+ * @class Condition
+ * Condition variable: it lets threads wait, with a lock acquired, until another
+ * thread notifies them. The lock may be of any class providing lock() and unlock()
+ * (SpinLock, ReadWriteLock, Mutex, etc).
+ *
+ * @code
+ * SpinLock lock;
+ * Condition cond;
+ * bool ready = false;
+ *
+ * // waiting thread
+ * {
+ *		LockGuard<SpinLock> g(lock);
+ *		cond.wait(lock, [&]() { return ready; });
+ * }
+ *
+ * // notifying thread
+ * {
+ *		LockGuard<SpinLock> g(lock);
+ *		ready = true;
+ * }
+ * cond.notifyAll();
+ * @endcode
+ * @ingroup system
+ */
+
+/**
+ * @fn void Condition::wait(L& lock);
+ * Release the lock, wait for a notification and acquire again the lock.
+ * As spurious wake-ups are possible, the waited condition has to be tested again.
+ * @param lock	Acquired lock.
+ */
+
+/**
+ * @fn void Condition::wait(L& lock, P pred);
+ * Wait, as in wait(lock), until pred() returns true.
+ * @param lock	Acquired lock.
+ * @param pred	Waited condition.
+ */
+
+/**
+ * @fn void Condition::notify(void);
+ * Wake up one waiting thread.
+ */
+
+/**
+ * @fn void Condition::notifyAll(void);
+ * Wake up all waiting threads.
+ */
+
+
+/**
+ * @class Semaphore
+ * Counting semaphore. acquire() and release() are an atomic operation
+ * when no thread has to wait.
+ * @ingroup system
+ */
+
+/**
+ * @fn Semaphore::Semaphore(int count);
+ * Build a semaphore.
+ * @param count	Initial count.
+ */
+
+/**
+ * @fn int Semaphore::count(void) const;
+ * Get the current count.
+ * @return	Current count.
+ */
+
+/**
+ * @fn bool Semaphore::tryAcquire(void);
+ * Decrement the count if it is positive.
+ * @return	True if the count has been decremented, false else.
+ */
+
+/**
+ * @fn void Semaphore::acquire(void);
+ * Decrement the count, waiting until it is positive.
+ */
+
+/**
+ * @fn void Semaphore::release(int k);
+ * Increment the count and wake up waiting threads.
+ * @param k		Value to add to the count (default to 1).
+ */
+
+
+/**
+ * @class LockGuard
+ * Acquire a lock at construction and release it at destruction
+ * (including when an exception is raised).
+ * @param L		Type of lock (SpinLock, ReadWriteLock, Mutex, etc).
+ * @ingroup system
+ */
+
+
+/**
+ * @class ReadGuard
+ * Acquire a ReadWriteLock for reading at construction and release it
+ * at destruction.
+ * @ingroup system
+ */
+
+} }	// elm::sys
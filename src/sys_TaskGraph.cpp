@@ -0,0 +1,223 @@
+/*
+ *	TaskGraph class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <exception>
+#include <elm/sys/parallel.h>
+#include <elm/sys/TaskGraph.h>
+
+namespace elm { namespace sys {
+
+/**
+ * Node of a TaskGraph: the task function and its successors. A node is
+ * also the job executing the task: when it ends, the successors that become
+ * ready are posted on the queue of the thread that ran it (Job::post()),
+ * where they are popped by this thread or stolen by the others. As the ready
+ * tasks are not spawned as children, the stack depth does not depend
+ * on the length of the dependency chains.
+ */
+class TaskNode: public Job {
+public:
+	inline TaskNode(TaskGraph& graph, const std::function<void(void)>& fun)
+		: g(graph), f(fun), preds(0), pending(0), done(false) { }
+
+	virtual void run(void) {
+		perform();
+		if(!g.failed)
+			for(auto s: succs)
+				if(--s->pending == 0)
+					post(s);
+	}
+
+	/**
+	 * Execute the task function, if no task has failed, and record
+	 * its exception.
+	 */
+	void perform(void) {
+		if(!g.failed)
+			try {
+				f();
+			}
+			catch(elm::Exception& e) {
+				g.fail(e.message());
+			}
+			catch(std::exception& e) {
+				g.fail(e.what());
+			}
+			catch(...) {
+				g.fail("unknown exception");
+			}
+		done = true;
+	}
+
+	TaskGraph& g;
+	std::function<void(void)> f;
+	Vector<TaskNode *> succs;
+	int preds;
+	std::atomic<int> pending;
+	bool done;
+};
+
+
+/**
+ * Producer giving the tasks without predecessor; the other tasks
+ * are posted by their last predecessor.
+ */
+class RootProducer: public JobProducer {
+public:
+	inline RootProducer(const Vector<TaskNode *>& roots): r(roots), i(0) { }
+	virtual Job *next(void) { if(i >= r.length()) return nullptr; return r[i++]; }
+private:
+	const Vector<TaskNode *>& r;
+	int i;
+};
+
+
+/**
+ * @class TaskGraph
+ * A task graph is a DAG of tasks (functions without argument) where an edge
+ * represents a dependency: a task is started as soon as all its predecessors
+ * are ended. The tasks are executed as jobs by the process-wide
+ * JobScheduler also used by the @ref parallel functions: its threads are
+ * created at the first use and independent tasks run in parallel.
+ * A task that becomes ready is queued on the thread that ended its last
+ * predecessor and the other threads steal it when they are idle, so that
+ * long dependency chains do not cause deep recursion. If the scheduler
+ * is busy (run() called from a task or from a parallel function),
+ * the graph is executed sequentially by the calling thread.
+ *
+ * @code
+ * TaskGraph g;
+ * TaskGraph::task_t parse = g.add([&]() { ... }),
+ *		check = g.add([&]() { ... }),
+ *		stats = g.add([&]() { ... }),
+ *		gen = g.add([&]() { ... });
+ * g.precede(parse, check);
+ * g.precede(parse, stats);
+ * g.precede(check, gen);
+ * g.run();
+ * @endcode
+ *
+ * If a task throws an exception, the tasks not already started are
+ * skipped and run() throws a MessageException with the message of the
+ * first exception (the message of an elm::Exception, the result of what()
+ * for a std::exception, "unknown exception" else).
+ *
+ * @ingroup system
+ */
+
+
+/**
+ */
+TaskGraph::TaskGraph(void): failed(false) {
+}
+
+
+/**
+ */
+TaskGraph::~TaskGraph(void) {
+	for(auto t: tasks)
+		delete t;
+}
+
+
+/**
+ * Add a task to the graph.
+ * @param f		Function performing the task.
+ * @return		Task identifier.
+ */
+TaskGraph::task_t TaskGraph::add(const std::function<void(void)>& f) {
+	tasks.add(new TaskNode(*this, f));
+	return tasks.length() - 1;
+}
+
+
+/**
+ * Add a dependency between two tasks.
+ * @param before	Task that must end before the other one starts.
+ * @param after		Task that depends on the first one.
+ */
+void TaskGraph::precede(task_t before, task_t after) {
+	ASSERTP(0 <= before && before < tasks.length(), "bad task");
+	ASSERTP(0 <= after && after < tasks.length(), "bad task");
+	tasks[before]->succs.add(tasks[after]);
+	tasks[after]->preds++;
+}
+
+
+/**
+ * @fn int TaskGraph::count(void) const;
+ * Get the number of tasks.
+ * @return	Task count.
+ */
+
+
+/**
+ * Execute the tasks of the graph. The graph can be run several times.
+ * @param threads	Number of threads (0 for the number of cores).
+ * @throw MessageException	If a task fails or if the graph contains a cycle.
+ */
+void TaskGraph::run(int threads) {
+	Vector<TaskNode *> roots;
+	for(auto t: tasks) {
+		t->pending = t->preds;
+		t->done = false;
+		if(t->preds == 0)
+			roots.add(t);
+	}
+	failed = false;
+	err = "";
+
+	RootProducer prod(roots);
+	if(!parallel::impl::schedule(prod, threads)) {
+		Vector<TaskNode *> ready;
+		for(int i = roots.length() - 1; i >= 0; i--)
+			ready.push(roots[i]);
+		while(ready && !failed) {
+			TaskNode *t = ready.pop();
+			t->perform();
+			for(auto s: t->succs)
+				if(--s->pending == 0)
+					ready.push(s);
+		}
+	}
+
+	if(failed)
+		throw MessageException(err);
+	for(auto t: tasks)
+		if(!t->done)
+			throw MessageException("cycle in task graph");
+}
+
+
+/**
+ * Record the failure of a task: only the first message is kept
+ * and the tasks not already started are skipped.
+ * @param message	Failure message.
+ */
+void TaskGraph::fail(const string& message) {
+	LockGuard<SpinLock> g(lock);
+	if(!failed) {
+		err = message;
+		failed = true;
+	}
+}
+
+} }	// elm::sys
@@ -0,0 +1,181 @@
+/*
+ *	parallel iteration documentation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2015, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <mutex>
+#include <elm/sys/parallel.h>
+#include <elm/sys/System.h>
+
+namespace elm { namespace parallel {
+
+/**
+ * @defgroup parallel Parallel Iteration
+ *
+ * The functions of namespace elm::parallel apply a function to the items
+ * of any collection (@ref elm::concept::Collection) using several threads:
+ * forEach(), map(), reduce() and fold(). They are declared in header
+ * @ref <elm/sys/parallel.h>.
+ *
+ * The collection is split into chunks of consecutive items (the grain) that
+ * are executed as jobs by a process-wide sys::JobScheduler: its threads are
+ * created at the first use and then sleep between the calls, and stealing
+ * balances the load between them. The scheduler processes one call at
+ * a time: a call performed while it is busy (call from inside a parallel
+ * function or concurrent call from another thread) is executed
+ * sequentially by the calling thread. As the chunks
+ * are obtained by following the collection iterator, any collection
+ * is supported (Vector, Array, FragTable, HashMap, etc) but the collection
+ * must not be modified during the processing.
+ *
+ * If the function raises an exception, the chunks not yet started are
+ * skipped and the first raised exception is thrown back, with its original
+ * type, by the parallel function to the calling thread; the scheduler
+ * is then ready for the next call.
+ *
+ * Each function takes two optional arguments:
+ * @li grain -- number of items per chunk (default to 0 to select
+ * a grain giving about 256 chunks),
+ * @li threads -- number of threads (default to 0 for the number
+ * of cores of the host).
+ *
+ * With a fixed grain, the chunks do not depend on the number of threads
+ * and reduce() or fold() combines the partial results in the collection order:
+ * its result is deterministic even with a non-associative operation
+ * like floating-point addition.
+ *
+ * @code
+ * #include <elm/sys/parallel.h>
+ *
+ * Vector<double> v = ...;
+ * double s = parallel::reduce(v, 0., [](double a, double x) { return a + x; });
+ * Vector<double> w = parallel::map(v, [](double x) { return x * x; });
+ * @endcode
+ */
+
+
+/**
+ * @fn void forEach(const C& c, F f, int grain, int threads);
+ * Call the function f on each item of the collection c in parallel.
+ * As f is called concurrently, it must be thread-safe.
+ * @param c			Collection to process.
+ * @param f			Function called as f(item).
+ * @param grain		Number of items per job (0 for automatic).
+ * @param threads	Number of threads (0 for the number of cores).
+ * @ingroup parallel
+ */
+
+
+/**
+ * @fn Vector<R> map(const C& c, F f, int grain, int threads);
+ * Build a vector made of the results of f applied to each item
+ * of the collection c. The results are stored in the collection order.
+ * @param c			Collection to process.
+ * @param f			Function called as f(item) and returning a value of type R.
+ * @param grain		Number of items per job (0 for automatic).
+ * @param threads	Number of threads (0 for the number of cores).
+ * @return			Vector of results.
+ * @ingroup parallel
+ */
+
+
+/**
+ * @fn T fold(const C& c, const T& zero, F f, G combine, int grain, int threads);
+ * Reduce the items of a collection in parallel. Each chunk is accumulated
+ * starting from zero with a = f(a, item) and the chunk results are then
+ * combined in the collection order with a = combine(a, chunk result),
+ * also starting from zero. zero must be the neutral element of combine.
+ * @param c			Collection to process.
+ * @param zero		Neutral value.
+ * @param f			Accumulation function.
+ * @param combine	Combination function of chunk results.
+ * @param grain		Number of items per job (0 for automatic).
+ * @param threads	Number of threads (0 for the number of cores).
+ * @return			Reduced value.
+ * @ingroup parallel
+ */
+
+
+/**
+ * @fn T reduce(const C& c, const T& zero, F f, int grain, int threads);
+ * Same as fold(c, zero, f, f, grain, threads): the items must be
+ * of type T and f is used both to accumulate and to combine.
+ * @param c			Collection to process.
+ * @param zero		Neutral value.
+ * @param f			Reduction function.
+ * @param grain		Number of items per job (0 for automatic).
+ * @param threads	Number of threads (0 for the number of cores).
+ * @return			Reduced value.
+ * @ingroup parallel
+ */
+
+namespace impl {
+
+/**
+ * @class Failure
+ * Record of the first exception raised by the jobs of a parallel call.
+ * @ingroup parallel
+ */
+
+/**
+ * Record the current exception, if it is the first one: must be called
+ * from a catch block.
+ */
+void Failure::record(void) {
+	std::lock_guard<std::mutex> g(_mutex);
+	if(!_exn)
+		_exn = std::current_exception();
+	_failed = true;
+}
+
+/**
+ * If an exception has been recorded, throw it again.
+ */
+void Failure::rethrow(void) {
+	if(_failed)
+		std::rethrow_exception(_exn);
+}
+
+static std::mutex pool_lock;
+static sys::JobScheduler *pool = nullptr;
+
+/**
+ * Run the jobs of the producer with the process-wide scheduler.
+ * @param prod		Job producer.
+ * @param threads	Number of threads (0 for the number of cores).
+ * @return			True if the jobs have been executed, false if the
+ *					scheduler is busy.
+ */
+bool schedule(sys::JobProducer& prod, int threads) {
+	std::unique_lock<std::mutex> g(pool_lock, std::try_to_lock);
+	if(!g.owns_lock())
+		return false;
+	if(pool == nullptr) {
+		pool = new sys::JobScheduler();
+		pool->setBatchSize(1);
+	}
+	pool->setProducer(prod);
+	pool->setThreadCount(threads > 0 ? threads : sys::System::coreCount());
+	pool->start();
+	return true;
+}
+
+}	// impl
+
+} }	// elm::parallel
@@ -26,6 +26,7 @@
 #include <elm/string.h>
 #if defined(__unix) || defined(__APPLE__)
 #	include <pthread.h>
+#	include <sched.h>
 #	include <errno.h>
 #	include <string.h>
 #elif defined(WIN32) || defined(WIN64)
@@ -160,6 +161,11 @@ Thread::~Thread(void) {
  * @return Current thread.
  */
 
+/**
+ * @fn void Thread::yield(void);
+ * Let the current thread give up the processor to let other threads run.
+ */
+
 /**
  * @fn void Thread::setRootRunnable(Runnable& runnable);
  * Convenient function to set the runnable of root thread.
@@ -334,6 +340,10 @@ Mutex::~Mutex(void) { }
 		return static_cast<Thread *>(pthread_getspecific(PThread::_key));
 	}
 
+	void Thread::yield(void) {
+		sched_yield();
+	}
+
 #elif defined(__WIN32) || defined(__WIN64)
 
 	/**
@@ -388,6 +398,10 @@ Mutex::~Mutex(void) { }
 		HANDLE handle;
 	};
 
+	void Thread::yield(void) {
+		SwitchToThread();
+	}
+
 	// TODO test it!
 	class WinMutex: public Mutex {
 	public:
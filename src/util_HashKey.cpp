@@ -39,11 +39,11 @@ namespace elm {
 
 
 /**
- * @class JenkinsHasher
+ * @class Hasher
  * Perform compositional hashing of data (for hash table for example) combining hash
- * of simple data using the XOR operation.
+ * of simple data using the @ref hash_combine() function.
  *
- * Although the function @ref hash_jenkins() does the same, it is not recommended
+ * Although the function @ref hash_block() does the same, it is not recommended
  * to use it as is on custom classes. Depending on the type of attributes,
  * padding bytes may be inserted and not initialized. When the @ref hash_jenkins
  * is called on such an object, this padding bytes will be involved in the hash
@@ -87,6 +87,7 @@ namespace elm {
 /**
  * Perform hashing according Jenkins approach
  * (https://en.wikipedia.org/wiki/Jenkins_hash_function).
+ * As this function processes a byte at a time, @ref hash_block() should be preferred.
  * @ingroup utility
  */
 t::hash hash_jenkins(const void *block, int size) {
@@ -113,42 +114,133 @@ t::hash hash_jenkins(const void *block, int size) {
  */
 
 
+// wyhash primitives
+static const t::uint64 wyp[4] = {
+	0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+	0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+};
+
+static inline void wymum(t::uint64& a, t::uint64& b) {
+#	ifdef __SIZEOF_INT128__
+		__uint128_t r = a;
+		r *= b;
+		a = t::uint64(r);
+		b = t::uint64(r >> 64);
+#	else
+		t::uint64 ha = a >> 32, hb = b >> 32, la = t::uint32(a), lb = t::uint32(b);
+		t::uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, lo = rl + (rm0 << 32);
+		t::uint64 c = lo < rl;
+		t::uint64 lo2 = lo + (rm1 << 32);
+		c += lo2 < lo;
+		a = lo2;
+		b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#	endif
+}
+
+static inline t::uint64 wymix(t::uint64 a, t::uint64 b)
+	{ wymum(a, b); return a ^ b; }
+static inline t::uint64 wyr8(const t::uint8 *p)
+	{ t::uint64 v; memcpy(&v, p, 8); return v; }
+static inline t::uint64 wyr4(const t::uint8 *p)
+	{ t::uint32 v; memcpy(&v, p, 4); return v; }
+static inline t::uint64 wyr3(const t::uint8 *p, int k)
+	{ return (t::uint64(p[0]) << 16) | (t::uint64(p[k >> 1]) << 8) | p[k - 1]; }
+
+
 /**
- * Use a classical compiler string hashing algorithm (see "The Compilers"
- * by Aho, Sethi, Ullman).
+ * Perform hashing of a memory block reading it a word at a time.
+ * The used function is wyhash (https://github.com/wangyi-fudan/wyhash):
+ * it is fast on short as well as on long blocks and all bits of the result,
+ * including the lower ones, depend on all the bytes of the block.
+ *
+ * The result depends on the endianness of the host: it must not be stored
+ * or exchanged with other hosts.
+ *
+ * @param block	Block to hash.
+ * @param size	Size of the block (in bytes).
+ * @return		Hash value.
  * @ingroup utility
  */
-t::hash hash_string(const char *chars, int length) {
-	t::hash h = 0, g;
-	for(int i = 0; i < length; i++) {
-		h = (h << 4) + chars[i];
-		if((g = h & 0xf0000000)) {
-			h = h ^ (g >> 24);
-			h = h ^ g;
+t::hash hash_block(const void *block, int size) {
+	const t::uint8 *p = static_cast<const t::uint8 *>(block);
+	t::uint64 seed = wymix(wyp[0], wyp[1]), a, b;
+	if(size <= 16) {
+		if(size >= 4) {
+			a = (wyr4(p) << 32) | wyr4(p + ((size >> 3) << 2));
+			b = (wyr4(p + size - 4) << 32) | wyr4(p + size - 4 - ((size >> 3) << 2));
+		}
+		else if(size > 0) {
+			a = wyr3(p, size);
+			b = 0;
+		}
+		else
+			a = b = 0;
+	}
+	else {
+		int i = size;
+		if(i > 48) {
+			t::uint64 see1 = seed, see2 = seed;
+			do {
+				seed = wymix(wyr8(p) ^ wyp[1], wyr8(p + 8) ^ seed);
+				see1 = wymix(wyr8(p + 16) ^ wyp[2], wyr8(p + 24) ^ see1);
+				see2 = wymix(wyr8(p + 32) ^ wyp[3], wyr8(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while(i > 48);
+			seed ^= see1 ^ see2;
+		}
+		while(i > 16) {
+			seed = wymix(wyr8(p) ^ wyp[1], wyr8(p + 8) ^ seed);
+			i -= 16;
+			p += 16;
 		}
+		a = wyr8(p + i - 16);
+		b = wyr8(p + i - 8);
 	}
-	return h;
+	a ^= wyp[1];
+	b ^= seed;
+	wymum(a, b);
+	return t::hash(wymix(a ^ wyp[0] ^ t::uint64(size), b ^ wyp[1]));
+}
+
+
+/**
+ * Hash a string of characters. The hashing is performed by @ref hash_block().
+ * @param chars		Characters to hash.
+ * @param length	Number of characters.
+ * @return			Hash value.
+ * @ingroup utility
+ */
+t::hash hash_string(const char *chars, int length) {
+	return hash_block(chars, length);
 }
 
 
 /**
- * Use a classical compiler string hashing algorithm (see "The Compilers"
- * by Aho, Sethi, Ullman).
+ * Hash a null-terminated string of characters. The hashing is performed by
+ * @ref hash_block() and returns the same value as @ref hash_string()
+ * for the same characters.
+ * @param chars		Characters to hash.
+ * @return			Hash value.
  * @ingroup utility
  */
 t::hash hash_cstring(const char *chars) {
-	t::hash h = 0, g;
-	for(; *chars; chars++) {
-		h = (h << 4) + *chars;
-		if((g = h & 0xf0000000)) {
-			h = h ^ (g >> 24);
-			h = h ^ g;
-		}
-	}
-	return h;
+	return hash_block(chars, strlen(chars));
 }
 
 
+/**
+ * @fn t::hash hash_combine(t::hash h, t::hash v);
+ * Combine a hash value with the hash of a new component. Unlike a simple XOR
+ * or addition, the combination depends on the order of the components and
+ * does not cancel equal components.
+ * @param h		Current hash value.
+ * @param v		Hash of the new component.
+ * @return		Combined hash value.
+ * @ingroup utility
+ */
+
+
 /**
  * Test equality of two memory blocks.
  * @param p1	First memory block.
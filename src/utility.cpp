@@ -51,8 +51,9 @@ namespace elm {
  * @li @ref LockPtr and @ref Lock -- provides an automatic pointer management
  * system,
  * @li @ref Ref -- mutable references.
- * @li @ref SharedPtr
+ * @li @ref SharedPtr and @ref AtomicSharedPtr
  * @li @ref UniquePtr
+ * @li @ref RefCount -- reference counter policies.
  * Notice that the set of pointer wrapper classes can be include with "elm/ptr.h".
  *
  * @par deprecated
@@ -172,11 +173,81 @@ string KeyException::message(void) {
  * Beware: this also means that pointed objects forming a cycle will not
  * be deleted!
  *
+ * The counter is handled by the policy C, by default @ref RefCount, that
+ * is atomic only if ELM is configured with ELM_ATOMIC_REF. A shared pointer
+ * whose copies are used by several threads may be declared as an
+ * @ref AtomicSharedPtr whatever the configuration.
+ *
+ * @param T		Type of pointed object.
+ * @param C		Counter policy (one of @ref PlainCount or @ref AtomicCount).
+ * @ingroup		utility
+ */
+
+
+/**
+ * @typedef AtomicSharedPtr
+ * Shared pointer whose counter is always incremented and decremented
+ * atomically: its copies may be used and released by different threads.
  * @param T		Type of pointed object.
  * @ingroup		utility
  */
 
 
+/**
+ * @class PlainCount
+ * Reference counter policy using plain integer operations. This is the
+ * fastest policy but the counted objects cannot be shared between threads.
+ * @param T		Type of the counter.
+ * @ingroup		utility
+ */
+
+/**
+ * @fn void PlainCount::incr(T& c);
+ * Increment the counter.
+ * @param c		Counter to increment.
+ */
+
+/**
+ * @fn bool PlainCount::decr(T& c);
+ * Decrement the counter.
+ * @param c		Counter to decrement.
+ * @return		True if the counter reaches 0 (and the object can be released).
+ */
+
+/**
+ * @fn T PlainCount::get(const T& c);
+ * Read the counter.
+ * @param c		Counter to read.
+ * @return		Counter value.
+ */
+
+
+/**
+ * @class AtomicCount
+ * Reference counter policy using atomic operations: increments are relaxed
+ * and decrements have acquire-release semantics so that the thread releasing
+ * the last reference sees all the changes done by the other owners.
+ * @param T		Type of the counter.
+ * @ingroup		utility
+ */
+
+
+/**
+ * @typedef RefCount
+ * Default reference counter policy of @ref String and @ref SharedPtr:
+ * @ref AtomicCount if ELM is configured with ELM_ATOMIC_REF,
+ * @ref PlainCount else. The "bench-refcount" program in perf/ measures
+ * the cost of atomic counters in single-threaded code.
+ *
+ * The mode is fixed by the installed <elm/arch.h> (ELM_ARCH_ATOMIC_REF)
+ * so that the inline code of the clients matches the library: compiling
+ * a client with ELM_ATOMIC_REF defined against a library configured
+ * without it fails with an error.
+ * @param T		Type of the counter.
+ * @ingroup		utility
+ */
+
+
 /**
  * @class LockPtr
  * Implements a pointer wrapper class that takes care of the usage of
@@ -87,6 +87,18 @@ String Attribute::getLocalName(void) const {
 }
 
 
+/**
+ * Returns the local name of this attribute as a symbol of the global
+ * symbol table (interned at the first call and then kept by the attribute).
+ * @return	the attribute's local name as a symbol
+ */
+Symbol Attribute::getLocalSymbol(void) const {
+	if(!sym)
+		sym = SymbolTable::global().intern(getLocalName());
+	return sym;
+}
+
+
 /**
  * Unsupported.
  */
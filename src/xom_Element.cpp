@@ -384,6 +384,19 @@ String Element::getLocalName(void) {
 }
 
 
+/**
+ * Returns the local name of this element as a symbol of the global
+ * symbol table: comparing it with other symbols is a pointer comparison.
+ * The symbol is interned at the first call and then kept by the element.
+ * @return The local name of this element as a symbol.
+ */
+Symbol Element::getLocalSymbol(void) {
+	if(!sym)
+		sym = SymbolTable::global().intern(cstring((const char *)NODE(node)->name));
+	return sym;
+}
+
+
 /**
  * Returns the number of namespace declarations on this element. This counts the
  * namespace of the element itself (which may be the empty string), the
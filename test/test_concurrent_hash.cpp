@@ -0,0 +1,128 @@
+/*
+ *	ConcurrentHashMap test
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#include <elm/data/ConcurrentHashMap.h>
+#include <elm/sys/Thread.h>
+#include <elm/util/MessageException.h>
+#include <elm/test.h>
+#include <functional>
+
+using namespace elm;
+
+typedef ConcurrentHashMap<int, int> map_t;
+
+class Worker: public sys::Runnable {
+public:
+	Worker(map_t& map, int n): _map(map), _n(n), failed(false), computed(0) { }
+	void run() override {
+		for(int i = 0; i < _n; i++) {
+			int v = _map.computeIfAbsent(i, [this](int k) { computed++; return k * 2; });
+			if(v != i * 2)
+				failed = true;
+			auto o = _map.putIfAbsent(_n + i, i);
+			if(o && *o != i)
+				failed = true;
+		}
+	}
+private:
+	map_t& _map;
+	int _n;
+public:
+	bool failed;
+	int computed;
+};
+
+TEST_BEGIN(concurrent_hash)
+
+	// sequential use
+	{
+		map_t map(5);
+		CHECK_EQUAL(map.stripes(), 8);
+		CHECK(map.isEmpty());
+		map.put(1, 10);
+		map.put(2, 20);
+		CHECK_EQUAL(map.count(), 2);
+		CHECK_EQUAL(map.get(1, 0), 10);
+		CHECK(map.hasKey(2));
+		CHECK(!map.get(3));
+		CHECK(map.putIfAbsent(3, 30).none());
+		CHECK_EQUAL(*map.putIfAbsent(3, 31), 30);
+		CHECK_EQUAL(map.computeIfAbsent(3, [](int k) { return 0; }), 30);
+		CHECK_EQUAL(map.computeIfAbsent(4, [](int k) { return k * 10; }), 40);
+		map_t one(1);
+		CHECK_EQUAL(one.computeIfAbsent(5, [&one](int k) { one.put(k + 1, k); return *one.get(k + 1) * 2; }), 10);
+		CHECK_EQUAL(one.get(6, 0), 5);
+		map.remove(1);
+		CHECK(!map.hasKey(1));
+		int sum = 0;
+		map.forEach([&sum](int k, int v) { sum += v; });
+		CHECK_EQUAL(sum, 90);
+		map.clear();
+		CHECK(map.isEmpty());
+	}
+
+	// recursive memoization and failing computation
+	{
+		ConcurrentHashMap<int, t::uint64> memo(1);
+		std::function<t::uint64(int)> fib = [&memo, &fib](int n) -> t::uint64
+			{ return n < 2 ? n : memo.computeIfAbsent(n - 1, fib) + memo.computeIfAbsent(n - 2, fib); };
+		CHECK_EQUAL(memo.computeIfAbsent(60, fib), t::uint64(1548008755920ULL));
+		CHECK_EQUAL(memo.count(), 61);
+		map_t one(1);
+		bool caught = false;
+		try {
+			one.computeIfAbsent(1, [](int k) -> int { throw MessageException("failed"); });
+		}
+		catch(MessageException& e) {
+			caught = true;
+		}
+		CHECK(caught);
+		CHECK(!one.hasKey(1));
+		CHECK_EQUAL(one.computeIfAbsent(1, [](int k) { return k + 1; }), 2);
+	}
+
+	// concurrent use
+	{
+		const int N = 10000, T = 4;
+		map_t map;
+		Worker *workers[T];
+		sys::Thread *threads[T];
+		for(int i = 0; i < T; i++) {
+			workers[i] = new Worker(map, N);
+			threads[i] = sys::Thread::make(*workers[i]);
+		}
+		for(int i = 0; i < T; i++)
+			threads[i]->start();
+		for(int i = 0; i < T; i++)
+			threads[i]->join();
+		bool failed = false;
+		int computed = 0;
+		for(int i = 0; i < T; i++) {
+			failed = failed || workers[i]->failed;
+			computed += workers[i]->computed;
+			delete threads[i];
+			delete workers[i];
+		}
+		CHECK(!failed);
+		CHECK_EQUAL(computed, N);
+		CHECK_EQUAL(map.count(), 2 * N);
+	}
+
+TEST_END
@@ -0,0 +1,201 @@
+/*
+ *	FlatHashMap and FlatHashSet test
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#include <elm/data/FlatHashMap.h>
+#include <elm/data/FlatHashSet.h>
+#include <elm/data/Vector.h>
+#include <elm/io.h>
+#include <elm/util/BitVector.h>
+#include <elm/test.h>
+#include "check-concept.h"
+
+using namespace elm;
+
+// hash producing long clusters
+class ClusterHash {
+public:
+	static inline t::hash hash(int key) { return t::hash(key % 61); }
+	static inline bool equals(int key1, int key2) { return key1 == key2; }
+	inline t::hash computeHash(int key) const { return hash(key); }
+	inline bool isEqual(int key1, int key2) const { return equals(key1, key2); }
+};
+
+TEST_BEGIN(flat_hash)
+
+	// syntax tests
+	{
+		FlatHashTable<int> t;
+		const FlatHashTable<int> ct(t);
+		checkCollection(t, ct, 1);
+		checkMutableCollection(t, 1);
+	}
+	{
+		FlatHashMap<int, int> m;
+		const FlatHashMap<int, int> cm(m);
+		checkCollection(m, cm, 1);
+		checkMap(m, 1, 2);
+	}
+	{
+		FlatHashSet<int> s;
+		const FlatHashSet<int> cs(s);
+		checkCollection(s, cs, 1);
+		checkMutableCollection(s, 1);
+		checkSet(s, 1);
+	}
+
+	// simple key
+	{
+		FlatHashMap<int, int> map;
+		CHECK(map.isEmpty());
+		CHECK_EQUAL(map.count(), 0);
+		map.put(666, 111);
+		CHECK(!map.isEmpty());
+		CHECK_EQUAL(map.count(), 1);
+		CHECK_EQUAL(map.get(666, 0), 111);
+		CHECK_EQUAL(map.get(111, 0), 0);
+		map.put(777, 222);
+		CHECK_EQUAL(map.count(), 2);
+		CHECK_EQUAL(map.get(666, 0), 111);
+		CHECK_EQUAL(map.get(777, 0), 222);
+		map.put(666, 333);
+		CHECK_EQUAL(map.count(), 2);
+		CHECK_EQUAL(map.get(666, 0), 333);
+		map.remove(666);
+		CHECK_EQUAL(map.count(), 1);
+		CHECK_EQUAL(map.get(666, 0), 0);
+		CHECK_EQUAL(map.get(777, 0), 222);
+	}
+
+	// complex key
+	{
+		FlatHashMap<string, int> map;
+		map[str("god")] = 111;
+		map[str("devil")] = 666;
+		CHECK_EQUAL(111, *map[str("god")]);
+		CHECK_EQUAL(666, *map[str("devil")]);
+		map.fetch("god") = 0;
+		CHECK_EQUAL(0, *map[str("god")]);
+		CHECK(!map.hasKey("human"));
+	}
+
+	// growth, removal and iteration
+	{
+		FlatHashMap<int, int> map;
+		const int N = 100000;
+		for(int i = 0; i < N; i++)
+			map.put(i, N - i);
+		CHECK_EQUAL(map.count(), N);
+		bool failed = false;
+		for(int i = 0; i < N; i++)
+			if(map.get(i, 0) != N - i) {
+				failed = true;
+				break;
+			}
+		CHECK(!failed);
+		for(int i = 0; i < N; i += 2)
+			map.remove(i);
+		CHECK_EQUAL(map.count(), N / 2);
+		for(int i = 0; i < N; i++)
+			if(map.hasKey(i) != (i % 2 == 1)) {
+				failed = true;
+				break;
+			}
+		CHECK(!failed);
+		BitVector bv(N);
+		for(auto k: map.keys())
+			bv.set(k);
+		CHECK_EQUAL(bv.countBits(), N / 2);
+	}
+
+	// copy
+	{
+		FlatHashMap<string, int> map1, map2;
+		for(int i = 0; i < 100; i++)
+			map1.put(_ << i << (-i), i);
+		map2 = map1;
+		CHECK(map1 == map2);
+		map2.put("other", 0);
+		CHECK(map1 != map2);
+		CHECK(map1 <= map2);
+		CHECK(map1 < map2);
+	}
+
+	// set
+	{
+		FlatHashSet<int> set;
+		set.add(111);
+		set.add(666);
+		set.add(111);
+		CHECK_EQUAL(set.count(), 2);
+		CHECK(set.contains(111));
+		CHECK(set.contains(666));
+		Vector<int> v;
+		v.add(666);
+		v.add(777);
+		set.addAll(v);
+		CHECK_EQUAL(set.count(), 3);
+		CHECK(set.containsAll(v));
+		set.removeAll(v);
+		CHECK_EQUAL(set.count(), 1);
+		CHECK(set.contains(111));
+		FlatHashSet<int> s2;
+		s2.reserve(1000);
+		int size = s2.size();
+		for(int i = 0; i < 1000; i++)
+			s2.add(i);
+		CHECK_EQUAL(s2.size(), size);
+		CHECK(set <= s2);
+		s2.meet(set);
+		CHECK(s2 == set);
+	}
+
+	// removal while iterating
+	{
+		FlatHashMap<int, int, ClusterHash> map;
+		const int N = 3000;
+		for(int i = 0; i < N; i++)
+			map.put(i, i);
+		BitVector seen(N);
+		bool twice = false;
+		for(auto i = map.begin(); !i.ended(); i.next()) {
+			if(seen.bit(i.key()))
+				twice = true;
+			seen.set(i.key());
+			if(i.key() % 3 != 0)
+				map.remove(i);
+		}
+		CHECK(!twice);
+		CHECK_EQUAL(seen.countBits(), N);
+		CHECK_EQUAL(map.count(), (N + 2) / 3);
+		bool failed = false;
+		for(int i = 0; i < N; i++)
+			if(map.hasKey(i) != (i % 3 == 0))
+				failed = true;
+		CHECK(!failed);
+
+		FlatHashSet<int, ClusterHash> set;
+		for(int i = 0; i < N; i++)
+			set.add(i);
+		for(auto i = set.begin(); !i.ended(); i.next())
+			set.remove(i);
+		CHECK(set.isEmpty());
+	}
+
+TEST_END
@@ -0,0 +1,181 @@
+/*
+ *	Future and Promise test
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#include <elm/sys/Future.h>
+#include <elm/test.h>
+#include <stdexcept>
+
+using namespace elm;
+using namespace elm::sys;
+
+class Setter: public Runnable {
+public:
+	Setter(Promise<int>& promise, int value): p(promise), v(value) { }
+	virtual void run(void) { for(int i = 0; i < 1000; i++) Thread::yield(); p.set(v); }
+private:
+	Promise<int> p;
+	int v;
+};
+
+TEST_BEGIN(future)
+
+	// simple set and get
+	{
+		Promise<int> p;
+		Future<int> f = p.future();
+		CHECK(!f.isReady());
+		p.set(111);
+		CHECK(f.isReady());
+		CHECK(!f.isFailed());
+		CHECK_EQUAL(f.get(), 111);
+	}
+
+	// failure
+	{
+		Promise<int> p;
+		Future<int> f = p.future();
+		p.fail("bad");
+		CHECK(f.isFailed());
+		CHECK_EQUAL(f.error(), string("bad"));
+		CHECK_EXCEPTION(FutureException, f.get());
+	}
+
+	// continuations
+	{
+		Promise<int> p;
+		Future<int> f = p.future();
+		Future<string> g = f.then([](int x) { return string(_ << "x" << x); });
+		Future<int> h = g.then([](const string& s) { return s.length(); });
+		CHECK(!h.isReady());
+		p.set(666);
+		CHECK_EQUAL(g.get(), string("x666"));
+		CHECK_EQUAL(h.get(), 4);
+		Future<int> k = f.then([](int x) { return x + 1; });
+		CHECK_EQUAL(k.get(), 667);
+		Future<int> e = f.then([](int) -> int { throw MessageException("oops"); });
+		CHECK(e.isFailed());
+		CHECK_EQUAL(e.error(), string("oops"));
+		Future<int> s = f.then([](int) -> int { throw std::runtime_error("std"); });
+		CHECK_EQUAL(s.error(), string("std"));
+		Future<int> u = f.then([](int) -> int { throw 0; });
+		CHECK_EQUAL(u.error(), string("unknown exception"));
+	}
+
+	// void futures
+	{
+		Promise<int> p;
+		int r = 0;
+		Future<void> v = p.future().then([&r](int x) { r = x; });
+		Future<int> w = v.then([&r]() { return r + 1; });
+		Future<void> e = v.then([]() { throw MessageException("void"); });
+		CHECK(!v.isReady());
+		p.set(10);
+		v.get();
+		CHECK_EQUAL(r, 10);
+		CHECK_EQUAL(w.get(), 11);
+		CHECK_EQUAL(e.error(), string("void"));
+		CHECK_EXCEPTION(FutureException, e.get());
+		Promise<void> q;
+		Future<void> f = q.future();
+		q.set();
+		CHECK(f.isReady());
+		CHECK(!f.isFailed());
+	}
+
+	// failure propagation
+	{
+		Promise<int> p;
+		Future<int> f = p.future().then([](int x) { return x * 2; });
+		p.fail("bad");
+		CHECK(f.isFailed());
+		CHECK_EQUAL(f.error(), string("bad"));
+	}
+
+	// threads, whenAll and whenAny
+	{
+		const int N = 4;
+		Vector<Promise<int> > ps;
+		Vector<Future<int> > fs;
+		for(int i = 0; i < N; i++) {
+			ps.add(Promise<int>());
+			fs.add(ps[i].future());
+		}
+		Future<Vector<int> > all = whenAll(fs);
+		Future<int> any = whenAny(fs);
+		CHECK(!all.isReady());
+		CHECK(!any.isReady());
+		Vector<Setter *> ss;
+		Vector<Thread *> ts;
+		for(int i = 0; i < N; i++) {
+			ss.add(new Setter(ps[i], i * 10));
+			ts.add(Thread::make(*ss[i]));
+			ts[i]->start();
+		}
+		const Vector<int>& r = all.get();
+		CHECK_EQUAL(r.length(), N);
+		bool ok = true;
+		for(int i = 0; i < N; i++)
+			if(r[i] != i * 10)
+				ok = false;
+		CHECK(ok);
+		CHECK(0 <= any.get() && any.get() < N);
+		for(int i = 0; i < N; i++) {
+			ts[i]->join();
+			delete ts[i];
+			delete ss[i];
+		}
+		CHECK_EQUAL(whenAll(Vector<Future<int> >()).get().length(), 0);
+	}
+
+	// whenAll failure
+	{
+		Promise<int> p1, p2;
+		Vector<Future<int> > fs;
+		fs.add(p1.future());
+		fs.add(p2.future());
+		Future<Vector<int> > all = whenAll(fs);
+		p1.fail("bad");
+		CHECK(!all.isReady());
+		p2.set(1);
+		CHECK(all.isFailed());
+	}
+
+	// whenAll on void futures
+	{
+		Promise<void> p1, p2;
+		Vector<Future<void> > fs;
+		fs.add(p1.future());
+		fs.add(p2.future());
+		Future<void> all = whenAll(fs);
+		p2.set();
+		CHECK(!all.isReady());
+		p1.set();
+		CHECK(all.isReady());
+		CHECK(!all.isFailed());
+		Promise<void> p3;
+		fs.add(p3.future());
+		Future<void> fall = whenAll(fs);
+		p3.fail("bad");
+		CHECK(fall.isFailed());
+		CHECK_EQUAL(fall.error(), string("bad"));
+		CHECK(whenAll(Vector<Future<void> >()).isReady());
+	}
+
+TEST_END
@@ -20,6 +20,7 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <string.h>
 #include <elm/hash.h>
 #include "../include/elm/test.h"
 
@@ -41,6 +42,33 @@ TEST_BEGIN(hashkey)
 		CHECK(!ht::equals(t1, t3));
 	}
 
+	// string hashing
+	{
+		const char *s = "a_rather_long_identifier_to_hash_with_several_words";
+		int l = strlen(s);
+		CHECK_EQUAL(hash_string(s, l), hash_cstring(s));
+		CHECK_EQUAL(HashKey<string>::hash(s), HashKey<cstring>::hash(s));
+		bool failed = false;
+		for(int i = 0; i < l; i++)
+			for(int j = i + 1; j <= l; j++)
+				if(hash_string(s, i) == hash_string(s, j))
+					failed = true;
+		CHECK(!failed);
+		CHECK(hash_string("id_1", 4) != hash_string("id_2", 4));
+		CHECK((hash_string("id_1", 4) & 0xff) != (hash_string("id_2", 4) & 0xff));
+	}
+
+	// hasher test (order)
+	{
+		Hasher h1, h2;
+		h1 << 1 << 2;
+		h2 << 2 << 1;
+		CHECK(h1.hash() != h2.hash());
+		Hasher h3;
+		h3 << 1 << 1;
+		CHECK(h3.hash() != Hasher().hash());
+	}
+
 	// hasher test (equality)
 	{
 		t::hash h1, h2;
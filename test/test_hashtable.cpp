@@ -64,6 +64,11 @@ TEST_BEGIN(hashtable)
 			get_bool(t != t);
 			t += 1;
 			t -= 1;
+			t.isAdaptive();
+			t.setAdaptive(true);
+			t.maxLoad();
+			t.setMaxLoad(2);
+			t.reserve(1000);
 		}
 	}
 
@@ -108,6 +113,11 @@ TEST_BEGIN(hashtable)
 			cm[1];
 			m[1] = 1;
 			m.fetch(1);
+			m.isAdaptive();
+			m.setAdaptive(true);
+			m.maxLoad();
+			m.setMaxLoad(2);
+			m.reserve(1000);
 		}
 	}
 
@@ -158,6 +168,11 @@ TEST_BEGIN(hashtable)
 			r = s - s;
 			r = s * s;
 			r = s & s;
+			s.isAdaptive();
+			s.setAdaptive(true);
+			s.maxLoad();
+			s.setMaxLoad(2);
+			s.reserve(1000);
 		}
 	}
 
@@ -341,4 +356,101 @@ TEST_BEGIN(hashtable)
 		CHECK(bv.countBits() == N);
 	}
 
+	// growing table
+	{
+		HashMap<int, int> map;
+		const int N = 100000;
+		for(int i = 0; i < N; i++)
+			map.put(i, N - i);
+		CHECK_EQUAL(map.count(), N);
+		CHECK(map.size() > 211);
+		bool failed = false;
+		for(int i = 0; i < N; i++)
+			if(map.get(i, 0) != N - i) {
+				failed = true;
+				break;
+			}
+		CHECK(!failed);
+		int cnt = 0;
+		for(auto x: map.keys()) {
+			if(x < 0 || x >= N)
+				failed = true;
+			cnt++;
+		}
+		CHECK(!failed);
+		CHECK_EQUAL(cnt, N);
+		for(int i = 0; i < N; i += 2)
+			map.remove(i);
+		CHECK_EQUAL(map.count(), N / 2);
+		CHECK(!map.hasKey(0));
+		CHECK(map.hasKey(1));
+	}
+
+	// pending re-hashing
+	{
+		HashSet<int> set(11);
+		for(int i = 0; i < 12; i++)
+			set.add(i);
+		int cnt = 0;
+		for(auto x: set) { get_bool(x); cnt++; }
+		CHECK_EQUAL(cnt, 12);
+		for(int i = 0; i < 12; i++)
+			set.remove(i);
+		cnt = 0;
+		for(auto x: set) { get_bool(x); cnt++; }
+		CHECK_EQUAL(cnt, 0);
+		CHECK(set.isEmpty());
+	}
+
+	// read-only look-ups
+	{
+		HashSet<int> set(7);
+		set.setMaxLoad(0);
+		for(int i = 0; i < 50; i++)
+			set.add(i);
+		Vector<int> before, after;
+		for(auto x: set)
+			before.add(x);
+		for(int i = 0; i < 50; i += 3)
+			CHECK(set.contains(i));
+		for(auto x: set)
+			after.add(x);
+		CHECK(before == after);
+
+		set.setAdaptive(true);
+		CHECK(set.isAdaptive());
+		bool failed = false;
+		for(int i = 0; i < 50; i += 3)
+			if(!set.contains(i))
+				failed = true;
+		for(int i = 50; i < 60; i++)
+			if(set.contains(i))
+				failed = true;
+		CHECK(!failed);
+		CHECK_EQUAL(set.count(), 50);
+	}
+
+	// reserved table
+	{
+		HashSet<string> set;
+		set.reserve(5000);
+		int size = set.size();
+		CHECK(size >= 5000);
+		for(int i = 0; i < 5000; i++)
+			set.add(_ << "key" << i);
+		CHECK_EQUAL(set.size(), size);
+		CHECK_EQUAL(set.count(), 5000);
+		CHECK(set.contains("key4999"));
+	}
+
+	// fixed-size table
+	{
+		HashSet<int> set(11);
+		set.setMaxLoad(0);
+		for(int i = 0; i < 100; i++)
+			set.add(i);
+		CHECK_EQUAL(set.size(), 11);
+		CHECK_EQUAL(set.count(), 100);
+	}
+
 TEST_END
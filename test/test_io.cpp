@@ -20,6 +20,8 @@
  */
 
 #include <elm/test.h>
+#include <elm/io/BlockInStream.h>
+#include <elm/io/BufferedInStream.h>
 #include <elm/io/StringInput.h>
 #include <elm/io/VarExpander.h>
 #include <elm/string/StringBuffer.h>
@@ -60,6 +62,33 @@ public:
 cstring IntManager::t[4] = { "zero", "one", "two", "three" };
 
 
+// stream without window: the characters are read one by one
+class CharStream: public io::InStream {
+public:
+	CharStream(const char *text): p(text) { }
+	int read(void *buffer, int size) override
+		{ int n = 0; for(; n < size && *p; n++) static_cast<char *>(buffer)[n] = *p++; return n; }
+	int read(void) override { return *p ? static_cast<unsigned char>(*p++) : ENDED; }
+private:
+	const char *p;
+};
+
+// apply the scan operations (L: long long, U: unsigned long long, D: double, W: word)
+static string scan_trace(io::Input& in, const char *ops) {
+	StringBuffer buf;
+	for(; *ops; ops++) {
+		switch(*ops) {
+		case 'L':	buf << in.scanLLong(); break;
+		case 'U':	buf << in.scanULLong(); break;
+		case 'D':	buf << in.scanDouble(); break;
+		case 'W':	buf << in.scanWord(); break;
+		}
+		buf << (in.failed() ? "! " : " ");
+		in.resetState();
+	}
+	return buf.toString();
+}
+
 TEST_BEGIN(io)
 
 	OSExpander e;
@@ -136,6 +165,55 @@ TEST_BEGIN(io)
 		CHECK_EQUAL(io::read("0").scanBool(), false);
 	}
 
+	// input parsed in the stream buffer
+	{
+		io::BlockInStream bs("12 -34\n1.25e-2 18446744073709551615 -9223372036854775808 0x1F 1e 7");
+		io::Input x(bs);
+		CHECK_EQUAL(x.scanLong(), 12);
+		CHECK_EQUAL(x.scanLLong(), -34LL);
+		CHECK_EQUAL(x.scanDouble(), 1.25e-2);
+		CHECK_EQUAL(x.scanULLong(), 18446744073709551615ULL);
+		CHECK_EQUAL(x.scanLLong(), t::int64(-9223372036854775807LL - 1));
+		CHECK_EQUAL(x.scanULong(), 31U);
+		CHECK(!x.failed());
+		x.scanDouble();
+		CHECK(x.failed());
+		x.resetState();
+		CHECK_EQUAL(x.scanULong(), 7U);
+		CHECK(x.ended());
+	}
+
+	// same results whether the numbers are parsed in the buffer or not
+	{
+		const char *text = "- 5 +7 -0x10 1e+ 12abc 99999999999999999999 0x 1.5e3, -.5 077 08";
+		const char *ops = "LLLLDLWUUDWDLLL";
+		io::BlockInStream bs1(text), bs2(text);
+		io::BufferedInStream bis(bs2, 4);
+		CharStream cs(text);
+		io::Input in1(bs1), in2(bis), in3(cs);
+		string r = scan_trace(in1, ops);
+		CHECK_EQUAL(r, string("0! 5 7 -16 0! 12 abc 0! 0! 1500 , -0.5 63 0 8 "));
+		CHECK_EQUAL(scan_trace(in2, ops), r);
+		CHECK_EQUAL(scan_trace(in3, ops), r);
+	}	{
+		CHECK_EQUAL(io::read("2.5e-3").scanDouble(), 2.5e-3);
+		CHECK_EQUAL(io::read("0.1").scanDouble(), 0.1);
+		CHECK_EQUAL(io::read("-2147483648").scanLong(), -2147483647 - 1);
+		auto x = io::read("4294967296");
+		x.scanULong();
+		CHECK(x.failed());
+	}
+	{
+		io::BlockInStream bs("3.14159 2718281828459045 -1e300 42 ");
+		io::BufferedInStream in(bs, 5);
+		io::Input x(in);
+		CHECK_EQUAL(x.scanDouble(), 3.14159);
+		CHECK_EQUAL(x.scanULLong(), 2718281828459045ULL);
+		CHECK_EQUAL(x.scanDouble(), -1e300);
+		CHECK_EQUAL(x.scanLong(), 42);
+		CHECK(!x.failed());
+	}
+
 	{
 		auto x = io::read("1\n2\n3");
 		CHECK_EQUAL(x.scanLine(), string("1\n"));
@@ -156,6 +234,13 @@ TEST_BEGIN(io)
 		CHECK_EQUAL(i, 3);
 	}
 
+	// input from a temporary small string
+	{
+		io::StringInput in(string(_ << "12 " << 34));
+		CHECK_EQUAL(in.scanLong(), 12);
+		CHECK_EQUAL(in.scanLong(), 34);
+	}
+
 	// overloading test
 	if(false) {
 		cout << 1;
@@ -174,5 +259,67 @@ TEST_BEGIN(io)
 		cout << t::uint64(1);
 	}
 
+	// block output stream
+	{
+		io::BlockOutStream s(16, 4);
+		for(int i = 0; i < 10000; i++)
+			s.write(char('a' + i % 26));
+		CHECK_EQUAL(s.size(), 10000);
+		CHECK(s.block()[9999] == char('a' + 9999 % 26));
+		CHECK(s.chunkCount() == 1);
+		s.reserve(100000);
+		const char *b = s.block();
+		for(int i = 0; i < 90000; i++)
+			s.write('x');
+		CHECK(b == s.block());
+		delete [] s.detach();
+	}
+
+	// chunked block output stream
+	{
+		io::BlockOutStream s(16, 4, true);
+		CHECK(s.isChunked());
+		for(int i = 0; i < 1000; i++)
+			s.write("0123456789", 10);
+		CHECK_EQUAL(s.size(), 10000);
+		CHECK(s.chunkCount() > 1);
+		int t = 0;
+		bool ok = true;
+		for(int i = 0; i < s.chunkCount(); i++) {
+			io::BlockOutStream::chunk_t c = s.chunk(i);
+			for(int j = 0; j < c.size; j++)
+				if(c.base[j] != '0' + (t + j) % 10)
+					ok = false;
+			t += c.size;
+		}
+		CHECK(ok);
+		CHECK_EQUAL(t, 10000);
+		int n;
+		io::BlockOutStream::chunk_t *cs = s.detachChunks(n);
+		CHECK_EQUAL(s.size(), 0);
+		t = 0;
+		for(int i = 0; i < n; i++) {
+			t += cs[i].size;
+			delete [] cs[i].base;
+		}
+		delete [] cs;
+		CHECK_EQUAL(t, 10000);
+		for(int i = 0; i < 100; i++)
+			s.write("0123456789", 10);
+		s.write('!');
+		String str = s.toString();
+		CHECK_EQUAL(str.length(), 1001);
+		CHECK(str.endsWith("789!"));
+		CHECK_EQUAL(s.chunkCount(), 1);
+		for(int i = 0; i < 1000; i++)
+			s.write("0123456789", 10);
+		CHECK(s.chunkCount() > 1);
+		CHECK(s.block()[1001] == '0');
+		const io::BlockOutStream& cs2 = s;
+		CHECK_EQUAL(cs2.chunkCount(), 1);
+		CHECK(cs2.block()[11000] == '9');
+		CHECK_EQUAL(cs2.size(), 11001);
+	}
+
 TEST_END
 
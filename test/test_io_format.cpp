@@ -5,6 +5,7 @@
  * test/test_io_format.cpp -- formatted io classes test.
  */
 
+#include <stdlib.h>
 #include <elm/io.h>
 #include <elm/string.h>
 #include <elm/io/BlockInStream.h>
@@ -17,6 +18,7 @@
 #include <elm/io/InFileStream.h>
 #include <elm/sys/System.h>
 #include <elm/io/BufferedInStream.h>
+#include <elm/io/numconv.h>
 
 using namespace elm;
 using namespace elm::io;
@@ -185,6 +187,119 @@ TEST_BEGIN(io_format)
 		CHECK_EQUAL(string(_ << io::fmt(12.34)), string("12.34"));
 	}
 
+	// number to text conversions
+	{
+		CHECK_EQUAL(string(_ << 0 << ' ' << -12345 << ' ' << t::int64(-9223372036854775807LL - 1)),
+			string("0 -12345 -9223372036854775808"));
+		CHECK_EQUAL(string(_ << t::uint64(18446744073709551615ULL) << ' ' << hex(t::uint64(0xbeef))),
+			string("18446744073709551615 beef"));
+		CHECK_EQUAL(string(_ << bin(t::uint64(-1))), string::make("1", 64));
+		CHECK_EQUAL(string(_ << 0.1 << ' ' << 1.5 << ' ' << -0.0 << ' ' << 100.), string("0.1 1.5 -0 100"));
+		CHECK_EQUAL(string(_ << 0.1 + 0.2), string("0.30000000000000004"));
+		CHECK_EQUAL(string(_ << 1e20 << ' ' << 1e-7 << ' ' << 5e-324), string("1e+20 1e-07 5e-324"));
+		CHECK_EQUAL(string(_ << 1.7976931348623157e308), string("1.7976931348623157e+308"));
+		CHECK_EQUAL(string(_ << 0.1f << ' ' << 16777216.f), string("0.1 16777216"));
+		bool ok = true;
+		t::uint64 bits = 0x123456789abcdefULL;
+		for(int i = 0; i < 10000 && ok; i++) {
+			bits = bits * 6364136223846793005ULL + 1442695040888963407ULL;
+			double x;
+			memcpy(&x, &bits, sizeof(x));
+			if(x != x)
+				continue;
+			char buf[float_chars_max + 1];
+			*toChars(buf, x) = '\0';
+			ok = strtod(buf, nullptr) == x;
+		}
+		CHECK(ok);
+	}
+
+	// text to number conversions
+	{
+		const char *s = "18446744073709551615 -9223372036854775808 0x1F 017 2.5e-3 1e 0.1";
+		const char *e = s + strlen(s);
+		t::uint64 u = 0;
+		t::int64 i = 0;
+		double x = 0;
+		s = fromChars(s, e, u);
+		CHECK(s != nullptr && u == 18446744073709551615ULL);
+		s = fromChars(s + 1, e, i);
+		CHECK(s != nullptr && i == -9223372036854775807LL - 1);
+		s = fromChars(s + 1, e, u, 0);
+		CHECK(s != nullptr && u == 0x1f);
+		s = fromChars(s + 1, e, u, 0);
+		CHECK(s != nullptr && u == 017);
+		s = fromChars(s + 1, e, x);
+		CHECK(s != nullptr && x == 2.5e-3);
+		s = fromChars(s + 1, e, x);
+		CHECK(s != nullptr && x == 1 && *s == 'e');
+		s = fromChars(s + 2, e, x);
+		CHECK(s == e && x == 0.1);
+		const char *o = "18446744073709551616";
+		CHECK(fromChars(o, o + strlen(o), u) == nullptr);
+		CHECK(fromChars(o, o, x) == nullptr);
+		bool ok = true;
+		t::uint64 bits = 0xfedcba987654321ULL;
+		for(int i = 0; i < 10000 && ok; i++) {
+			bits = bits * 6364136223846793005ULL + 1442695040888963407ULL;
+			double x, y;
+			memcpy(&x, &bits, sizeof(x));
+			if(x - x != 0)
+				continue;
+			char buf[float_chars_max];
+			char *p = toChars(buf, x);
+			ok = fromChars(buf, p, y) == p && memcmp(&x, &y, sizeof(x)) == 0;
+		}
+		CHECK(ok);
+	}
+
+	// compile-time format
+	{
+		StringBuffer buf;
+		ELM_FORMAT(buf, "{} at {:x}", "main", 0x1234);
+		CHECK_EQUAL(buf.toString(), string("main at 1234"));
+	}
+	{
+		StringBuffer buf;
+		ELM_FORMAT(buf, "{{{}}} {:08X} {:+d} {:b} {:o}", 1, 0xbeef, 5, 5, 8);
+		CHECK_EQUAL(buf.toString(), string("{1} 0000BEEF +5 101 10"));
+	}
+	{
+		StringBuffer buf;
+		ELM_FORMAT(buf, "[{:5}|{:<5}|{:^5}|{:*>5}]", 12, 12, 12, 12);
+		CHECK_EQUAL(buf.toString(), string("[   12|12   | 12  |***12]"));
+	}
+	{
+		StringBuffer buf;
+		ELM_FORMAT(buf, "[{:6}|{:>6}|{:^6.2}|{:-<3}]", string("abc"), cstring("abc"), "abcd", 'c');
+		CHECK_EQUAL(buf.toString(), string("[abc   |   abc|  ab  |c--]"));
+	}
+	{
+		StringBuffer buf;
+		ELM_FORMAT(buf, "{} {:.2f} {:e}", 1.5, 1.25, 1e10);
+		CHECK_EQUAL(buf.toString(), string("1.5 1.25 1.000000e+10"));
+	}
+	{
+		StringBuffer buf;
+		ELM_FORMAT(buf, "{} {} {}", true, t::uint8(255), t::int64(-1));
+		CHECK_EQUAL(buf.toString(), string("true 255 -1"));
+	}
+	{
+		StringBuffer buf;
+		ELM_FORMAT(buf, "[{:05}|{:+05}|{:05x}|{:x<5}|{:07.2f}|{:+}]", -3, 3, 255, -3, -1.25, t::int64(-9223372036854775807LL - 1));
+		CHECK_EQUAL(buf.toString(), string("[-0003|+0003|000ff|-3xxx|-001.25|-9223372036854775808]"));
+	}
+	{
+		StringBuffer buf;
+		ELM_FORMAT(buf, "{:x} {:X} {:d} {:b} {}", 5LL, 255ULL, -7L, 5UL, 18446744073709551615ULL);
+		CHECK_EQUAL(buf.toString(), string("5 FF -7 101 18446744073709551615"));
+	}
+	{
+		StringBuffer buf;
+		ELM_FORMAT(buf, "no argument}}");
+		CHECK_EQUAL(buf.toString(), string("no argument}"));
+	}
+
 	// BufferedInStream test
 	{
 		{
@@ -5,6 +5,8 @@
  * test_plugin.cpp -- test the plugin feature.
  */
 
+#include <chrono>
+#include <thread>
 #include <elm/sys/JobScheduler.h>
 #include "../include/elm/test.h"
 
@@ -52,10 +54,210 @@ private:
 	int l, u, i;
 };
 
+// fork/join Fibonacci
+class ForkFiboJob: public Job {
+public:
+	ForkFiboJob(int _n): n(_n), r(0) { }
+	virtual void run(void) {
+		if(n < 15)
+			r = fibo(n);
+		else {
+			ForkFiboJob j1(n - 1), j2(n - 2);
+			spawn(&j1);
+			spawn(&j2);
+			sync();
+			r = j1.r + j2.r;
+		}
+	}
+	int n;
+	int r;
+};
+
+// lot of small jobs
+class SmallJob: public Job {
+public:
+	virtual void run(void) { r = t::int64(i) * i; }
+	int i;
+	t::int64 r;
+};
+
+class SmallProducer: public JobProducer {
+public:
+	SmallProducer(int n): jobs(new SmallJob[n]), cnt(n), i(0), sum(0), harvested(0) { }
+	~SmallProducer(void) { delete [] jobs; }
+	virtual Job *next(void)
+		{ if(i >= cnt) return 0; jobs[i].i = i; return &jobs[i++]; }
+	virtual void harvest(Job *job)
+		{ sum += static_cast<SmallJob *>(job)->r; harvested++; }
+	SmallJob *jobs;
+	int cnt, i;
+	t::int64 sum;
+	int harvested;
+};
+
+// stopping producer: stops the scheduler or throws at the given harvest
+class StopProducer: public SmallProducer {
+public:
+	StopProducer(int n, int at, bool fail): SmallProducer(n), sched(nullptr), at(at), fail(fail) { }
+	virtual void harvest(Job *job) {
+		SmallProducer::harvest(job);
+		if(harvested == at) {
+			if(fail)
+				throw MessageException("harvest failed");
+			sched->stop();
+		}
+	}
+	JobScheduler *sched;
+	int at;
+	bool fail;
+};
+
+class ForkProducer: public JobProducer {
+public:
+	ForkProducer(int n): job(n), done(false), harvested(false) { }
+	virtual Job *next(void) { if(done) return 0; done = true; return &job; }
+	virtual void harvest(Job *j) { harvested = true; }
+	ForkFiboJob job;
+	bool done, harvested;
+};
+
+// long job: waits for the other workers to sleep
+class SleepJob: public Job {
+public:
+	SleepJob(void): sched(nullptr), idle(0) { }
+	virtual void run(void) {
+		for(int i = 0; i < 1000 && idle < sched->threadCount() - 1; i++) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			idle = sched->idleCount();
+		}
+	}
+	JobScheduler *sched;
+	int idle;
+};
+
+class SleepProducer: public JobProducer {
+public:
+	SleepProducer(void): done(false) { }
+	virtual Job *next(void) { if(done) return 0; done = true; return &job; }
+	SleepJob job;
+	bool done;
+};
+
+// failing job
+class FailJob: public SmallJob {
+public:
+	virtual void run(void) {
+		SmallJob::run();
+		if(i == 1000)
+			throw MessageException("job failed");
+	}
+};
+
+class FailProducer: public JobProducer {
+public:
+	FailProducer(int n): jobs(new FailJob[n]), cnt(n), i(0), harvested(0) { }
+	~FailProducer(void) { delete [] jobs; }
+	virtual Job *next(void)
+		{ if(i >= cnt) return 0; jobs[i].i = i; return &jobs[i++]; }
+	virtual void harvest(Job *job) { harvested++; }
+	FailJob *jobs;
+	int cnt, i, harvested;
+};
+
 // test routine
 TEST_BEGIN(jsched)
-	FiboProducer prod(10, 40);
-	JobScheduler sched(prod);
-	sched.start();
+
+	{
+		FiboProducer prod(10, 40);
+		JobScheduler sched(prod);
+		CHECK(sched.threadCount() >= 1);
+		sched.start();
+	}
+
+	// many small jobs, batched harvest and stealing
+	for(int n = 1; n <= 4; n++) {
+		const int N = 100000;
+		SmallProducer prod(N);
+		JobScheduler sched(prod);
+		sched.setThreadCount(n);
+		sched.start();
+		CHECK_EQUAL(prod.harvested, N);
+		t::int64 s = 0;
+		for(int i = 0; i < N; i++)
+			s += t::int64(i) * i;
+		CHECK_EQUAL(prod.sum, s);
+	}
+
+	// every fetched job is executed and harvested after a stop or an exception
+	for(int n = 1; n <= 4; n++)
+		for(int f = 0; f < 2; f++) {
+			StopProducer prod(100000, 1000, f == 1);
+			JobScheduler sched(prod);
+			prod.sched = &sched;
+			sched.setThreadCount(n);
+			if(f == 0)
+				sched.start();
+			else
+				CHECK_EXCEPTION(MessageException, sched.start());
+			CHECK(prod.i < prod.cnt);
+			CHECK_EQUAL(prod.harvested, prod.i);
+			t::int64 s = 0;
+			for(int i = 0; i < prod.i; i++)
+				s += t::int64(i) * i;
+			CHECK_EQUAL(prod.sum, s);
+		}
+
+	// fork/join
+	for(int n = 1; n <= 4; n++) {
+		ForkProducer prod(25);
+		JobScheduler sched(prod);
+		sched.setThreadCount(n);
+		sched.start();
+		CHECK(prod.harvested);
+		CHECK_EQUAL(prod.job.r, fibo(25));
+	}
+
+	// idle threads sleep while a long job runs
+	{
+		SleepProducer prod;
+		JobScheduler sched(prod);
+		prod.job.sched = &sched;
+		sched.setThreadCount(4);
+		sched.start();
+		CHECK_EQUAL(prod.job.idle, 3);
+		CHECK_EQUAL(sched.idleCount(), 0);
+	}
+
+	// a failing job stops the scheduler that remains usable
+	for(int n = 1; n <= 4; n++) {
+		FailProducer prod(100000);
+		JobScheduler sched(prod);
+		sched.setThreadCount(n);
+		CHECK_EXCEPTION(MessageException, sched.start());
+		CHECK(prod.i < prod.cnt);
+		CHECK_EQUAL(prod.harvested, prod.i);
+		SmallProducer prod2(1000);
+		sched.setProducer(prod2);
+		sched.start();
+		CHECK_EQUAL(prod2.harvested, 1000);
+	}
+
+	// jobs are copyable
+	{
+		SmallJob j1;
+		j1.i = 3;
+		SmallJob j2(j1), j3;
+		j3 = j1;
+		CHECK_EQUAL(j2.i, 3);
+		CHECK_EQUAL(j3.i, 3);
+	}
+
+	// fork/join outside a scheduler
+	{
+		ForkFiboJob job(20);
+		job.run();
+		CHECK_EQUAL(job.r, fibo(20));
+	}
+
 TEST_END
 
@@ -19,7 +19,11 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <elm/io/BlockInStream.h>
+#include <elm/io/BufferedInStream.h>
 #include <elm/json.h>
+#include <elm/string/StringBuffer.h>
+#include <elm/string/Symbol.h>
 #include "../include/elm/test.h"
 
 using namespace elm;
@@ -42,6 +46,7 @@ public:
 	double f;
 	string s;
 	Vector<int> iv;
+	Vector<Symbol> syms;
 
 	MyMaker(void): res(NONE), i(0), f(0) { }
 
@@ -55,6 +60,11 @@ public:
 		ASSERTP(name == "int" || name == "float" || name == "string", "got " << name);
 	}
 
+	virtual void onFieldSymbol(Symbol name) {
+		syms.add(name);
+		onField(name.toString());
+	}
+
 	virtual void onNull(void) { res = _NULL; }
 	virtual void onValue(bool value) { res = value ? TRUE : FALSE; }
 
@@ -88,6 +98,78 @@ public:
 	}
 };
 
+// maker logging the events
+class LogMaker: public json::Maker {
+public:
+	StringBuffer log;
+	void beginObject(void) override { log << '{'; }
+	void endObject(void) override { log << '}'; }
+	void beginArray(void) override { log << '['; }
+	void endArray(void) override { log << ']'; }
+	void onField(string name) override { log << name << ':'; }
+	void onNull(void) override { log << "N "; }
+	void onValue(bool value) override { log << (value ? "T " : "F "); }
+	void onValue(int value) override { log << 'i' << value << ' '; }
+	void onValue(double value) override { log << 'f' << value << ' '; }
+	void onValue(string value) override { log << '"' << value << "\" "; }
+};
+
+
+// maker recording the integers not fitting an int
+class LongMaker: public json::Maker {
+public:
+	t::int64 val = 0;
+	void onValue(t::int64 value) override { val = value; }
+};
+
+// stream whose writes always fail
+class FailOutStream: public io::OutStream {
+public:
+	int write(const char *buffer, int size) override { return -1; }
+	int flush(void) override { return -1; }
+};
+
+// stream without window (as pipes and sockets)
+class CharInStream: public io::InStream {
+public:
+	CharInStream(io::InStream& in): _in(in) { }
+	int read(void *buffer, int size) override { return _in.read(buffer, size); }
+	int read(void) override { return _in.read(); }
+private:
+	io::InStream& _in;
+};
+
+
+// hexadecimal dump of binary output
+static string hex(string s) {
+	static const char digits[] = "0123456789abcdef";
+	StringBuffer buf;
+	for(int i = 0; i < s.length(); i++)
+		buf << digits[t::uint8(s[i]) >> 4] << digits[s[i] & 0xf];
+	return buf.toString();
+}
+
+// write a sample value to a structured output
+static void sample(io::StructuredOutput& out) {
+	out.beginMap();
+	out.key("a");
+	out.beginList();
+	out.write(1);
+	out.write(-1000);
+	out.write(2.5);
+	out.write("x\ty");
+	out.write(true);
+	out.endList();
+	out.key("b");
+	out.beginMap();
+	out.endMap();
+	out.key("c");
+	out.write(100000);
+	out.endMap();
+}
+
+static const char *sample_json = "{\"a\": [1, -1000, 2.5, \"x\\ty\", true], \"b\": {}, \"c\": 100000}";
+
 TEST_BEGIN(json)
 
 	// empty object
@@ -148,6 +230,34 @@ TEST_BEGIN(json)
 		CHECK_EQUAL(r, string("{\"a\":[0,1,2,3]}"));
 	}
 
+	// string buffer up to date before close()
+	{
+		StringBuffer buf;
+		json::Saver save(buf);
+		save.beginMap();
+		save.key(cstring("l"));
+		save.beginList();
+		save.write("a string longer than sixteen characters\n");
+		save.write(12345678901LL);
+		save.endList();
+		save.endMap();
+		CHECK_EQUAL(buf.toString(), string("{\"l\":[\"a string longer than sixteen characters\\n\",12345678901]}"));
+	}
+
+	// output errors in the destructor
+	{
+		bool caught = false;
+		try {
+			FailOutStream out;
+			json::Saver save(out);
+			save.write(1);
+		}
+		catch(io::IOException& e) {
+			caught = true;
+		}
+		CHECK(!caught);
+	}
+
 	// parser test
 	{
 		MyMaker maker;
@@ -189,6 +299,409 @@ TEST_BEGIN(json)
 		CHECK_EQUAL(maker.res, MyMaker::_NULL);
 	}
 
+	// escapes and UTF-8 in strings
+	{
+		MyMaker maker;
+		json::Parser p(maker);
+		p.parse("'a\\tb\\n\\\"c\\\\'");
+		CHECK_EQUAL(maker.s, string("a\tb\n\"c\\"));
+		p.parse("'\\u00e9\\u20ac\\ud83d\\ude00'");
+		CHECK_EQUAL(maker.s, string("\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80"));
+		p.parse("'\xc3\xa9t\xc3\xa9'");
+		CHECK_EQUAL(maker.s, string("\xc3\xa9t\xc3\xa9"));
+		bool failed = false;
+		try {
+			p.parse("'\xc3('");
+		}
+		catch(json::Exception& e) {
+			failed = true;
+		}
+		CHECK(failed);
+	}
+
+	// escaped output of non-ASCII characters
+	{
+		StringBuffer buf;
+		json::Saver save(buf);
+		save.beginObject();
+		save.addField("s");
+		save.put(string("a\"\xc3\xa9\xf0\x9f\x98\x80\n"));
+		save.endObject();
+		save.close();
+		CHECK_EQUAL(buf.toString(), string("{\"s\":\"a\\\"\\u00e9\\ud83d\\ude00\\n\"}"));
+	}
+
+	// long strings and readable output through a small buffer
+	{
+		StringBuffer in, out;
+		for(int i = 0; i < 20; i++) {
+			in << "0123456789abcdef\t\x01\\";
+			out << "0123456789abcdef\\t\\u0001\\\\";
+		}
+		string s = in.toString();
+		StringBuffer buf;
+		json::Saver save(buf, 1);
+		save.setReadable(true);
+		save.beginMap();
+		save.key(cstring("s"));
+		save.write(s);
+		save.key(cstring("l"));
+		save.beginList();
+		save.write(-12345678901LL);
+		save.write(0.1);
+		save.endList();
+		save.endMap();
+		save.close();
+		CHECK_EQUAL(buf.toString(), string(_ << "\n{\n\"s\": \"" << out.toString()
+			<< "\",\n\"l\": [\n\t-12345678901,\n\t0.1\n]\n}"));
+	}
+
+	// parsing in a stream window
+	{
+		cstring text =
+			"{\"name\": \"a long string crossing the buffer\", // comment\n"
+			"\"list\": [1, -2.5e-3, 12345678901, null, true, false, 0x10],\n"
+			"\"esc\": \"x\\ty\\u00e9\", \"empty\": {}}";
+		cstring expected =
+			"{name:\"a long string crossing the buffer\" "
+			"list:[i1 f-0.0025 f12345678901 N T F i16 ]"
+			"esc:\"x\ty\xc3\xa9\" empty:{}}";
+		LogMaker m1;
+		json::Parser p1(m1);
+		p1.parse(text);
+		CHECK_EQUAL(m1.log.toString(), string(expected));
+		LogMaker m2;
+		json::Parser p2(m2);
+		io::BlockInStream block(text);
+		io::BufferedInStream buf(block, 5);
+		p2.parse(buf);
+		CHECK_EQUAL(m2.log.toString(), string(expected));
+	}
+
+	// concatenated values in a stream without window
+	{
+		io::BlockInStream block("{\"a\": 1}[2, \"b\"]\n{\"c\": {}} 'd'");
+		CharInStream in(block);
+		LogMaker m;
+		json::Parser p(m);
+		for(int i = 0; i < 4; i++)
+			p.parse(in);
+		CHECK_EQUAL(m.log.toString(), string("{a:i1 }[i2 \"b\" ]{c:{}}\"d\" "));
+		io::BlockInStream block2("[1] [2]");
+		CharInStream in2(block2);
+		LogMaker m2;
+		json::Parser p2(m2);
+		p2.setReadAhead(true);
+		p2.parse(in2);
+		CHECK_EQUAL(m2.log.toString(), string("[i1 ]"));
+		CHECK_EQUAL(in2.read(), int(io::InStream::ENDED));
+	}
+
+	// parsing errors
+	{
+		LogMaker m;
+		json::Parser p(m);
+		string msg;
+		try {
+			p.parse("[1,\n 2,\n \"abc");
+		}
+		catch(json::Exception& e) {
+			msg = e.message();
+		}
+		CHECK_EQUAL(msg, string("3:5: unterminated string"));
+		msg = "";
+		try {
+			p.parse("[1, 2");
+		}
+		catch(json::Exception& e) {
+			msg = e.message();
+		}
+		CHECK(msg != "");
+	}
+
+	// structural engine
+	{
+		string text =
+			"{\"a\": [1, 2.5, \"x\\\\\", \"q\\\"\\\\\\\"\", true, null],\n"
+			" \"long\": \"0123456789012345678901234567890123456789012345678901234567890123456789\","
+			" \"o\": {\"k\": -3, \"l\": \"\\u00e9\\\\\"}, \"z\": false}";
+		LogMaker m1, m2;
+		json::Parser p1(m1), p2(m2);
+		p1.setEngine(json::Parser::CLASSIC);
+		p1.parse(text);
+		p2.setEngine(json::Parser::STRUCTURAL);
+		p2.parse(text);
+		CHECK_EQUAL(m2.log.toString(), m1.log.toString());
+
+		// the classic engine takes over at the first extension
+		LogMaker m3;
+		json::Parser p3(m3);
+		p3.setEngine(json::Parser::STRUCTURAL);
+		p3.parse("{\"a\": [1, \"b\"], // comment\n 'c': 'd'}");
+		CHECK_EQUAL(m3.log.toString(), string("{a:[i1 \"b\" ]c:\"d\" }"));
+
+		LogMaker m4;
+		json::Parser p4(m4);
+		p4.setEngine(json::Parser::STRUCTURAL);
+		string msg;
+		try {
+			p4.parse("[1,\n 2,\n 3x]");
+		}
+		catch(json::Exception& e) {
+			msg = e.message();
+		}
+		CHECK_EQUAL(msg.substring(0, 2), string("3:"));
+
+		// both engines reject the same junk after a scalar
+		cstring texts[] = { "truex", "null#", "1#", "[1#]", "1 x", "true]", "[false]" };
+		bool same = true;
+		for(auto t: texts) {
+			bool ok[2];
+			for(int i = 0; i < 2; i++) {
+				LogMaker m;
+				json::Parser p(m);
+				p.setEngine(i == 0 ? json::Parser::CLASSIC : json::Parser::STRUCTURAL);
+				try {
+					p.parse(t);
+					ok[i] = true;
+				}
+				catch(json::Exception& e) {
+					ok[i] = false;
+				}
+			}
+			same = same && ok[0] == ok[1];
+		}
+		CHECK(same);
+		LogMaker m5;
+		json::Parser p5(m5);
+		CHECK_EQUAL(p5.engine(), json::Parser::AUTO);
+		bool failed = false;
+		try {
+			p5.parse("truex");
+		}
+		catch(json::Exception& e) {
+			failed = true;
+		}
+		CHECK(failed);
+	}
+
+	// interned field names
+	{
+		MyMaker maker;
+		json::Parser p(maker);
+		p.parse("{'int':1}");
+		CHECK_EQUAL(maker.syms.length(), 0);
+		p.setInterning(true);
+		CHECK(p.interns());
+		p.parse("{'int':1,'string':'a'}");
+		p.parse("{'int':2}");
+		CHECK_EQUAL(maker.syms.length(), 3);
+		CHECK(maker.syms[0] == Symbol("int"));
+		CHECK(maker.syms[1] == Symbol("string"));
+		CHECK(maker.syms[0] == maker.syms[2]);
+	}
+
+	// document
+	{
+		json::Document doc;
+		doc.parse("{\"a\": [1, 2.5, \"x\\ty\", null, true], \"b\": {\"c\": {}}, \"d\": false}");
+		const json::Value& r = doc.root();
+		CHECK(r.isObject());
+		CHECK_EQUAL(r.count(), 3);
+		CHECK_EQUAL(r.key(1), cstring("b"));
+		CHECK_EQUAL(r["a"].count(), 5);
+		CHECK_EQUAL(r["a"][0].asInt(), t::int64(1));
+		CHECK_EQUAL(r["a"][1].asFloat(), 2.5);
+		CHECK_EQUAL(r["a"][2].asString(), cstring("x\ty"));
+		CHECK(r["a"][3].isNull());
+		CHECK(r["a"][4].asBool());
+		CHECK(r["b"]["c"].isObject());
+		CHECK_EQUAL(r["b"]["c"].count(), 0);
+		CHECK(!r["d"].asBool());
+		CHECK(r["missing"]["deeper"].isNull());
+		CHECK(!r.contains("missing"));
+
+		// 64-bit integers, eager and lazy
+		for(int lazy = 0; lazy < 2; lazy++) {
+			json::Document d;
+			d.setLazy(lazy);
+			d.parse("[1700000000123456789, -9007199254740993, 18446744073709551615]");
+			CHECK(d.root()[0].isInt());
+			CHECK_EQUAL(d.root()[0].asInt(), t::int64(1700000000123456789LL));
+			CHECK_EQUAL(d.root()[1].asInt(), t::int64(-9007199254740993LL));
+			CHECK(d.root()[2].isFloat());
+		}
+		{
+			StringBuffer cbuf;
+			json::CBORSaver save(cbuf);
+			save.write(9007199254740993LL);
+			save.close();
+			LongMaker m;
+			json::CBORParser p(m);
+			p.parse(cbuf.toString());
+			CHECK_EQUAL(m.val, t::int64(9007199254740993LL));
+		}
+
+		// big objects and arrays (bigger than the arena chunks)
+		json::Document big(256);
+		StringBuffer buf;
+		buf << "{";
+		for(int i = 0; i < 100; i++)
+			buf << (i ? ", " : "") << "\"f" << i << "\": [" << i << ", " << i * 2 << "]";
+		buf << ", \"f7\": 0}";
+		string text = buf.toString();
+		big.parse(text);
+		CHECK_EQUAL(big.root().count(), 101);
+		CHECK_EQUAL(big.root()["f42"][1].asInt(), t::int64(84));
+		CHECK_EQUAL(big.root()["f7"][0].asInt(), t::int64(7));
+		CHECK(!big.root().contains("f100"));
+
+		// lazy mode
+		big.setLazy(true);
+		big.parse(text);
+		CHECK_EQUAL(big.root()["f99"][1].asInt(), t::int64(198));
+		CHECK_EQUAL(big.root().key(3), cstring("f3"));
+		big.parse("[1, [2, {\"x\": 'y'}], // comment\n [3, }]");
+		CHECK_EQUAL(big.root().count(), 3);
+		CHECK_EQUAL(big.root()[1][1]["x"].asString(), cstring("y"));
+		string msg;
+		try {
+			big.root()[2].count();
+		}
+		catch(json::Exception& e) {
+			msg = e.message();
+		}
+		CHECK_EQUAL(msg, string("2:6: unexpected symbol"));
+		big.clear();
+		CHECK(big.root().isNull());
+	}
+
+	// CBOR
+	{
+		struct {
+			long long x;
+			const char *r;
+		} ints[] = {
+			{ 0, "00" }, { 23, "17" }, { 24, "1818" }, { 100, "1864" },
+			{ 1000, "1903e8" }, { 1000000, "1a000f4240" },
+			{ 1000000000000LL, "1b000000e8d4a51000" },
+			{ -1, "20" }, { -100, "3863" }, { -1000, "3903e7" }
+		};
+		for(auto i: ints) {
+			StringBuffer buf;
+			json::CBORSaver save(buf);
+			save.write(i.x);
+			save.close();
+			CHECK_EQUAL(hex(buf.toString()), string(i.r));
+		}
+
+		StringBuffer buf1;
+		json::CBORSaver save1(buf1);
+		save1.beginList();
+		save1.write(1.5);
+		save1.write(1.1);
+		save1.write("IETF");
+		save1.put();
+		save1.write(false);
+		save1.endList();
+		save1.close();
+		CHECK_EQUAL(hex(buf1.toString()), string("9ffa3fc00000fb3ff199999999999a6449455446f6f4ff"));
+
+		// definite lengths, half float and tags are read too
+		LogMaker m2;
+		json::CBORParser p2(m2);
+		p2.parse(string("\xa2\x61\x61\x01\x61\x62\x82\xf9\x3c\x00\xc1\x1a\x51\x4b\x67\xb0", 16));
+		CHECK_EQUAL(m2.log.toString(), string("{a:i1 b:[f1 i1363896240 ]}"));
+
+		// round trip
+		StringBuffer buf3;
+		json::CBORSaver save3(buf3);
+		sample(save3);
+		save3.close();
+		string data = buf3.toString();
+		LogMaker m3, m4, m5;
+		json::CBORParser p3(m3);
+		p3.parse(data);
+		json::Parser p4(m4);
+		p4.parse(sample_json);
+		CHECK_EQUAL(m3.log.toString(), m4.log.toString());
+		io::BlockInStream in(data);
+		io::BufferedInStream bin(in, 5);
+		json::CBORParser p5(m5);
+		p5.parse(bin);
+		CHECK_EQUAL(m5.log.toString(), string("{a:[i1 i-1000 f2.5 \"x\ty\" T ]b:{}c:i100000 }"));
+
+		// errors
+		LogMaker m6;
+		json::CBORParser p6(m6);
+		CHECK_EXCEPTION(json::Exception, p6.parse(string("\x82\x01", 2)));
+		CHECK_EXCEPTION(json::Exception, p6.parse(string("\xa1\x01\x02", 3)));
+		CHECK_EXCEPTION(json::Exception, p6.parse(string("\x62\xc3\x28", 3)));
+	}
+
+	// MessagePack
+	{
+		struct {
+			long long x;
+			const char *r;
+		} ints[] = {
+			{ 0, "00" }, { 127, "7f" }, { 128, "cc80" }, { 256, "cd0100" },
+			{ 70000, "ce00011170" }, { 5000000000LL, "cf000000012a05f200" },
+			{ -1, "ff" }, { -32, "e0" }, { -33, "d0df" }, { -1000, "d1fc18" },
+			{ -70000, "d2fffeee90" }
+		};
+		for(auto i: ints) {
+			StringBuffer buf;
+			json::MessagePackSaver save(buf);
+			save.write(i.x);
+			save.close();
+			CHECK_EQUAL(hex(buf.toString()), string(i.r));
+		}
+
+		StringBuffer buf1;
+		json::MessagePackSaver save1(buf1);
+		sample(save1);
+		save1.close();
+		string data = buf1.toString();
+		CHECK_EQUAL(hex(data), string("83a16195"
+			"01d1fc18ca40200000a3780979c3a162"
+			"80a163ce000186a0"));
+
+		// long containers and strings
+		StringBuffer buf2;
+		json::MessagePackSaver save2(buf2);
+		save2.beginList();
+		for(int i = 0; i < 20; i++)
+			save2.write(i);
+		save2.write("0123456789012345678901234567890123456789");
+		save2.endList();
+		save2.close();
+		string data2 = buf2.toString();
+		CHECK_EQUAL(hex(data2.substring(0, 4)), string("dc0015" "00"));
+		CHECK_EQUAL(hex(data2.substring(23, 3)), string("d92830"));
+
+		// round trip
+		LogMaker m3, m4, m5;
+		json::MessagePackParser p3(m3);
+		p3.parse(data);
+		json::Parser p4(m4);
+		p4.parse(sample_json);
+		CHECK_EQUAL(m3.log.toString(), m4.log.toString());
+		io::BlockInStream in(data2);
+		io::BufferedInStream bin(in, 5);
+		json::MessagePackParser p5(m5);
+		p5.parse(bin);
+		CHECK_EQUAL(m5.log.toString(), string("[i0 i1 i2 i3 i4 i5 i6 i7 i8 i9 i10 i11 i12 i13 i14 i15 i16 i17 i18 i19 "
+			"\"0123456789012345678901234567890123456789\" ]"));
+
+		// errors
+		LogMaker m6;
+		json::MessagePackParser p6(m6);
+		CHECK_EXCEPTION(json::Exception, p6.parse(string("\x92\x01", 2)));
+		CHECK_EXCEPTION(json::Exception, p6.parse(string("\x81\x01\x02", 3)));
+		CHECK_EXCEPTION(json::Exception, p6.parse(string("\xc1", 1)));
+	}
+
 TEST_END
 
 
@@ -0,0 +1,132 @@
+/*
+ *	parallel iteration test
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#include <elm/data/FragTable.h>
+#include <elm/data/HashMap.h>
+#include <elm/data/Vector.h>
+#include <elm/sys/parallel.h>
+#include <elm/util/MessageException.h>
+#include <elm/test.h>
+#include <atomic>
+
+using namespace elm;
+
+TEST_BEGIN(parallel)
+
+	const int N = 100000;
+	Vector<int> v;
+	for(int i = 0; i < N; i++)
+		v.add(i);
+
+	// forEach
+	for(int n = 1; n <= 4; n++) {
+		std::atomic<t::int64> s(0);
+		parallel::forEach(v, [&s](int x) { s += x; }, 0, n);
+		CHECK_EQUAL(t::int64(s), t::int64(N) * (N - 1) / 2);
+	}
+
+	// map
+	{
+		Vector<t::int64> r = parallel::map(v, [](int x) { return t::int64(x) * x; }, 1000, 4);
+		CHECK_EQUAL(r.length(), N);
+		bool ok = true;
+		for(int i = 0; i < N; i++)
+			if(r[i] != t::int64(i) * i)
+				ok = false;
+		CHECK(ok);
+		CHECK_EQUAL(parallel::map(Vector<int>(), [](int x) { return x; }).length(), 0);
+	}
+
+	// reduce
+	{
+		CHECK_EQUAL(parallel::reduce(v, 0, [](int a, int x) { return a ^ x; }), 0);
+		t::int64 s = parallel::fold(v, t::int64(0),
+			[](t::int64 a, int x) { return a + x; },
+			[](t::int64 a, t::int64 b) { return a + b; }, 7, 3);
+		CHECK_EQUAL(s, t::int64(N) * (N - 1) / 2);
+	}
+
+	// identity of the same type as the items with an explicit grain
+	{
+		Vector<int> w;
+		for(int i = 0; i < 1000; i++)
+			w.add(1);
+		CHECK_EQUAL(parallel::reduce(w, 0, [](int a, int x) { return a + x; }, 10), 1000);
+	}
+
+	// nested calls are executed sequentially
+	{
+		std::atomic<t::int64> s(0);
+		parallel::forEach(v, [&s, &v](int x) {
+			if(x % 10000 == 0)
+				s += parallel::reduce(v, t::int64(0), [](t::int64 a, int y) { return a + y; }, 1000);
+		}, 100);
+		CHECK_EQUAL(t::int64(s), 10 * (t::int64(N) * (N - 1) / 2));
+	}
+
+	// many small calls reuse the same threads
+	{
+		bool ok = true;
+		for(int i = 0; i < 1000; i++)
+			if(parallel::reduce(v, t::int64(0), [](t::int64 a, int y) { return a + y; }, 10000)
+			!= t::int64(N) * (N - 1) / 2)
+				ok = false;
+		CHECK(ok);
+	}
+
+	// an exception raised by f is thrown back and the next call works
+	for(int n = 1; n <= 4; n++) {
+		bool caught = false;
+		try {
+			parallel::forEach(v, [](int x) { if(x == 5000) throw MessageException("failed"); }, 100, n);
+		}
+		catch(MessageException& e) {
+			caught = e.message() == "failed";
+		}
+		CHECK(caught);
+		CHECK_EQUAL(parallel::reduce(v, t::int64(0), [](t::int64 a, int y) { return a + y; }, 100, n),
+			t::int64(N) * (N - 1) / 2);
+	}
+
+	// deterministic reduction
+	{
+		Vector<double> d;
+		for(int i = 1; i <= N; i++)
+			d.add(1. / i);
+		auto add = [](double a, double x) { return a + x; };
+		double r1 = parallel::reduce(d, 0., add, 100, 1);
+		double r4 = parallel::reduce(d, 0., add, 100, 4);
+		CHECK(r1 == r4);
+	}
+
+	// other collections
+	{
+		FragTable<int> f;
+		for(int i = 0; i < N; i++)
+			f.add(i);
+		CHECK_EQUAL(parallel::fold(f, t::int64(0), [](t::int64 a, int x) { return a + x; },
+			[](t::int64 a, t::int64 b) { return a + b; }), t::int64(N) * (N - 1) / 2);
+		HashMap<int, int> m;
+		for(int i = 0; i < 1000; i++)
+			m.put(i, 2 * i);
+		CHECK_EQUAL(parallel::reduce(m, 0, [](int a, int x) { return a + x; }, 10, 4), 999 * 1000);
+	}
+
+TEST_END
@@ -22,6 +22,7 @@
 #include <elm/util/SharedPtr.h>
 #include <elm/test.h>
 #include <elm/sys/System.h>
+#include <elm/sys/Thread.h>
 #include <elm/data/Vector.h>
 
 using namespace elm;
@@ -60,6 +61,20 @@ SharedPtr<R> make(void) {
 	return new R;
 }
 
+class Copier: public sys::Runnable {
+public:
+	Copier(const AtomicSharedPtr<C>& p): _p(p) { }
+	void run() override {
+		for(int i = 0; i < 100000; i++) {
+			AtomicSharedPtr<C> q = _p;
+			AtomicSharedPtr<C> r;
+			r = q;
+		}
+	}
+private:
+	AtomicSharedPtr<C> _p;
+};
+
 TEST_BEGIN(ptr)
 
 	// simple shared
@@ -107,6 +122,31 @@ TEST_BEGIN(ptr)
 		CHECK(del == true);
 	}
 
+	// atomic shared pointer copied by several threads
+	{
+		del = false;
+		{
+			AtomicSharedPtr<C> p = new C(111);
+			Vector<Copier *> copiers;
+			Vector<sys::Thread *> threads;
+			for(int i = 0; i < 4; i++) {
+				copiers.add(new Copier(p));
+				threads.add(sys::Thread::make(*copiers[i]));
+			}
+			for(auto th: threads)
+				th->start();
+			for(auto th: threads)
+				th->join();
+			for(int i = 0; i < 4; i++) {
+				delete threads[i];
+				delete copiers[i];
+			}
+			CHECK(del == false);
+			CHECK(p->x == 111);
+		}
+		CHECK(del == true);
+	}
+
 	// parameter passing
 	{
 		cerr << "1\n";
@@ -0,0 +1,92 @@
+/*
+ *	Rope class test
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#include <elm/io/BlockOutStream.h>
+#include <elm/string/Rope.h>
+#include <elm/string/StringBuffer.h>
+#include <elm/test.h>
+
+using namespace elm;
+
+TEST_BEGIN(rope)
+
+	// empty rope
+	{
+		Rope r;
+		CHECK(r.isEmpty());
+		CHECK(!r);
+		CHECK_EQUAL(r.length(), 0);
+		CHECK_EQUAL(r.toString(), string(""));
+		CHECK(Rope("").isEmpty());
+	}
+
+	// simple concatenation
+	{
+		Rope r = Rope("ok") + "/" + string("ko");
+		CHECK_EQUAL(r.length(), 5);
+		CHECK_EQUAL(r.toString(), string("ok/ko"));
+		CHECK_EQUAL(r[3], 'k');
+		CHECK_EQUAL(r.substring(1, 3).toString(), string("k/k"));
+	}
+
+	// big rope built from many fragments
+	{
+		Rope r;
+		string s;
+		for(int i = 0; i < 2000; i++) {
+			string f = _ << "fragment " << i << " with enough characters to stay a single leaf\n";
+			r += f;
+			s = s + f;
+			if(i % 7 == 0) {
+				r = Rope("<") + r;
+				s = "<" + s;
+			}
+		}
+		CHECK_EQUAL(r.length(), s.length());
+		CHECK_EQUAL(r.toString(), s);
+		bool ok = true;
+		for(int i = 0; i < s.length(); i += 97)
+			ok &= r[i] == s[i];
+		CHECK(ok);
+		CHECK_EQUAL(r.substring(1234, 5678).toString(), s.substring(1234, 5678));
+		CHECK_EQUAL(r.substring(s.length() - 10).toString(), s.substring(s.length() - 10));
+
+		// sharing: r is unchanged by building from it
+		Rope r2 = r.substring(10, 100) + r;
+		CHECK_EQUAL(r2.length(), 100 + s.length());
+		CHECK_EQUAL(r.toString(), s);
+
+		// output without flattening
+		io::BlockOutStream out;
+		r.write(out);
+		CHECK_EQUAL(out.size(), s.length());
+		CHECK(!memcmp(out.block(), s.chars(), s.length()));
+		StringBuffer pbuf;
+		pbuf << r;
+		CHECK_EQUAL(pbuf.toString(), s);
+
+		// fragment iteration
+		int len = 0;
+		for(auto f: r)
+			len += f.length();
+		CHECK_EQUAL(len, s.length());
+	}
+
+TEST_END
@@ -223,6 +223,17 @@ TEST_BEGIN(rtti)
 		string s2 = "ko";
 		Variant v4(s2);
 		CHECK_EQUAL(v4.as<string>(), s2);
+		Variant v5(string(_ << "k" << "o"));
+		Variant v6(v5), v7;
+		v7 = v6;
+		v5 = Variant(0);
+		CHECK_EQUAL(v6.as<string>(), s2);
+		CHECK_EQUAL(v7.as<string>(), s2);
+		Vector<Variant> vs;
+		for(int i = 0; i < 100; i++)
+			vs.add(Variant(string(_ << "v" << i)));
+		CHECK_EQUAL(vs[0].as<string>(), string("v0"));
+		CHECK_EQUAL(vs[99].as<string>(), string("v99"));
 
 		AClass anobj;
 		AClass& ranobj = anobj;
@@ -1,3 +1,4 @@
+#include <string.h>
 #include <elm/alloc/StackAllocator.h>
 #include <elm/sys/System.h>
 #include "../include/elm/test.h"
@@ -32,4 +33,18 @@ TEST_BEGIN(stack_alloc)
 	}
 	CHECK_MSG("long run", success);
 
+	// blocks bigger than the chunks
+	{
+		StackAllocator small(64);
+		char *a = static_cast<char *>(small.allocate(16));
+		StackAllocator::mark_t m = small.mark();
+		char *b = static_cast<char *>(small.allocate(1000));
+		memset(b, 'x', 1000);
+		char *c = static_cast<char *>(small.allocate(16));
+		CHECK(c + 16 <= b || b + 1000 <= c);
+		CHECK(a + 16 <= b || b + 1000 <= a);
+		small.release(m);
+		CHECK(small.mark() == m);
+	}
+
 TEST_END
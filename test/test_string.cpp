@@ -5,6 +5,7 @@
  * test/test_string.cpp -- unit tests for String class.
  */
 
+#include <elm/data/Vector.h>
 #include <elm/io/BlockInStream.h>
 #include "../include/elm/test.h"
 
@@ -318,6 +319,25 @@ TEST_BEGIN(string)
 		CHECK(s.lastIndexOf(l) == 5);
 		CHECK(s.lastIndexOf("bof") < 0);
 	}
+	{
+		// long enough to cover the vectorized paths and their tails
+		string s = _ << "abc" << string::make("-", 70) << "abc" << string::make("-", 5) << "ab";
+		CHECK_EQUAL(s.indexOf("abc"), 0);
+		CHECK_EQUAL(s.indexOf("abc", 1), 73);
+		CHECK_EQUAL(s.indexOf("abc", 74), -1);
+		CHECK_EQUAL(s.lastIndexOf("abc"), 73);
+		CHECK_EQUAL(s.lastIndexOf("abc", 73), 0);
+		CHECK_EQUAL(s.lastIndexOf("ab"), 81);
+		CHECK_EQUAL(s.indexOf('c', 3), 75);
+		CHECK_EQUAL(s.lastIndexOf('c'), 75);
+		CHECK_EQUAL(s.lastIndexOf('c', 75), 2);
+		CHECK_EQUAL(s.indexOf(chars::Set("cb"), 3), 74);
+		CHECK_EQUAL(s.indexOf(chars::Set("xyz")), -1);
+		CHECK_EQUAL(s.indexOf(chars::Set("0123456789xyzb")), 1);
+		CHECK_EQUAL(s.indexOf(chars::Set("0123456789xyzb"), 2), 74);
+		string t = s.substring(3, 40) + "|";
+		CHECK_EQUAL(t.indexOf(chars::Set("|;:")), 40);
+	}
 	
 	// simple StringInput
 	{
@@ -351,6 +371,72 @@ TEST_BEGIN(string)
 		CHECK_EQUAL(s, string("34"));
 	}
 
+	// small and long strings
+	{
+		string s = "01234", l = "0123456789abcdefghijklmnopqrstuvwxyz", c = s;
+		CHECK(c.chars() != s.chars());
+		CHECK_EQUAL(string(l).chars(), l.chars());
+		CHECK_EQUAL(l.substring(4).chars(), l.chars() + 4);
+		CHECK_EQUAL(l.substring(2, 3), string("234"));
+		CHECK_EQUAL(l.substring(4).toCString(), cstring("456789abcdefghijklmnopqrstuvwxyz"));
+		CHECK_EQUAL(cstring(l.substring(0, 20).toCString()), cstring("0123456789abcdefghij"));
+		CHECK_EQUAL(l, string("0123456789abcdefghijklmnopqrstuvwxyz"));
+		CHECK_EQUAL(s + s, string("0123401234"));
+	}
+
+	// relocation in a growing vector: the characters of small strings
+	// move with the String object, those of long strings stay in place
+	{
+		Vector<string> v;
+		v.add("small");
+		v.add("a string long enough to be shared");
+		const char *lp = v[1].chars();
+		for(int i = 0; i < 1000; i++)
+			v.add(_ << "s" << i);
+		CHECK(v[0].chars() >= (const char *)&v[0] && v[0].chars() < (const char *)(&v[0] + 1));
+		CHECK_EQUAL(v[1].chars(), lp);
+		Vector<cstring> cs;
+		for(const auto& x: v)
+			cs.add(x.toCString());
+		bool ok = true;
+		for(int i = 0; i < 1000; i++)
+			ok = ok && string(cs[i + 2]) == string(_ << "s" << i) && cs[i + 2].chars() == v[i + 2].chars();
+		CHECK(ok);
+		CHECK_EQUAL(cs[0], cstring("small"));
+		CHECK_EQUAL(cs[1], cstring("a string long enough to be shared"));
+	}
+
+	// strings longer than 64 KiB
+	{
+		const int n = 200000;
+		char *buf = new char[n];
+		for(int i = 0; i < n; i++)
+			buf[i] = 'a' + i % 26;
+		string s(buf, n);
+		CHECK_EQUAL(s.length(), n);
+		CHECK_EQUAL(s[n - 1], buf[n - 1]);
+		string sub = s.substring(100000);
+		CHECK_EQUAL(sub.length(), n - 100000);
+		CHECK_EQUAL(sub.chars(), s.chars() + 100000);
+		CHECK_EQUAL(sub[0], buf[100000]);
+		CHECK_EQUAL((s + s).length(), 2 * n);
+		StringBuffer sb;
+		sb << s << s;
+		CHECK_EQUAL(sb.toString().length(), 2 * n);
+		delete [] buf;
+	}
+
+	// many copies of the same string
+	{
+		const int n = 70000;
+		string s = "a string long enough to be shared";
+		string *copies = new string[n];
+		for(int i = 0; i < n; i++)
+			copies[i] = s;
+		delete [] copies;
+		CHECK_EQUAL(s, string("a string long enough to be shared"));
+	}
+
 	// trim test
 	{
 		string s = "  123  ", e = "   ", t = "  1 2 3  ";
@@ -417,6 +503,28 @@ TEST_BEGIN(string)
 		CHECK(sp.ended());
 	}
 
+	{
+		string s = "a=1, b 2;c";
+		StringSplit sp(s, chars::Set("=, ;"));
+		CHECK_EQUAL(*sp, string("a"));
+		sp.next();
+		CHECK_EQUAL(*sp, string("1"));
+		sp.next();
+		CHECK_EQUAL(*sp, string(""));
+		sp.next();
+		CHECK_EQUAL(*sp, string("b"));
+		StringSplit cp = sp++;
+		CHECK_EQUAL(*cp, string("b"));
+		CHECK_EQUAL(*sp, string("2"));
+		cp = sp;
+		sp.next();
+		CHECK_EQUAL(*sp, string("c"));
+		sp.next();
+		CHECK(sp.ended());
+		cp.next();
+		CHECK_EQUAL(*cp, string("c"));
+	}
+
 	{
 		string s = "01234567";
 		char i = '0';
@@ -5,6 +5,7 @@
  * test_string_buffer.cpp -- unit tests for StringBuffer..
  */
 
+#include "../include/elm/alloc/StackAllocator.h"
 #include "../include/elm/test.h"
 
 using namespace elm;
@@ -60,6 +61,46 @@ TEST_BEGIN(string_buffer)
 		CHECK_EQUAL(r, string("a,b,c"));
 	}
 
+	// big string
+	{
+		StringBuffer buf;
+		buf.reserve(20000);
+		for(int i = 0; i < 2000; i++)
+			buf << "0123456789";
+		CHECK_EQUAL(buf.length(), 20000);
+		String s = buf.toString();
+		CHECK_EQUAL(s.length(), 20000);
+		CHECK(s.startsWith("0123456789") && s.endsWith("0123456789"));
+	}
+
+	// strings allocated in an arena
+	{
+		StackAllocator arena;
+		StackAllocator::mark_t m = arena.mark();
+		StringBuffer buf;
+		String s1, s2, s3;
+		{
+			buf << "first string long enough for the arena " << 1;
+			s1 = buf.toString(arena);
+			buf << "ok";
+			s2 = buf.toString(arena);
+			buf << "second string long enough for the arena " << 2;
+			s3 = buf.toString(arena);
+		}
+		CHECK_EQUAL(s1, string("first string long enough for the arena 1"));
+		CHECK_EQUAL(s2, string("ok"));
+		CHECK_EQUAL(s3, string("second string long enough for the arena 2"));
+		CHECK_EQUAL(buf.length(), 0);
+		String s4 = s3.substring(7, 30);
+		CHECK_EQUAL(s4, string("string long enough for the are"));
+		CHECK_EQUAL(cstring(s4.toCString()), cstring("string long enough for the are"));
+		CHECK_EQUAL(s3, string("second string long enough for the arena 2"));
+		String s5("a third string built in the arena", 33, arena);
+		CHECK_EQUAL(s5, string("a third string built in the arena"));
+		s1 = s2 = s3 = s4 = s5 = "";
+		arena.release(m);
+	}
+
 TEST_END
 
 
@@ -0,0 +1,126 @@
+/*
+ *	Symbol class test
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#include <elm/data/HashMap.h>
+#include <elm/data/Vector.h>
+#include <elm/string/Symbol.h>
+#include <elm/sys/Thread.h>
+#include <elm/test.h>
+
+using namespace elm;
+
+class Interner: public sys::Runnable {
+public:
+	Interner(SymbolTable& table): failed(false), t(table) { }
+	Vector<Symbol> syms;
+	bool failed;
+	void run(void) override {
+		for(int i = 0; i < 500; i++)
+			syms.add(t.intern(_ << "s" << i));
+		Symbol l = t.intern(cstring("a-long-shared-symbol-name"));
+		for(int i = 0; i < 100000; i++) {
+			string c = l.toString();
+			if(c.length() != 25)
+				failed = true;
+		}
+	}
+private:
+	SymbolTable& t;
+};
+
+TEST_BEGIN(symbol)
+
+	// null symbol
+	{
+		Symbol s;
+		CHECK(s.isEmpty());
+		CHECK(!s);
+		CHECK(s.toString() == "");
+		CHECK(s == Symbol(""));
+		CHECK(s == Symbol(string()));
+		SymbolTable t;
+		CHECK(t.intern(cstring("")) == s);
+		CHECK_EQUAL(t.count(), 0);
+		CHECK(t.lookup(cstring("")).some());
+		CHECK(*t.lookup(cstring("")) == s);
+	}
+
+	// equality through the global table
+	{
+		Symbol s1("ok"), s2(string("ok")), s3(cstring("ko"));
+		CHECK(s1 == s2);
+		CHECK(s1 != s3);
+		CHECK_EQUAL(s1.hash(), s2.hash());
+		CHECK(s1.toString() == "ok");
+		CHECK_EQUAL(s1.length(), 2);
+		CHECK(s3 < s1);
+		CHECK_EQUAL(s1.compare(s2), 0);
+		string built = _ << "o" << "k";
+		CHECK(Symbol(built) == s1);
+		CHECK(*SymbolTable::global().lookup(cstring("ok")) == s1);
+		CHECK(SymbolTable::global().lookup(cstring("never-interned")).none());
+	}
+
+	// local table and growth
+	{
+		SymbolTable t(4);
+		Vector<Symbol> syms;
+		for(int i = 0; i < 1000; i++)
+			syms.add(t.intern(_ << "id" << i));
+		CHECK_EQUAL(t.count(), 1000);
+		bool ok = true;
+		for(int i = 0; i < 1000; i++)
+			ok = ok && t.intern(_ << "id" << i) == syms[i];
+		CHECK(ok);
+		CHECK_EQUAL(t.count(), 1000);
+		CHECK(t.intern(cstring("id0")) != Symbol("id0"));
+	}
+
+	// symbols as hash keys
+	{
+		HashMap<Symbol, int> map;
+		map.put(Symbol("a"), 1);
+		map.put(Symbol("b"), 2);
+		CHECK_EQUAL(map.get(Symbol("a"), 0), 1);
+		CHECK_EQUAL(map.get(Symbol(string("b")), 0), 2);
+		CHECK_EQUAL(map.get(Symbol("c"), 0), 0);
+	}
+
+	// concurrent interning
+	{
+		SymbolTable t(8);
+		Interner i1(t), i2(t);
+		sys::Thread *th1 = sys::Thread::make(i1), *th2 = sys::Thread::make(i2);
+		th1->start();
+		th2->start();
+		th1->join();
+		th2->join();
+		delete th1;
+		delete th2;
+		CHECK_EQUAL(t.count(), 501);
+		CHECK(!i1.failed && !i2.failed);
+		CHECK(t.intern(cstring("a-long-shared-symbol-name")).toString() == "a-long-shared-symbol-name");
+		bool ok = true;
+		for(int i = 0; i < 500; i++)
+			ok = ok && i1.syms[i] == i2.syms[i];
+		CHECK(ok);
+	}
+
+TEST_END
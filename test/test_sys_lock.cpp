@@ -0,0 +1,166 @@
+/*
+ *	lock classes test
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#include <elm/data/Vector.h>
+#include <elm/sys/Lock.h>
+#include <elm/test.h>
+
+using namespace elm;
+using namespace elm::sys;
+
+template <class F>
+class Worker: public Runnable {
+public:
+	Worker(F f): _f(f) { }
+	virtual void run(void) { _f(); }
+private:
+	F _f;
+};
+
+template <class F>
+void parallel(int n, F f) {
+	Vector<Worker<F> *> ws;
+	Vector<Thread *> ts;
+	for(int i = 0; i < n; i++) {
+		ws.add(new Worker<F>(f));
+		ts.add(Thread::make(*ws[i]));
+	}
+	for(auto t: ts)
+		t->start();
+	for(int i = 0; i < n; i++) {
+		ts[i]->join();
+		delete ts[i];
+		delete ws[i];
+	}
+}
+
+TEST_BEGIN(sys_lock)
+	const int T = 4, N = 100000;
+
+	// spin lock
+	{
+		SpinLock l;
+		CHECK(l.tryLock());
+		CHECK(!l.tryLock());
+		l.unlock();
+		int c = 0;
+		parallel(T, [&]() {
+			for(int i = 0; i < N; i++) {
+				LockGuard<SpinLock> g(l);
+				c++;
+			}
+		});
+		CHECK_EQUAL(c, T * N);
+	}
+
+	// read-write lock
+	{
+		ReadWriteLock l;
+		CHECK(l.tryLockRead());
+		CHECK(l.tryLockRead());
+		CHECK(!l.tryLockWrite());
+		l.unlockRead();
+		l.unlockRead();
+		CHECK(l.tryLockWrite());
+		CHECK(!l.tryLockRead());
+		l.unlockWrite();
+		int a = 0, b = 0;
+		std::atomic<bool> bad(false);
+		parallel(T, [&]() {
+			for(int i = 0; i < N / 10; i++) {
+				if(i % 4 == 0) {
+					LockGuard<ReadWriteLock> g(l);
+					a++;
+					b++;
+				}
+				else {
+					ReadGuard g(l);
+					if(a != b)
+						bad = true;
+				}
+			}
+		});
+		CHECK(!bad);
+		CHECK_EQUAL(a, T * N / 40);
+	}
+
+	// condition
+	{
+		SpinLock l;
+		Condition c;
+		int turn = 0;
+		const int R = 1000;
+		parallel(2, [&]() {
+			static std::atomic<int> id(0);
+			int me = id++;
+			for(int i = 0; i < R; i++) {
+				LockGuard<SpinLock> g(l);
+				c.wait(l, [&]() { return turn % 2 == me; });
+				turn++;
+				c.notifyAll();
+			}
+		});
+		CHECK_EQUAL(turn, 2 * R);
+	}
+
+	// semaphore
+	{
+		Semaphore s(2);
+		CHECK(s.tryAcquire());
+		CHECK(s.tryAcquire());
+		CHECK(!s.tryAcquire());
+		s.release(2);
+		CHECK_EQUAL(s.count(), 2);
+		Semaphore items(0), mutex(1);
+		int produced = 0, consumed = 0;
+		std::atomic<int> id(0);
+		parallel(2, [&]() {
+			if(id++ == 0)
+				for(int i = 0; i < N; i++) {
+					mutex.acquire();
+					produced++;
+					mutex.release();
+					items.release();
+				}
+			else
+				for(int i = 0; i < N; i++) {
+					items.acquire();
+					mutex.acquire();
+					consumed++;
+					mutex.release();
+				}
+		});
+		CHECK_EQUAL(produced, N);
+		CHECK_EQUAL(consumed, N);
+		CHECK_EQUAL(items.count(), 0);
+	}
+
+	// guard with the old mutex
+	{
+		Mutex *m = Mutex::make();
+		{
+			LockGuard<Mutex> g(*m);
+		}
+		CHECK(m->tryLock());
+		m->unlock();
+		delete m;
+	}
+
+TEST_END
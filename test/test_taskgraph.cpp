@@ -0,0 +1,134 @@
+/*
+ *	TaskGraph test
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#include <elm/sys/TaskGraph.h>
+#include <elm/test.h>
+
+using namespace elm;
+using namespace elm::sys;
+
+TEST_BEGIN(taskgraph)
+
+	// diamond with ordering checks
+	for(int n = 1; n <= 4; n++) {
+		std::atomic<int> step(0);
+		int a = -1, b = -1, c = -1, d = -1;
+		TaskGraph g;
+		TaskGraph::task_t ta = g.add([&]() { a = step++; }),
+			tb = g.add([&]() { b = step++; }),
+			tc = g.add([&]() { c = step++; }),
+			td = g.add([&]() { d = step++; });
+		g.precede(ta, tb);
+		g.precede(ta, tc);
+		g.precede(tb, td);
+		g.precede(tc, td);
+		g.run(n);
+		CHECK_EQUAL(g.count(), 4);
+		CHECK_EQUAL(a, 0);
+		CHECK(b > a && c > a);
+		CHECK(d > b && d > c);
+		CHECK_EQUAL(d, 3);
+	}
+
+	// large graph: layered sums
+	{
+		const int L = 50, W = 20;
+		int v[L][W];
+		TaskGraph g;
+		TaskGraph::task_t ids[L][W];
+		for(int l = 0; l < L; l++)
+			for(int w = 0; w < W; w++) {
+				ids[l][w] = g.add([&v, l, w]() {
+					v[l][w] = l == 0 ? 1 : v[l - 1][w] + v[l - 1][(w + 1) % W];
+					if(l > 0) v[l][w] %= 1000003;
+				});
+				if(l > 0) {
+					g.precede(ids[l - 1][w], ids[l][w]);
+					g.precede(ids[l - 1][(w + 1) % W], ids[l][w]);
+				}
+			}
+		g.run(4);
+		int exp = 1;
+		for(int l = 1; l < L; l++)
+			exp = (exp * 2) % 1000003;
+		bool ok = true;
+		for(int w = 0; w < W; w++)
+			if(v[L - 1][w] != exp)
+				ok = false;
+		CHECK(ok);
+		g.run(2);
+		CHECK_EQUAL(v[L - 1][0], exp);
+	}
+
+	// long chain (no recursion per dependency)
+	{
+		const int N = 200000;
+		int c = 0;
+		bool ok = true;
+		TaskGraph g;
+		for(int i = 0; i < N; i++) {
+			g.add([&c, &ok, i]() { if(c != i) ok = false; c++; });
+			if(i > 0)
+				g.precede(i - 1, i);
+		}
+		g.run(4);
+		CHECK_EQUAL(c, N);
+		CHECK(ok);
+	}
+
+	// graph run from a task: executed by the calling thread
+	{
+		int inner = 0;
+		TaskGraph g;
+		g.add([&inner]() {
+			TaskGraph h;
+			TaskGraph::task_t t1 = h.add([&inner]() { inner = 1; }), t2 = h.add([&inner]() { inner *= 2; });
+			h.precede(t1, t2);
+			h.run();
+		});
+		g.run(4);
+		CHECK_EQUAL(inner, 2);
+	}
+
+	// failure
+	{
+		bool after = false;
+		TaskGraph g;
+		TaskGraph::task_t t1 = g.add([]() { throw MessageException("failed"); }),
+			t2 = g.add([&]() { after = true; });
+		g.precede(t1, t2);
+		CHECK_EXCEPTION(MessageException, g.run());
+		CHECK(!after);
+		TaskGraph h;
+		h.add([]() { throw 0; });
+		CHECK_EXCEPTION(MessageException, h.run(2));
+	}
+
+	// cycle
+	{
+		TaskGraph g;
+		TaskGraph::task_t t1 = g.add([]() { }), t2 = g.add([]() { }), t3 = g.add([]() { });
+		g.precede(t1, t2);
+		g.precede(t2, t3);
+		g.precede(t3, t2);
+		CHECK_EXCEPTION(MessageException, g.run());
+	}
+
+TEST_END
@@ -61,4 +61,45 @@ TEST_BEGIN(utf8)
 		CHECK(!i);
 	}
 
+	// validation
+	{
+		CHECK(validate("", 0));
+		CHECK(validate(string("plain ASCII text long enough for the vector path")));
+		CHECK(validate(string("caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 and some more ASCII after")));
+		CHECK(!validate(string("long ASCII prefix before a bad byte \xff")));
+		CHECK(!validate(string("\xc0\xaf")));				// overlong
+		CHECK(!validate(string("\xe0\x80\xaf")));			// overlong
+		CHECK(!validate(string("\xed\xa0\x80")));			// surrogate
+		CHECK(!validate(string("\xf4\x90\x80\x80")));		// > 0x10FFFF
+		CHECK(!validate(string("truncated \xe2\x82")));
+		CHECK(!validate(string("\x80")));
+	}
+
+	// counting
+	{
+		string s = "caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 and some more ASCII after the emoji";
+		int n = 0;
+		for(Iter i(s); i(); i++)
+			n++;
+		CHECK_EQUAL(count(s), t::size(n));
+	}
+
+	// UTF-16 round trip
+	{
+		string s = "ASCII prefix long enough: caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80!";
+		t::uint16 w[128];
+		t::size n = toUtf16(s.chars(), s.length(), w);
+		CHECK_EQUAL(n, t::size(36));
+		CHECK_EQUAL(w[29], t::uint16(0xe9));
+		CHECK_EQUAL(w[31], t::uint16(0x20ac));
+		CHECK_EQUAL(w[33], t::uint16(0xd83d));
+		CHECK_EQUAL(w[34], t::uint16(0xde00));
+		char b[3 * 128];
+		t::size m = fromUtf16(w, n, b);
+		CHECK_EQUAL(string(b, m), s);
+		CHECK_EQUAL(toUtf16("\xc3", 1, w), bad);
+		t::uint16 lone[] = { 'a', 0xdc00 };
+		CHECK_EQUAL(fromUtf16(lone, 2, b), bad);
+	}
+
 TEST_END